@@ -31,6 +31,13 @@
 
 #include <immintrin.h>
 
+// Lets the permutation be compiled without -mavx2 and selected at runtime, see keccak_dispatch_impl.hpp.
+#if defined(__GNUC__) || defined(__clang__)
+#define CRYPTO3_KECCAK_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define CRYPTO3_KECCAK_AVX2_TARGET
+#endif
+
 namespace nil {
     namespace crypto3 {
         namespace hashes {
@@ -125,7 +132,7 @@ namespace nil {
                          {word_bits - 44, word_bits - 43, word_bits - 21, word_bits - 14}}};
 #pragma GCC diagnostic pop
 
-                    static inline void permute(state_type &A) {
+                    CRYPTO3_KECCAK_AVX2_TARGET static inline void permute(state_type &A) {
 
                         register __m256i A0 asm("ymm0") = _mm256_set_epi64x(A[0], A[0], A[0], A[0]);
                         register __m256i A1 asm("ymm1") = _mm256_set_epi64x(A[4], A[3], A[2], A[1]);
@@ -303,7 +310,8 @@ namespace nil {
                             : "cc", "memory",                              // it's A0, A1, A2, A3, A4, A5, A6
                               "ymm7", "ymm8", "ymm9", "ymm10", "ymm11",    // tmp variables
                               "ymm12", "ymm13", "ymm14", "ymm15",          // C, Czero, D, Dzero
-                              "rbx"                                        // Circle
+                              "rbx",                                       // Circle
+                              "r8", "r9", "r10"                            // rho_l, rho_r, c pointers
                         );
 
                         A[0] = A0[0];
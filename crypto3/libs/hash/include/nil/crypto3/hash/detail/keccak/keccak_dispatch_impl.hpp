@@ -0,0 +1,133 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef CRYPTO3_KECCAK_DISPATCH_IMPL_HPP
+#define CRYPTO3_KECCAK_DISPATCH_IMPL_HPP
+
+#include <algorithm>
+#include <chrono>
+
+#include <boost/predef/architecture.h>
+
+#include <nil/crypto3/hash/detail/keccak/keccak_policy.hpp>
+#include <nil/crypto3/hash/detail/keccak/keccak_impl.hpp>
+
+// Define CRYPTO3_KECCAK_PORTABLE to always use keccak_1600_impl.
+#if !defined(CRYPTO3_KECCAK_PORTABLE) && BOOST_ARCH_X86_64 && (defined(__GNUC__) || defined(__clang__))
+#define CRYPTO3_KECCAK_HAS_AVX2_BACKEND 1
+#include <nil/crypto3/hash/detail/keccak/keccak_avx2_impl.hpp>
+#endif
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief Keccak-f[1600] permutation which picks the fastest backend, once per process.
+                 * The candidates are the portable keccak_1600_impl and, if the CPU supports it, the AVX2 one.
+                 * AVX2 must reproduce the portable result, then the faster one on a short run wins.
+                 * Depending on the compiler and its flags the portable one is sometimes as fast as AVX2.
+                 */
+                template<typename PolicyType>
+                struct keccak_1600_dispatch_impl {
+                    typedef PolicyType policy_type;
+                    typedef keccak_1600_impl<policy_type> portable_impl_type;
+
+                    constexpr static const std::size_t word_bits = policy_type::word_bits;
+                    typedef typename policy_type::word_type word_type;
+
+                    typedef typename policy_type::state_type state_type;
+
+                    typedef typename portable_impl_type::round_constants_type round_constants_type;
+                    constexpr static const round_constants_type round_constants = portable_impl_type::round_constants;
+
+                    enum class backend { portable, avx2 };
+
+                    static inline void permute(state_type &A) {
+#if CRYPTO3_KECCAK_HAS_AVX2_BACKEND
+                        if (selected_backend() == backend::avx2) {
+                            keccak_1600_avx2_impl<policy_type>::permute(A);
+                            return;
+                        }
+#endif
+                        portable_impl_type::permute(A);
+                    }
+
+                    static backend selected_backend() {
+                        static const backend selected = select_backend();
+                        return selected;
+                    }
+
+                    static const char *selected_backend_name() {
+                        return selected_backend() == backend::avx2 ? "avx2" : "portable";
+                    }
+
+                private:
+                    static backend select_backend() {
+#if CRYPTO3_KECCAK_HAS_AVX2_BACKEND
+                        if (!__builtin_cpu_supports("avx2")) {
+                            return backend::portable;
+                        }
+
+                        state_type expected = {}, state = {};
+                        for (std::size_t i = 0; i < 2; ++i) {
+                            portable_impl_type::permute(expected);
+                            keccak_1600_avx2_impl<policy_type>::permute(state);
+                        }
+                        if (state != expected) {
+                            return backend::portable;
+                        }
+
+                        auto portable_time = measure([](state_type &A) { portable_impl_type::permute(A); });
+                        auto avx2_time = measure([](state_type &A) { keccak_1600_avx2_impl<policy_type>::permute(A); });
+                        return avx2_time < portable_time ? backend::avx2 : backend::portable;
+#else
+                        return backend::portable;
+#endif
+                    }
+
+                    template<typename Permutation>
+                    static std::chrono::steady_clock::duration measure(Permutation permutation) {
+                        constexpr std::size_t runs = 3;
+                        constexpr std::size_t permutations_per_run = 1024;
+
+                        state_type state = {};
+                        auto best = std::chrono::steady_clock::duration::max();
+                        for (std::size_t run = 0; run < runs; ++run) {
+                            auto start = std::chrono::steady_clock::now();
+                            for (std::size_t i = 0; i < permutations_per_run; ++i) {
+                                permutation(state);
+                            }
+                            best = std::min(best, std::chrono::steady_clock::now() - start);
+                        }
+                        return best;
+                    }
+                };
+
+                template<typename PolicyType>
+                constexpr typename keccak_1600_dispatch_impl<PolicyType>::round_constants_type const
+                    keccak_1600_dispatch_impl<PolicyType>::round_constants;
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_KECCAK_DISPATCH_IMPL_HPP
@@ -29,20 +29,7 @@
 
 #include <nil/crypto3/hash/detail/keccak/keccak_policy.hpp>
 #include <nil/crypto3/hash/detail/keccak/keccak_impl.hpp>
-
-//#if BOOST_ARCH_X86_64
-//#if defined(CRYPTO3_HAS_AVX512)
-//#include <nil/crypto3/hash/detail/keccak/keccak_avx512_impl.hpp>
-//#else
-//#if defined(CRYPTO3_HAS_AVX2)
-//#include <nil/crypto3/hash/detail/keccak/keccak_avx2_impl.hpp>
-//#else
-//#include <nil/crypto3/hash/detail/keccak/keccak_x86_64_impl.hpp>
-//#endif
-//#endif
-//#elif BOOST_ARCH_ARM
-//#include <nil/crypto3/hash/detail/keccak/keccak_armv8_impl.hpp>
-//#endif
+#include <nil/crypto3/hash/detail/keccak/keccak_dispatch_impl.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -59,25 +46,8 @@ namespace nil {
 
                     typedef typename policy_type::state_type state_type;
 
-//                    typedef typename std::conditional<word_bits == 64,
-//#if BOOST_ARCH_X86_64
-//#if defined(CRYPTO3_HAS_AVX512)
-//                                                      keccak_1600_avx512_impl<policy_type>,
-//#else
-//#if defined(CRYPTO3_HAS_AVX2)
-//                                                      keccak_1600_avx2_impl<policy_type>,
-//#else
-//                                                      keccak_1600_x86_64_impl<policy_type>,
-//#endif
-//#endif
-//#elif BOOST_ARCH_ARM && BOOST_ARCH_ARM >= BOOST_VERSION_NUMBER(8, 0, 0)
-//                                                      keccak_1600_armv8_impl<policy_type>,
-//#else
-//                                                      keccak_1600_impl<policy_type>,
-//#endif
-//                                                      keccak_1600_impl<policy_type>>::type impl_type;
-
-                    typedef keccak_1600_impl<policy_type> impl_type;
+                    // Picks the fastest permutation supported by the CPU at runtime.
+                    typedef keccak_1600_dispatch_impl<policy_type> impl_type;
 
                     typedef keccak_1600_impl<policy_type> const_impl_type;
 
@@ -0,0 +1,304 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef CRYPTO3_KECCAK_MULTI_BUFFER_IMPL_HPP
+#define CRYPTO3_KECCAK_MULTI_BUFFER_IMPL_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <boost/predef/architecture.h>
+
+#include <nil/crypto3/hash/detail/keccak/keccak_policy.hpp>
+#include <nil/crypto3/hash/detail/keccak/keccak_impl.hpp>
+#include <nil/crypto3/hash/detail/keccak/keccak_dispatch_impl.hpp>
+
+#if !defined(CRYPTO3_KECCAK_PORTABLE) && BOOST_ARCH_X86_64 && defined(__GNUC__)
+#define CRYPTO3_KECCAK_HAS_MULTI_BUFFER_BACKENDS 1
+#define CRYPTO3_KECCAK_X4_TARGET __attribute__((target("avx2")))
+#define CRYPTO3_KECCAK_X8_TARGET __attribute__((target("avx512f")))
+#endif
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+                /*!
+                 * @brief Keccak-f[1600] of several independent states in lock-step. The states are lane-interleaved:
+                 * word i of state k is states[i][k], so word i of all the states is loaded as a single vector.
+                 * 8 states are permuted together with AVX-512, 4 with AVX2, otherwise the states are permuted one
+                 * by one.
+                 */
+                template<typename PolicyType>
+                struct keccak_1600_multi_buffer_impl {
+                    typedef PolicyType policy_type;
+
+                    typedef typename policy_type::word_type word_type;
+                    typedef typename policy_type::state_type state_type;
+                    constexpr static const std::size_t state_words = policy_type::state_words;
+
+                    constexpr static const std::size_t max_lanes = 8;
+
+                    template<std::size_t Lanes>
+                    using interleaved_state_type = std::array<std::array<word_type, Lanes>, state_words>;
+
+                    // Number of states permuted together on this CPU.
+                    static std::size_t lanes() {
+                        static const std::size_t selected = select_lanes();
+                        return selected;
+                    }
+
+                    template<std::size_t Lanes>
+                    static void permute(interleaved_state_type<Lanes> &states) {
+#if CRYPTO3_KECCAK_HAS_MULTI_BUFFER_BACKENDS
+                        if constexpr (Lanes == 8) {
+                            if (lanes() == 8) {
+                                permute_x8(states);
+                                return;
+                            }
+                        } else if constexpr (Lanes == 4) {
+                            if (lanes() >= 4) {
+                                permute_x4(states);
+                                return;
+                            }
+                        }
+#endif
+                        for (std::size_t k = 0; k < Lanes; ++k) {
+                            state_type state;
+                            for (std::size_t i = 0; i < state_words; ++i) {
+                                state[i] = states[i][k];
+                            }
+                            keccak_1600_dispatch_impl<policy_type>::permute(state);
+                            for (std::size_t i = 0; i < state_words; ++i) {
+                                states[i][k] = state[i];
+                            }
+                        }
+                    }
+
+                private:
+                    static std::size_t select_lanes() {
+#if CRYPTO3_KECCAK_HAS_MULTI_BUFFER_BACKENDS
+                        if (__builtin_cpu_supports("avx512f")) {
+                            return 8;
+                        }
+                        if (__builtin_cpu_supports("avx2")) {
+                            return 4;
+                        }
+#endif
+                        return 1;
+                    }
+
+#if CRYPTO3_KECCAK_HAS_MULTI_BUFFER_BACKENDS
+                    typedef word_type vector_x4_type __attribute__((vector_size(32)));
+                    typedef word_type vector_x8_type __attribute__((vector_size(64)));
+
+// A macro rather than a function: a function taking or returning the vectors by value is compiled for the
+// default target, which changes its ABI and makes GCC warn (-Wpsabi) in every translation unit.
+#define CRYPTO3_KECCAK_VECTOR_ROTL(x, N) (((x) << (N)) | ((x) >> (64 - (N))))
+
+                    // The round function of keccak_1600_impl, with every word replaced by a vector of words.
+                    template<typename VectorType>
+                    __attribute__((always_inline)) static inline void permute_vectors(VectorType *A) {
+                        for (word_type c : keccak_1600_impl<policy_type>::round_constants) {
+                            const VectorType C0 = A[0] ^ A[5] ^ A[10] ^ A[15] ^ A[20];
+                            const VectorType C1 = A[1] ^ A[6] ^ A[11] ^ A[16] ^ A[21];
+                            const VectorType C2 = A[2] ^ A[7] ^ A[12] ^ A[17] ^ A[22];
+                            const VectorType C3 = A[3] ^ A[8] ^ A[13] ^ A[18] ^ A[23];
+                            const VectorType C4 = A[4] ^ A[9] ^ A[14] ^ A[19] ^ A[24];
+
+                            const VectorType D0 = CRYPTO3_KECCAK_VECTOR_ROTL(C0, 1) ^ C3;
+                            const VectorType D1 = CRYPTO3_KECCAK_VECTOR_ROTL(C1, 1) ^ C4;
+                            const VectorType D2 = CRYPTO3_KECCAK_VECTOR_ROTL(C2, 1) ^ C0;
+                            const VectorType D3 = CRYPTO3_KECCAK_VECTOR_ROTL(C3, 1) ^ C1;
+                            const VectorType D4 = CRYPTO3_KECCAK_VECTOR_ROTL(C4, 1) ^ C2;
+
+                            const VectorType B00 = A[0] ^ D1;
+                            const VectorType B10 = CRYPTO3_KECCAK_VECTOR_ROTL(A[1] ^ D2, 1);
+                            const VectorType B20 = CRYPTO3_KECCAK_VECTOR_ROTL(A[2] ^ D3, 62);
+                            const VectorType B05 = CRYPTO3_KECCAK_VECTOR_ROTL(A[3] ^ D4, 28);
+                            const VectorType B15 = CRYPTO3_KECCAK_VECTOR_ROTL(A[4] ^ D0, 27);
+                            const VectorType B16 = CRYPTO3_KECCAK_VECTOR_ROTL(A[5] ^ D1, 36);
+                            const VectorType B01 = CRYPTO3_KECCAK_VECTOR_ROTL(A[6] ^ D2, 44);
+                            const VectorType B11 = CRYPTO3_KECCAK_VECTOR_ROTL(A[7] ^ D3, 6);
+                            const VectorType B21 = CRYPTO3_KECCAK_VECTOR_ROTL(A[8] ^ D4, 55);
+                            const VectorType B06 = CRYPTO3_KECCAK_VECTOR_ROTL(A[9] ^ D0, 20);
+                            const VectorType B07 = CRYPTO3_KECCAK_VECTOR_ROTL(A[10] ^ D1, 3);
+                            const VectorType B17 = CRYPTO3_KECCAK_VECTOR_ROTL(A[11] ^ D2, 10);
+                            const VectorType B02 = CRYPTO3_KECCAK_VECTOR_ROTL(A[12] ^ D3, 43);
+                            const VectorType B12 = CRYPTO3_KECCAK_VECTOR_ROTL(A[13] ^ D4, 25);
+                            const VectorType B22 = CRYPTO3_KECCAK_VECTOR_ROTL(A[14] ^ D0, 39);
+                            const VectorType B23 = CRYPTO3_KECCAK_VECTOR_ROTL(A[15] ^ D1, 41);
+                            const VectorType B08 = CRYPTO3_KECCAK_VECTOR_ROTL(A[16] ^ D2, 45);
+                            const VectorType B18 = CRYPTO3_KECCAK_VECTOR_ROTL(A[17] ^ D3, 15);
+                            const VectorType B03 = CRYPTO3_KECCAK_VECTOR_ROTL(A[18] ^ D4, 21);
+                            const VectorType B13 = CRYPTO3_KECCAK_VECTOR_ROTL(A[19] ^ D0, 8);
+                            const VectorType B14 = CRYPTO3_KECCAK_VECTOR_ROTL(A[20] ^ D1, 18);
+                            const VectorType B24 = CRYPTO3_KECCAK_VECTOR_ROTL(A[21] ^ D2, 2);
+                            const VectorType B09 = CRYPTO3_KECCAK_VECTOR_ROTL(A[22] ^ D3, 61);
+                            const VectorType B19 = CRYPTO3_KECCAK_VECTOR_ROTL(A[23] ^ D4, 56);
+                            const VectorType B04 = CRYPTO3_KECCAK_VECTOR_ROTL(A[24] ^ D0, 14);
+
+                            A[0] = B00 ^ (~B01 & B02);
+                            A[1] = B01 ^ (~B02 & B03);
+                            A[2] = B02 ^ (~B03 & B04);
+                            A[3] = B03 ^ (~B04 & B00);
+                            A[4] = B04 ^ (~B00 & B01);
+                            A[5] = B05 ^ (~B06 & B07);
+                            A[6] = B06 ^ (~B07 & B08);
+                            A[7] = B07 ^ (~B08 & B09);
+                            A[8] = B08 ^ (~B09 & B05);
+                            A[9] = B09 ^ (~B05 & B06);
+                            A[10] = B10 ^ (~B11 & B12);
+                            A[11] = B11 ^ (~B12 & B13);
+                            A[12] = B12 ^ (~B13 & B14);
+                            A[13] = B13 ^ (~B14 & B10);
+                            A[14] = B14 ^ (~B10 & B11);
+                            A[15] = B15 ^ (~B16 & B17);
+                            A[16] = B16 ^ (~B17 & B18);
+                            A[17] = B17 ^ (~B18 & B19);
+                            A[18] = B18 ^ (~B19 & B15);
+                            A[19] = B19 ^ (~B15 & B16);
+                            A[20] = B20 ^ (~B21 & B22);
+                            A[21] = B21 ^ (~B22 & B23);
+                            A[22] = B22 ^ (~B23 & B24);
+                            A[23] = B23 ^ (~B24 & B20);
+                            A[24] = B24 ^ (~B20 & B21);
+
+                            A[0] ^= c;
+                        }
+                    }
+
+                    CRYPTO3_KECCAK_X4_TARGET static void permute_x4(interleaved_state_type<4> &states) {
+                        vector_x4_type A[state_words];
+                        std::memcpy(A, states.data(), sizeof(A));
+                        permute_vectors(A);
+                        std::memcpy(states.data(), A, sizeof(A));
+                    }
+
+                    CRYPTO3_KECCAK_X8_TARGET static void permute_x8(interleaved_state_type<8> &states) {
+                        vector_x8_type A[state_words];
+                        std::memcpy(A, states.data(), sizeof(A));
+                        permute_vectors(A);
+                        std::memcpy(states.data(), A, sizeof(A));
+                    }
+
+#undef CRYPTO3_KECCAK_VECTOR_ROTL
+#endif
+                };
+
+                /*!
+                 * @brief Keccak hashes of many messages of the same length, computed in groups of
+                 * keccak_1600_multi_buffer_impl::lanes() messages. Gives the same digests as keccak_1600<DigestBits>.
+                 */
+                template<std::size_t DigestBits>
+                struct keccak_1600_multi_buffer_hasher {
+                    typedef keccak_1600_policy<DigestBits> policy_type;
+                    typedef keccak_1600_multi_buffer_impl<policy_type> multi_buffer_impl_type;
+                    typedef typename policy_type::word_type word_type;
+                    typedef typename policy_type::digest_type digest_type;
+
+                    constexpr static const std::size_t word_bytes = sizeof(word_type);
+                    constexpr static const std::size_t block_bytes = policy_type::block_bits / 8;
+                    constexpr static const std::size_t block_words = policy_type::block_words;
+                    constexpr static const std::size_t digest_bytes = DigestBits / 8;
+
+                    /*!
+                     * Writes the digest of the message of 'message_size' bytes at messages[i] to digests[i],
+                     * for every i < count.
+                     */
+                    static void hash(const std::uint8_t *const *messages, std::size_t message_size, std::size_t count,
+                                     digest_type *digests) {
+                        std::size_t lanes = multi_buffer_impl_type::lanes();
+                        std::size_t i = 0;
+                        if (lanes == 8) {
+                            for (; i + 4 < count; i += 8) {
+                                hash_group<8>(messages + i, message_size, std::min<std::size_t>(8, count - i),
+                                              digests + i);
+                            }
+                        }
+                        if (lanes >= 4) {
+                            for (; i + 1 < count; i += 4) {
+                                hash_group<4>(messages + i, message_size, std::min<std::size_t>(4, count - i),
+                                              digests + i);
+                            }
+                        }
+                        for (; i < count; ++i) {
+                            hash_group<1>(messages + i, message_size, 1, digests + i);
+                        }
+                    }
+
+                private:
+                    static word_type load_word(const std::uint8_t *bytes) {
+                        word_type word = 0;
+                        for (std::size_t b = 0; b < word_bytes; ++b) {
+                            word |= word_type(bytes[b]) << (8 * b);
+                        }
+                        return word;
+                    }
+
+                    // Hashes 'used' <= Lanes messages, the rest of the lanes repeat the first message.
+                    template<std::size_t Lanes>
+                    static void hash_group(const std::uint8_t *const *messages, std::size_t message_size,
+                                           std::size_t used, digest_type *digests) {
+                        typename multi_buffer_impl_type::template interleaved_state_type<Lanes> states = {};
+
+                        std::size_t offset = 0;
+                        for (; offset + block_bytes <= message_size; offset += block_bytes) {
+                            for (std::size_t k = 0; k < Lanes; ++k) {
+                                const std::uint8_t *block = messages[k < used ? k : 0] + offset;
+                                for (std::size_t w = 0; w < block_words; ++w) {
+                                    states[w][k] ^= load_word(block + w * word_bytes);
+                                }
+                            }
+                            multi_buffer_impl_type::permute(states);
+                        }
+
+                        // pad10*1
+                        const std::size_t tail_size = message_size - offset;
+                        for (std::size_t k = 0; k < Lanes; ++k) {
+                            std::array<std::uint8_t, block_bytes> block = {};
+                            std::copy(messages[k < used ? k : 0] + offset, messages[k < used ? k : 0] + message_size,
+                                      block.begin());
+                            block[tail_size] ^= 0x01;
+                            block[block_bytes - 1] ^= 0x80;
+                            for (std::size_t w = 0; w < block_words; ++w) {
+                                states[w][k] ^= load_word(block.data() + w * word_bytes);
+                            }
+                        }
+                        multi_buffer_impl_type::permute(states);
+
+                        for (std::size_t k = 0; k < used; ++k) {
+                            for (std::size_t b = 0; b < digest_bytes; ++b) {
+                                digests[k][b] =
+                                    static_cast<std::uint8_t>(states[b / word_bytes][k] >> (8 * (b % word_bytes)));
+                            }
+                        }
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_KECCAK_MULTI_BUFFER_IMPL_HPP
@@ -26,7 +26,7 @@
 #define CRYPTO3_HASH_POSEIDON_FUNCS_HPP
 
 #include <nil/crypto3/hash/detail/poseidon/poseidon_policy.hpp>
-#include <nil/crypto3/hash/detail/poseidon/poseidon_permutation.hpp>
+#include <nil/crypto3/hash/detail/poseidon/poseidon_optimized_permutation.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -35,7 +35,7 @@ namespace nil {
                 template<typename Policy>
                 struct poseidon_functions {
                 private:
-                    typedef poseidon_permutation<Policy> permutation_type;
+                    typedef poseidon_optimized_permutation<Policy> permutation_type;
 
                 public:
                     constexpr static const std::size_t block_words = Policy::block_words;
@@ -0,0 +1,261 @@
+//---------------------------------------------------------------------------//
+// Distributed under the Boost Software License, Version 1.0
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_HASH_POSEIDON_OPTIMIZED_PERMUTATION_HPP
+#define CRYPTO3_HASH_POSEIDON_OPTIMIZED_PERMUTATION_HPP
+
+#include <array>
+#include <utility>
+#include <type_traits>
+
+#include <nil/crypto3/hash/detail/poseidon/poseidon_policy.hpp>
+#include <nil/crypto3/hash/detail/poseidon/poseidon_constants.hpp>
+#include <nil/crypto3/hash/detail/poseidon/poseidon_permutation.hpp>
+
+#include <boost/assert.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace hashes {
+            namespace detail {
+
+                /*!
+                 * @brief Constants of the original Poseidon, rearranged for poseidon_optimized_permutation.
+                 *
+                 * A partial round adds the round constants, applies the S-box to A[0] only and multiplies by the
+                 * MDS matrix M. The constants added to A[1], ..., A[t - 1] pass the S-box unchanged, so they are
+                 * multiplied by M and added to the constants of the next round, leaving a single constant per
+                 * partial round.
+                 *
+                 * M of a partial round is split into M' * M'', where M' = diag(1, M^) does not touch A[0] and M'' is
+                 * sparse. M' commutes with the S-box and the constant of the partial round, so it is moved into the
+                 * matrix of the round before, which is split again. Going from the last partial round to the first,
+                 * every partial round is left with a sparse matrix, and the last full round before them gets a
+                 * dense one.
+                 */
+                template<typename PolicyType>
+                class poseidon_optimized_constants {
+                public:
+                    typedef PolicyType policy_type;
+                    typedef typename policy_type::word_type element_type;
+
+                    constexpr static const std::size_t state_words = policy_type::state_words;
+                    typedef typename policy_type::state_type state_type;
+
+                    constexpr static const std::size_t full_rounds = policy_type::full_rounds;
+                    constexpr static const std::size_t half_full_rounds = policy_type::half_full_rounds;
+                    constexpr static const std::size_t part_rounds = policy_type::part_rounds;
+
+                    typedef poseidon_constants<policy_type> poseidon_constants_type;
+                    typedef typename poseidon_constants_type::mds_matrix_type mds_matrix_type;
+
+                    typedef std::array<element_type, state_words - 1> reduced_vector_type;
+                    typedef std::array<reduced_vector_type, state_words - 1> reduced_matrix_type;
+
+                    /// M'' of a partial round, the identity matrix with a full first row and first column.
+                    struct sparse_matrix_type {
+                        // M''[i][0] for all i.
+                        state_type first_column;
+                        // M''[0][j] for j >= 1.
+                        reduced_vector_type first_row;
+                    };
+
+                    explicit poseidon_optimized_constants(const poseidon_constants_type &constants)
+                        : mds_matrix(constants.mds_matrix) {
+                        std::array<state_type, full_rounds + part_rounds> round_constants;
+                        for (std::size_t r = 0; r < full_rounds + part_rounds; r++) {
+                            for (std::size_t i = 0; i < state_words; i++) {
+                                round_constants[r][i] = constants.get_round_constant(r, i);
+                            }
+                        }
+
+                        for (std::size_t r = half_full_rounds; r < half_full_rounds + part_rounds; r++) {
+                            state_type carried = round_constants[r];
+                            carried[0] = element_type(0u);
+                            product_with_matrix(carried, mds_matrix);
+                            for (std::size_t i = 0; i < state_words; i++) {
+                                round_constants[r + 1][i] += carried[i];
+                            }
+                            part_round_constants[r - half_full_rounds] = round_constants[r][0];
+                        }
+                        for (std::size_t r = 0; r < half_full_rounds; r++) {
+                            full_round_constants[r] = round_constants[r];
+                        }
+                        for (std::size_t r = half_full_rounds; r < full_rounds; r++) {
+                            full_round_constants[r] = round_constants[r + part_rounds];
+                        }
+
+                        mds_matrix_type matrix = mds_matrix;
+                        for (std::size_t r = part_rounds; r-- > 0;) {
+                            reduced_matrix_type matrix_hat;
+                            reduced_vector_type column;
+                            for (std::size_t i = 1; i < state_words; i++) {
+                                for (std::size_t j = 1; j < state_words; j++) {
+                                    matrix_hat[i - 1][j - 1] = matrix[i][j];
+                                }
+                                column[i - 1] = matrix[i][0];
+                                sparse_matrices[r].first_row[i - 1] = matrix[0][i];
+                            }
+                            // M' * M'' has M^ * w in the first column below the diagonal, so w = M^{-1} * column.
+                            reduced_vector_type w = solve(matrix_hat, column);
+                            sparse_matrices[r].first_column[0] = matrix[0][0];
+                            for (std::size_t i = 1; i < state_words; i++) {
+                                sparse_matrices[r].first_column[i] = w[i - 1];
+                            }
+
+                            // The round before multiplies by M * M'.
+                            for (std::size_t i = 0; i < state_words; i++) {
+                                matrix[i][0] = mds_matrix[i][0];
+                                for (std::size_t j = 1; j < state_words; j++) {
+                                    matrix[i][j] = element_type(0u);
+                                    for (std::size_t k = 1; k < state_words; k++) {
+                                        matrix[i][j] += mds_matrix[i][k] * matrix_hat[k - 1][j - 1];
+                                    }
+                                }
+                            }
+                        }
+                        pre_partial_mds_matrix = matrix;
+                    }
+
+                    /// A becomes A * matrix, with A as a row vector like in poseidon_constants.
+                    static inline void product_with_matrix(state_type &A, const mds_matrix_type &matrix) {
+                        state_type result;
+                        for (std::size_t j = 0; j < state_words; j++) {
+                            result[j] = A[0] * matrix[0][j];
+                            for (std::size_t i = 1; i < state_words; i++) {
+                                result[j] += A[i] * matrix[i][j];
+                            }
+                        }
+                        A = result;
+                    }
+
+                    static inline void product_with_sparse_matrix(state_type &A, const sparse_matrix_type &matrix) {
+                        const element_type A0 = A[0];
+                        A[0] *= matrix.first_column[0];
+                        for (std::size_t i = 1; i < state_words; i++) {
+                            A[0] += A[i] * matrix.first_column[i];
+                            A[i] += A0 * matrix.first_row[i - 1];
+                        }
+                    }
+
+                    // Full rounds only, the second half follows the first one.
+                    std::array<state_type, full_rounds> full_round_constants;
+                    // Constant added to A[0] in each partial round.
+                    std::array<element_type, part_rounds> part_round_constants;
+
+                    mds_matrix_type mds_matrix;
+                    // Matrix of the last full round before the partial rounds.
+                    mds_matrix_type pre_partial_mds_matrix;
+                    std::array<sparse_matrix_type, part_rounds> sparse_matrices;
+
+                private:
+                    // Gaussian elimination over the field. The submatrices of an MDS matrix are not singular.
+                    static reduced_vector_type solve(reduced_matrix_type a, reduced_vector_type b) {
+                        constexpr std::size_t n = state_words - 1;
+                        for (std::size_t col = 0; col < n; col++) {
+                            std::size_t pivot = col;
+                            while (pivot < n && a[pivot][col].is_zero()) {
+                                pivot++;
+                            }
+                            BOOST_ASSERT_MSG(pivot < n, "Poseidon MDS submatrix is singular.");
+                            std::swap(a[col], a[pivot]);
+                            std::swap(b[col], b[pivot]);
+
+                            const element_type inv = a[col][col].inversed();
+                            for (std::size_t j = col; j < n; j++) {
+                                a[col][j] *= inv;
+                            }
+                            b[col] *= inv;
+                            for (std::size_t row = 0; row < n; row++) {
+                                if (row == col || a[row][col].is_zero()) {
+                                    continue;
+                                }
+                                const element_type factor = a[row][col];
+                                for (std::size_t j = col; j < n; j++) {
+                                    a[row][j] -= factor * a[col][j];
+                                }
+                                b[row] -= factor * b[col];
+                            }
+                        }
+                        return b;
+                    }
+                };
+
+                /*!
+                 * @brief Poseidon permutation giving the same results as poseidon_permutation, with sparse matrices
+                 * in the partial rounds, see poseidon_optimized_constants.
+                 */
+                template<typename poseidon_policy_type, typename Enable = void>
+                struct poseidon_optimized_permutation;
+
+                /// Mina version has no partial rounds, so it is already as fast as it gets.
+                template<typename poseidon_policy_type>
+                struct poseidon_optimized_permutation<poseidon_policy_type,
+                                                      std::enable_if_t<poseidon_policy_type::mina_version>>
+                    : poseidon_permutation<poseidon_policy_type> {
+                    static_assert(poseidon_policy_type::part_rounds == 0, "Mina Poseidon has no partial rounds.");
+                };
+
+                template<typename poseidon_policy_type>
+                struct poseidon_optimized_permutation<poseidon_policy_type,
+                                                      std::enable_if_t<!poseidon_policy_type::mina_version>> {
+                    typedef poseidon_policy_type policy_type;
+                    typedef poseidon_optimized_constants<policy_type> optimized_constants_type;
+
+                    typedef typename policy_type::word_type element_type;
+
+                    constexpr static const std::size_t state_words = policy_type::state_words;
+                    typedef typename policy_type::state_type state_type;
+
+                    constexpr static const std::size_t full_rounds = policy_type::full_rounds;
+                    constexpr static const std::size_t half_full_rounds = policy_type::half_full_rounds;
+                    constexpr static const std::size_t part_rounds = policy_type::part_rounds;
+                    constexpr static const std::size_t sbox_power = policy_type::sbox_power;
+
+                    static inline void permute(state_type &A) {
+                        const optimized_constants_type &constants = get_constants();
+
+                        // first half of full rounds
+                        for (std::size_t r = 0; r < half_full_rounds; r++) {
+                            full_round(A, constants.full_round_constants[r]);
+                            optimized_constants_type::product_with_matrix(
+                                A, r + 1 == half_full_rounds ? constants.pre_partial_mds_matrix : constants.mds_matrix);
+                        }
+
+                        // partial rounds
+                        for (std::size_t r = 0; r < part_rounds; r++) {
+                            A[0] += constants.part_round_constants[r];
+                            A[0] = A[0].pow(sbox_power);
+                            optimized_constants_type::product_with_sparse_matrix(A, constants.sparse_matrices[r]);
+                        }
+
+                        // second half of full rounds
+                        for (std::size_t r = half_full_rounds; r < full_rounds; r++) {
+                            full_round(A, constants.full_round_constants[r]);
+                            optimized_constants_type::product_with_matrix(A, constants.mds_matrix);
+                        }
+                    }
+
+                private:
+                    static inline void full_round(state_type &A, const state_type &round_constants) {
+                        for (std::size_t i = 0; i < state_words; i++) {
+                            A[i] += round_constants[i];
+                            A[i] = A[i].pow(sbox_power);
+                        }
+                    }
+
+                    static const optimized_constants_type &get_constants() {
+                        static const optimized_constants_type constants {
+                            typename optimized_constants_type::poseidon_constants_type()};
+                        return constants;
+                    }
+                };
+            }    // namespace detail
+        }        // namespace hashes
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_HASH_POSEIDON_OPTIMIZED_PERMUTATION_HPP
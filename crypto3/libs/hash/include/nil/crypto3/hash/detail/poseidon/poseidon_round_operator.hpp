@@ -20,8 +20,7 @@ namespace nil {
         namespace hashes {
             namespace detail {
 
-                // TODO(martun): Poseidon paper describes an optimized round, which can work faster when
-                // the Rate is high. Consider implementing it later.
+                // Straightforward rounds, see poseidon_optimized_permutation for the faster equivalent.
                 template<typename poseidon_policy_type, typename Enable=void>
                 class poseidon_round_operator;
 
@@ -71,7 +70,7 @@ namespace nil {
                 private:
                     // Contains all the constants: mds matrix and round constants.
                     // Default constructor selects the right ones.
-                    static const poseidon_constants<poseidon_policy_type> get_constants() {
+                    static const poseidon_constants<poseidon_policy_type> &get_constants() {
                         static const poseidon_constants<poseidon_policy_type> constants;
                         return constants;
                     }
@@ -126,7 +125,7 @@ namespace nil {
                 private:
                     // Contains all the constants: mds matrix and round constants.
                     // Default constructor selects the right ones.
-                    static const poseidon_constants<poseidon_policy_type> get_constants() {
+                    static const poseidon_constants<poseidon_policy_type> &get_constants() {
                         static const poseidon_constants<poseidon_policy_type> constants;
                         return constants;
                     }
@@ -10,7 +10,7 @@
 #define CRYPTO3_HASH_NIL_POSEIDON_SPONGE_HPP
 
 #include <nil/crypto3/hash/detail/poseidon/poseidon_policy.hpp>
-#include <nil/crypto3/hash/detail/poseidon/poseidon_permutation.hpp>
+#include <nil/crypto3/hash/detail/poseidon/poseidon_optimized_permutation.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -26,7 +26,7 @@ namespace nil {
                     // elements (each Rate - 1 instead). State is zeroed after the permutation. Only the first element is returned
                     // from squeeze(), not Rate elements...
                 public:
-                    using permutation_type = poseidon_permutation<Policy>;
+                    using permutation_type = poseidon_optimized_permutation<Policy>;
 
                     using word_type = typename Policy::word_type;
                     using state_type = typename Policy::state_type;
@@ -71,7 +71,7 @@ namespace nil {
                     typedef sponge_construction<
                         params_type, policy_type, typename policy_type::iv_generator,
                          detail::keccak_1600_functions<digest_bits>,
-                         nil::crypto3::hashes::detail::keccak_1600_impl<policy_type>,
+                         typename detail::keccak_1600_functions<digest_bits>::impl_type,
                         detail::keccak_1600_padder<policy_type>>
                         type;
                 };
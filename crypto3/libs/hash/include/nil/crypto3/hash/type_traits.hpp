@@ -117,6 +117,9 @@ namespace nil {
             template<typename Group, typename Hash, typename Params>
             struct h2c;
 
+            template<std::size_t DigestBits>
+            class keccak_1600;
+
             template<typename Hash>
             struct is_find_group_hash : std::integral_constant<bool, false> { };
 
@@ -135,6 +138,12 @@ namespace nil {
             template<typename Group, typename Hash, typename Params>
             struct is_h2c<h2c<Group, Hash, Params>> : std::integral_constant<bool, true> { };
 
+            template<typename Hash>
+            struct is_keccak_1600 : std::integral_constant<bool, false> { };
+
+            template<std::size_t DigestBits>
+            struct is_keccak_1600<keccak_1600<DigestBits>> : std::integral_constant<bool, true> { };
+
             // TODO: change this to more generic type trait to check for all sponge based hashes.
             template<typename HashType, typename Enable = void>
             struct is_poseidon {
@@ -25,7 +25,10 @@
 
 #define BOOST_TEST_MODULE keccak_test
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <random>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/data/test_case.hpp>
@@ -38,6 +41,8 @@
 #include <nil/crypto3/hash/adaptor/hashed.hpp>
 
 #include <nil/crypto3/hash/keccak.hpp>
+#include <nil/crypto3/hash/detail/keccak/keccak_dispatch_impl.hpp>
+#include <nil/crypto3/hash/detail/keccak/keccak_multi_buffer_impl.hpp>
 
 using namespace nil::crypto3;
 using namespace nil::crypto3::accumulators;
@@ -482,3 +487,153 @@ BOOST_AUTO_TEST_CASE(keccak_512_preprocessor2) {
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE(keccak_permutation_backends_test_suite)
+
+typedef hashes::detail::keccak_1600_policy<256> keccak_policy_type;
+typedef hashes::detail::keccak_1600_impl<keccak_policy_type> portable_impl_type;
+typedef hashes::detail::keccak_1600_dispatch_impl<keccak_policy_type> dispatch_impl_type;
+
+template<typename Permutation>
+void check_against_portable(Permutation permutation) {
+    std::mt19937_64 rng(0x6b656363616b);
+    keccak_policy_type::state_type state = {}, expected = {};
+    for (std::size_t i = 0; i < 1000; ++i) {
+        // Zero state first, then random ones, each of them fed the previous output.
+        permutation(state);
+        portable_impl_type::permute(expected);
+        BOOST_REQUIRE(state == expected);
+
+        for (std::size_t j = 0; j < state.size(); ++j) {
+            state[j] = expected[j] = rng();
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(keccak_dispatched_permutation_matches_portable) {
+    BOOST_TEST_MESSAGE("Keccak backend: " << dispatch_impl_type::selected_backend_name());
+    check_against_portable([](keccak_policy_type::state_type &state) { dispatch_impl_type::permute(state); });
+}
+
+#if CRYPTO3_KECCAK_HAS_AVX2_BACKEND
+BOOST_AUTO_TEST_CASE(keccak_avx2_permutation_matches_portable) {
+    if (!__builtin_cpu_supports("avx2")) {
+        return;
+    }
+    check_against_portable([](keccak_policy_type::state_type &state) {
+        hashes::detail::keccak_1600_avx2_impl<keccak_policy_type>::permute(state);
+    });
+}
+#endif
+
+template<std::size_t Lanes>
+void check_multi_buffer_against_portable() {
+    typedef hashes::detail::keccak_1600_multi_buffer_impl<keccak_policy_type> multi_buffer_impl_type;
+
+    std::mt19937_64 rng(0x6d756c7469);
+    typename multi_buffer_impl_type::template interleaved_state_type<Lanes> states;
+    std::array<keccak_policy_type::state_type, Lanes> expected;
+    for (std::size_t i = 0; i < 100; ++i) {
+        for (std::size_t k = 0; k < Lanes; ++k) {
+            for (std::size_t j = 0; j < keccak_policy_type::state_words; ++j) {
+                states[j][k] = expected[k][j] = rng();
+            }
+        }
+        multi_buffer_impl_type::permute(states);
+        for (std::size_t k = 0; k < Lanes; ++k) {
+            portable_impl_type::permute(expected[k]);
+            for (std::size_t j = 0; j < keccak_policy_type::state_words; ++j) {
+                BOOST_REQUIRE_EQUAL(states[j][k], expected[k][j]);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(keccak_multi_buffer_permutation_matches_portable) {
+    BOOST_TEST_MESSAGE("Keccak multi-buffer lanes: "
+                       << hashes::detail::keccak_1600_multi_buffer_impl<keccak_policy_type>::lanes());
+    check_multi_buffer_against_portable<1>();
+    check_multi_buffer_against_portable<4>();
+    check_multi_buffer_against_portable<8>();
+}
+
+template<std::size_t DigestBits>
+void check_multi_buffer_hasher() {
+    typedef hashes::keccak_1600<DigestBits> hash_type;
+    typedef hashes::detail::keccak_1600_multi_buffer_hasher<DigestBits> hasher_type;
+
+    std::mt19937 rng(DigestBits);
+    // Lengths around the rate, counts that leave partial groups.
+    for (std::size_t message_size : {0, 1, 32, 64, 135, 136, 137, 300}) {
+        for (std::size_t count : {1, 3, 4, 5, 8, 13}) {
+            std::vector<std::vector<std::uint8_t>> messages(count, std::vector<std::uint8_t>(message_size));
+            std::vector<const std::uint8_t *> pointers;
+            for (auto &message : messages) {
+                std::generate(message.begin(), message.end(), [&rng]() { return std::uint8_t(rng()); });
+                pointers.push_back(message.data());
+            }
+
+            std::vector<typename hash_type::digest_type> digests(count);
+            hasher_type::hash(pointers.data(), message_size, count, digests.data());
+            for (std::size_t i = 0; i < count; ++i) {
+                typename hash_type::digest_type expected = hash<hash_type>(messages[i]);
+                BOOST_CHECK_EQUAL(digests[i], expected);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(keccak_multi_buffer_hasher_matches_keccak) {
+    check_multi_buffer_hasher<256>();
+    check_multi_buffer_hasher<512>();
+}
+
+BOOST_AUTO_TEST_CASE(keccak_permutation_benchmark, *boost::unit_test::disabled()) {
+    const std::size_t permutations_count = 1 << 22;
+
+    auto measure = [permutations_count](const char *name, auto permutation) {
+        keccak_policy_type::state_type state = {};
+        auto start = std::chrono::high_resolution_clock::now();
+        for (std::size_t i = 0; i < permutations_count; ++i) {
+            permutation(state);
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::high_resolution_clock::now() - start).count();
+        std::cout << name << ": " << double(elapsed) / permutations_count << " ns per permutation, state[0] = "
+                  << state[0] << std::endl;
+    };
+
+    measure("portable", [](keccak_policy_type::state_type &state) { portable_impl_type::permute(state); });
+    measure(dispatch_impl_type::selected_backend_name(),
+            [](keccak_policy_type::state_type &state) { dispatch_impl_type::permute(state); });
+
+    std::vector<std::uint8_t> message(64);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < (permutations_count >> 2); ++i) {
+        message[i % message.size()] ^= static_cast<std::uint8_t>(i);
+        typename hashes::keccak_1600<256>::digest_type d = hash<hashes::keccak_1600<256>>(message);
+        message[0] ^= d[0];
+    }
+    std::cout << "keccak_1600<256> of 64 bytes: "
+              << double(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::high_resolution_clock::now() - start).count()) / (permutations_count >> 2)
+              << " ns per hash" << std::endl;
+
+    const std::size_t messages_count = permutations_count >> 2;
+    std::vector<std::uint8_t> messages_data(messages_count * message.size());
+    std::vector<const std::uint8_t *> messages(messages_count);
+    for (std::size_t i = 0; i < messages_count; ++i) {
+        messages[i] = messages_data.data() + i * message.size();
+    }
+    std::vector<hashes::keccak_1600<256>::digest_type> digests(messages_count);
+    start = std::chrono::high_resolution_clock::now();
+    hashes::detail::keccak_1600_multi_buffer_hasher<256>::hash(messages.data(), message.size(), messages_count,
+                                                                digests.data());
+    std::cout << "keccak_1600<256> of 64 bytes, "
+              << hashes::detail::keccak_1600_multi_buffer_impl<keccak_policy_type>::lanes() << " lanes: "
+              << double(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::high_resolution_clock::now() - start).count()) / messages_count
+              << " ns per hash" << std::endl;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
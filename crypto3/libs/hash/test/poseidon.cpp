@@ -23,12 +23,14 @@
 #include <nil/crypto3/hash/algorithm/hash.hpp>
 #include <nil/crypto3/hash/block_to_field_elements_wrapper.hpp>
 #include <nil/crypto3/hash/detail/poseidon/poseidon_permutation.hpp>
+#include <nil/crypto3/hash/detail/poseidon/poseidon_optimized_permutation.hpp>
 #include <nil/crypto3/hash/hash_state.hpp>
 #include <nil/crypto3/hash/poseidon.hpp>
 
 #include <nil/crypto3/algebra/fields/alt_bn128/scalar_field.hpp>
 #include <nil/crypto3/algebra/fields/bls12/scalar_field.hpp>
 #include <nil/crypto3/algebra/fields/pallas/base_field.hpp>
+#include <nil/crypto3/algebra/random_element.hpp>
 
 using namespace nil::crypto3;
 using namespace nil::crypto3::accumulators;
@@ -93,9 +95,31 @@ void test_poseidon_permutation(
         typename poseidon_policy<FieldType, 128, Rate>::state_type expected_result) {
     using policy = poseidon_policy<FieldType, 128, Rate>;
 
+    typename policy::state_type optimized_input = input;
+
     // This permutes in place.
     poseidon_permutation<policy>::permute(input);
     BOOST_CHECK_EQUAL(input, expected_result);
+
+    poseidon_optimized_permutation<policy>::permute(optimized_input);
+    BOOST_CHECK_EQUAL(optimized_input, expected_result);
+}
+
+template<typename FieldType, size_t Rate>
+void test_poseidon_optimized_permutation_random() {
+    using policy = poseidon_policy<FieldType, 128, Rate>;
+
+    for (std::size_t i = 0; i < 20; ++i) {
+        typename policy::state_type state, optimized_state;
+        for (auto &e : state) {
+            e = random_element<FieldType>();
+        }
+        optimized_state = state;
+
+        poseidon_permutation<policy>::permute(state);
+        poseidon_optimized_permutation<policy>::permute(optimized_state);
+        BOOST_CHECK_EQUAL(optimized_state, state);
+    }
 }
 
 BOOST_AUTO_TEST_SUITE(poseidon_tests)
@@ -286,6 +310,13 @@ BOOST_AUTO_TEST_SUITE(poseidon_tests)
         BOOST_CHECK_EQUAL(d_uint8, d_field);
     }
 
+    BOOST_AUTO_TEST_CASE(poseidon_optimized_permutation_random) {
+        test_poseidon_optimized_permutation_random<fields::alt_bn128_scalar_field<254>, 2>();
+        test_poseidon_optimized_permutation_random<fields::alt_bn128_scalar_field<254>, 4>();
+        test_poseidon_optimized_permutation_random<fields::bls12_scalar_field<381>, 2>();
+        test_poseidon_optimized_permutation_random<fields::bls12_scalar_field<381>, 4>();
+    }
+
 // This test can be useful for constants generation in the future.
 //BOOST_AUTO_TEST_CASE(poseidon_generate_pallas_constants) {
 //
@@ -398,11 +398,73 @@ namespace nil {
 
                 using batch_info_type = std::map<std::size_t, std::size_t>;// batch_id->batch_size
 
+                // FRI proofs of parallel crypto3 can replace the merkle proofs of the queries by multiproofs.
+                template<typename ProofType, typename = void>
+                struct has_merkle_multiproofs : std::false_type {};
+
+                template<typename ProofType>
+                struct has_merkle_multiproofs<ProofType,
+                                              std::void_t<decltype(std::declval<ProofType>().use_merkle_multiproofs)>>
+                    : std::true_type {};
+
+                // Set on the first serialized step of proofs with multiproofs. Then the initial merkle proofs hold one
+                // multiproof per batch in the order of batch_info, and the round merkle proofs one per round.
+                constexpr std::uint8_t fri_proof_merkle_multiproofs_flag = 0x80;
+
+                // A multiproof is stored as a merkle proof with the leaf count of the tree instead of the leaf index,
+                // and every hash of the multiproof as a layer of one path element.
+                template <typename Endianness, typename FRI>
+                typename types::merkle_proof<nil::crypto3::marshalling::field_type<Endianness>, typename FRI::merkle_proof_type>
+                fill_fri_merkle_multiproof(const typename FRI::merkle_multiproof_type &multiproof) {
+                    using TTypeBase = nil::crypto3::marshalling::field_type<Endianness>;
+                    using MerkleProof = typename FRI::merkle_proof_type;
+
+                    typename merkle_proof_path<TTypeBase, MerkleProof>::type filled_path;
+                    for (const auto &hash : multiproof.hashes()) {
+                        typename MerkleProof::path_element_type path_element;
+                        path_element._position = 0;
+                        path_element._hash = hash;
+                        typename merkle_proof_layer<TTypeBase, MerkleProof>::type filled_layer;
+                        filled_layer.value().push_back(
+                            fill_merkle_proof_path_element<MerkleProof, Endianness>(path_element));
+                        filled_path.value().push_back(filled_layer);
+                    }
+                    return typename types::merkle_proof<TTypeBase, MerkleProof>(std::make_tuple(
+                        nil::crypto3::marshalling::types::integral<TTypeBase, std::uint64_t>(multiproof.leaves()),
+                        fill_merkle_node_value<MerkleProof, Endianness>(multiproof.root()),
+                        filled_path));
+                }
+
+                template <typename Endianness, typename FRI>
+                typename FRI::merkle_multiproof_type make_fri_merkle_multiproof(
+                    const typename types::merkle_proof<nil::crypto3::marshalling::field_type<Endianness>, typename FRI::merkle_proof_type> &filled_multiproof)
+                {
+                    using MerkleProof = typename FRI::merkle_proof_type;
+
+                    std::vector<typename MerkleProof::value_type> hashes;
+                    for (const auto &filled_layer : std::get<2>(filled_multiproof.value()).value()) {
+                        if (filled_layer.value().size() != 1) {
+                            throw std::invalid_argument("Merkle multiproof layer must hold exactly one hash");
+                        }
+                        hashes.push_back(
+                            make_merkle_proof_path_element<MerkleProof, Endianness>(filled_layer.value()[0])._hash);
+                    }
+                    return typename FRI::merkle_multiproof_type(
+                        std::get<0>(filled_multiproof.value()).value(),
+                        make_merkle_node_value<MerkleProof, Endianness>(std::get<1>(filled_multiproof.value())),
+                        std::move(hashes));
+                }
+
                 template <typename Endianness, typename FRI>
                 typename fri_proof<nil::crypto3::marshalling::field_type<Endianness>, FRI>::type
                 fill_fri_proof(const typename FRI::proof_type &proof, const batch_info_type &batch_info, const typename FRI::params_type& params) {
                     using TTypeBase = nil::crypto3::marshalling::field_type<Endianness>;
 
+                    bool use_merkle_multiproofs = false;
+                    if constexpr (has_merkle_multiproofs<typename FRI::proof_type>::value) {
+                        use_merkle_multiproofs = proof.use_merkle_multiproofs;
+                    }
+
                     // merkle roots
                     nil::crypto3::marshalling::types::standard_array_list<
                         TTypeBase, typename types::merkle_node_value<TTypeBase, typename FRI::merkle_proof_type>::type
@@ -469,13 +531,44 @@ namespace nil {
                     for (const auto& step : params.step_list) {
                         filled_step_list.value().push_back(nil::crypto3::marshalling::types::integral<TTypeBase, std::uint8_t>(step));
                     }
+                    if (use_merkle_multiproofs) {
+                        filled_step_list.value()[0].value() |= fri_proof_merkle_multiproofs_flag;
+                    }
 
                     // initial merkle proofs
                     nil::crypto3::marshalling::types::standard_array_list<
                         TTypeBase,
                         typename types::merkle_proof<TTypeBase, typename FRI::merkle_proof_type>
                     > filled_initial_merkle_proofs;
-                    for( std::size_t i = 0; i < lambda; i++){
+                    // round merkle proofs
+                    nil::crypto3::marshalling::types::standard_array_list<
+                        TTypeBase,
+                        typename types::merkle_proof<TTypeBase, typename FRI::merkle_proof_type>
+                    > filled_round_merkle_proofs;
+                    if constexpr (has_merkle_multiproofs<typename FRI::proof_type>::value) {
+                        if (use_merkle_multiproofs) {
+                            for (const auto &it : batch_info) {
+                                auto multiproof = proof.initial_multiproofs.find(it.first);
+                                if (multiproof == proof.initial_multiproofs.end()) {
+                                    throw std::invalid_argument(
+                                        std::string("No initial merkle multiproof for batch ") + std::to_string(it.first));
+                                }
+                                filled_initial_merkle_proofs.value().push_back(
+                                    fill_fri_merkle_multiproof<Endianness, FRI>(multiproof->second));
+                            }
+                            if (proof.round_multiproofs.size() != params.step_list.size()) {
+                                throw std::invalid_argument(
+                                    std::string("Wrong number of round merkle multiproofs. Expected: ") +
+                                    std::to_string(params.step_list.size()) + " got: " +
+                                    std::to_string(proof.round_multiproofs.size()));
+                            }
+                            for (const auto &multiproof : proof.round_multiproofs) {
+                                filled_round_merkle_proofs.value().push_back(
+                                    fill_fri_merkle_multiproof<Endianness, FRI>(multiproof));
+                            }
+                        }
+                    }
+                    for( std::size_t i = 0; i < lambda && !use_merkle_multiproofs; i++){
                         const auto &query_proof = proof.query_proofs[i];
                         for( const auto &it:query_proof.initial_proof){
                             const auto &initial_proof = it.second;
@@ -485,12 +578,7 @@ namespace nil {
                         }
                     }
 
-                    // round merkle proofs
-                    nil::crypto3::marshalling::types::standard_array_list<
-                        TTypeBase,
-                        typename types::merkle_proof<TTypeBase, typename FRI::merkle_proof_type>
-                    > filled_round_merkle_proofs;
-                    for( std::size_t i = 0; i < lambda; i++){
+                    for( std::size_t i = 0; i < lambda && !use_merkle_multiproofs; i++){
                         const auto &query_proof = proof.query_proofs[i];
                         for( const auto &round_proof:query_proof.round_proofs){
                             filled_round_merkle_proofs.value().push_back(
@@ -533,8 +621,21 @@ namespace nil {
                         auto c = std::get<1>(filled_proof.value()).value()[i].value();
                         step_list.push_back(c);
                     }
+                    if (step_list.empty()) {
+                        throw std::invalid_argument("Empty FRI step list");
+                    }
+                    const bool use_merkle_multiproofs = (step_list[0] & fri_proof_merkle_multiproofs_flag) != 0;
+                    step_list[0] &= ~fri_proof_merkle_multiproofs_flag;
 
                     std::size_t lambda = std::get<5>(filled_proof.value()).value().size() / step_list.size();
+                    if (use_merkle_multiproofs) {
+                        // There is a merkle proof per tree, the count of the queries follows from the round values.
+                        std::size_t round_values_per_query = 0;
+                        for (std::size_t r = 0; r < step_list.size(); r++) {
+                            round_values_per_query += FRI::m * (r == step_list.size() - 1 ? 1 : (1 << (step_list[r+1]-1)));
+                        }
+                        lambda = std::get<3>(filled_proof.value()).value().size() / round_values_per_query;
+                    }
                     proof.query_proofs.resize(lambda);
                     // initial_polynomials values
                     std::size_t coset_size = 1 << (step_list[0] - 1);
@@ -579,10 +680,33 @@ namespace nil {
                             }
                         }
                     }
+                    if (use_merkle_multiproofs) {
+                        if constexpr (has_merkle_multiproofs<typename FRI::proof_type>::value) {
+                            auto const& initial_multiproofs = std::get<4>(filled_proof.value()).value();
+                            auto const& round_multiproofs = std::get<5>(filled_proof.value()).value();
+                            if (initial_multiproofs.size() != batch_info.size() ||
+                                    round_multiproofs.size() != step_list.size()) {
+                                throw std::invalid_argument("Wrong number of merkle multiproofs");
+                            }
+                            cur = 0;
+                            for (const auto &it: batch_info) {
+                                proof.initial_multiproofs.emplace(
+                                    it.first, make_fri_merkle_multiproof<Endianness, FRI>(initial_multiproofs[cur++]));
+                            }
+                            for (const auto &filled_multiproof : round_multiproofs) {
+                                proof.round_multiproofs.push_back(
+                                    make_fri_merkle_multiproof<Endianness, FRI>(filled_multiproof));
+                            }
+                            proof.use_merkle_multiproofs = true;
+                        } else {
+                            throw std::invalid_argument("FRI proofs with merkle multiproofs are not supported");
+                        }
+                    }
+
                     // initial merkle proofs
                     auto const& initial_merkle_proofs = std::get<4>(filled_proof.value()).value();
                     cur = 0;
-                    for (std::size_t i = 0; i < lambda; i++) {
+                    for (std::size_t i = 0; i < lambda && !use_merkle_multiproofs; i++) {
                         for (const auto &it: batch_info) {
                             if (cur >= initial_merkle_proofs.size()) {
                                 throw std::invalid_argument("Not enough initial_merkle_proof values");
@@ -597,7 +721,7 @@ namespace nil {
                     // round merkle proofs
                     auto const& round_merkle_proofs = std::get<5>(filled_proof.value()).value();
                     cur = 0;
-                    for (std::size_t i = 0; i < lambda; i++ ) {
+                    for (std::size_t i = 0; i < lambda && !use_merkle_multiproofs; i++ ) {
                         for (std::size_t r = 0; r < step_list.size(); r++, cur++ ) {
                             if (cur >= round_merkle_proofs.size()) {
                                 throw std::invalid_argument("Not enough round_merkle_proof values");
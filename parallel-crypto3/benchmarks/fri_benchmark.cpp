@@ -0,0 +1,182 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE fri_benchmark
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/algebra/curves/pallas.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/pallas.hpp>
+
+#include <nil/crypto3/hash/keccak.hpp>
+
+#include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
+
+#include <nil/crypto3/random/algebraic_engine.hpp>
+
+#include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
+#include <nil/crypto3/zk/commitments/polynomial/fri.hpp>
+
+using namespace nil::crypto3;
+
+namespace {
+    // Bytes allocated by operator new and not freed yet, and the largest value it had since the last reset.
+    std::atomic<std::size_t> heap_bytes(0);
+    std::atomic<std::size_t> peak_heap_bytes(0);
+
+    // Every block starts with its size, padded to keep the alignment of the block.
+    constexpr std::size_t header_size = alignof(std::max_align_t);
+
+    void *counted_alloc(std::size_t size) {
+        void *block = std::malloc(size + header_size);
+        if (block == nullptr) {
+            throw std::bad_alloc();
+        }
+        *static_cast<std::size_t *>(block) = size;
+        std::size_t now = heap_bytes.fetch_add(size) + size;
+        std::size_t peak = peak_heap_bytes.load();
+        while (now > peak && !peak_heap_bytes.compare_exchange_weak(peak, now)) {
+        }
+        return static_cast<char *>(block) + header_size;
+    }
+
+    void counted_free(void *ptr) {
+        if (ptr == nullptr) {
+            return;
+        }
+        void *block = static_cast<char *>(ptr) - header_size;
+        heap_bytes.fetch_sub(*static_cast<std::size_t *>(block));
+        std::free(block);
+    }
+
+    // Peak heap usage of the call above the heap usage before it.
+    template<typename Func>
+    std::size_t peak_heap_growth(Func func) {
+        const std::size_t before = heap_bytes.load();
+        peak_heap_bytes = before;
+        func();
+        return peak_heap_bytes.load() - before;
+    }
+
+    double mebibytes(std::size_t bytes) {
+        return bytes / (1024.0 * 1024.0);
+    }
+}    // namespace
+
+void *operator new(std::size_t size) {
+    return counted_alloc(size);
+}
+
+void *operator new[](std::size_t size) {
+    return counted_alloc(size);
+}
+
+void operator delete(void *ptr) noexcept {
+    counted_free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    counted_free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    counted_free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+    counted_free(ptr);
+}
+
+BOOST_AUTO_TEST_SUITE(fri_benchmark_test_suite)
+
+// Runs the commit phase and builds the round proofs of the queries, keeping the rounds and recomputing them, see
+// params_type::recompute_fri_rounds. Reports the time and the peak heap usage above what combined_Q and its tree
+// take, as counted by the operator new of this benchmark.
+BOOST_AUTO_TEST_CASE(fri_commit_phase_memory) {
+    using FieldType = typename algebra::curves::pallas::base_field_type;
+    using value_type = typename FieldType::value_type;
+    using hash_type = hashes::keccak_1600<256>;
+    using fri_type = zk::commitments::fri<FieldType, hash_type, hash_type, 2>;
+    using polynomial_type = math::polynomial_dfs<value_type>;
+
+    constexpr std::size_t degree_log = 20;
+    constexpr std::size_t expand_factor = 4;
+    constexpr std::size_t lambda = 40;
+
+    typename fri_type::params_type params(1, degree_log, lambda, expand_factor);
+    typename fri_type::params_type recompute_params(params.step_list, degree_log, lambda, expand_factor,
+                                                    false, 16, false, true);
+
+    random::algebraic_engine<FieldType> engine(1337);
+    std::vector<value_type> coefficients(1 << degree_log);
+    for (auto &c : coefficients) {
+        c = engine();
+    }
+    polynomial_type combined_Q;
+    combined_Q.from_coefficients(coefficients);
+    combined_Q.resize(params.D[0]->size(), nullptr, params.D[0]);
+    coefficients = {};
+
+    std::vector<typename fri_type::round_proofs_batch_type> round_proofs;
+    for (const auto *fri_params : {&params, &recompute_params}) {
+        auto tree = zk::algorithms::precommit<fri_type>(combined_Q, fri_params->D[0], fri_params->step_list.front());
+
+        std::vector<std::uint8_t> init_blob {0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 9u};
+        typename fri_type::transcript_type transcript(init_blob);
+
+        std::chrono::milliseconds elapsed;
+        const std::size_t peak = peak_heap_growth([&]() {
+            auto start = std::chrono::high_resolution_clock::now();
+            std::vector<value_type> alphas;
+            auto [fs, fri_trees, commitments_proof] = zk::algorithms::commit_phase<fri_type, polynomial_type>(
+                combined_Q, std::move(tree), *fri_params, transcript, &alphas);
+            auto challenges = transcript.template challenges<FieldType>(lambda);
+            if (fri_params->recompute_fri_rounds) {
+                round_proofs.push_back(zk::algorithms::query_phase_recomputed_round_proofs<fri_type, polynomial_type>(
+                    *fri_params, fri_trees.front(), combined_Q, alphas, commitments_proof.final_polynomial,
+                    challenges));
+            } else {
+                round_proofs.push_back(zk::algorithms::query_phase_round_proofs<fri_type, polynomial_type>(
+                    *fri_params, fri_trees, fs, commitments_proof.final_polynomial, challenges));
+            }
+            elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::high_resolution_clock::now() - start);
+        });
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << "FRI commit phase and round proofs, domain size 2^" << degree_log + expand_factor
+                  << (fri_params->recompute_fri_rounds ? ", recomputing the rounds: " : ", keeping the rounds: ")
+                  << elapsed.count() << " ms, peak heap growth " << mebibytes(peak) << " MiB\n";
+    }
+
+    BOOST_CHECK(round_proofs[0].round_proofs == round_proofs[1].round_proofs);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -35,7 +35,9 @@
 #include <algorithm>
 #include <vector>
 #include <stack>
+#include <utility>
 
+#include <boost/assert.hpp>
 #include <boost/variant.hpp>
 
 #include <nil/crypto3/hash/type_traits.hpp>
@@ -293,6 +295,134 @@ namespace nil {
                     friend class nil::crypto3::marshalling::types::merkle_proof_marshalling;
                 };
 
+                /*!
+                 * @brief Opening of several leaves of a merkle_tree at once.
+                 *
+                 * Holds only the hashes the verifier cannot compute from the opened leaves, row by row from the
+                 * leaves up, in the order of node indices. Paths of different leaves meet on the way to the root,
+                 * so it is much shorter than a merkle_proof_impl for each leaf, and every node on the way is hashed
+                 * once. The leaf indices are not stored, the verifier passes them to validate.
+                 */
+                template<typename NodeType, std::size_t Arity = 2>
+                class merkle_multiproof_impl {
+                public:
+                    typedef NodeType node_type;
+                    typedef typename node_type::hash_type hash_type;
+
+                    constexpr static const std::size_t arity = Arity;
+
+                    constexpr static const std::size_t value_bits = node_type::value_bits;
+                    typedef typename node_type::value_type value_type;
+
+                    merkle_multiproof_impl() : _leaves(0), _root(value_type()) {};
+
+                    merkle_multiproof_impl(std::size_t leaves, value_type root, std::vector<value_type> hashes)
+                        : _leaves(leaves), _root(root), _hashes(std::move(hashes)) {};
+
+                    merkle_multiproof_impl(const merkle_tree<hash_type, arity> &tree,
+                                           const std::vector<std::size_t> &leaf_idxs)
+                        : _leaves(tree.leaves()), _root(tree.root()) {
+                        std::vector<std::size_t> row = leaf_idxs;
+                        std::sort(row.begin(), row.end());
+                        row.erase(std::unique(row.begin(), row.end()), row.end());
+                        BOOST_ASSERT(row.empty() || row.back() < _leaves);
+
+                        std::size_t row_begin_idx = 0;
+                        for (std::size_t row_len = _leaves; row_len > 1; row_len /= arity) {
+                            std::vector<std::size_t> next_row;
+                            for (std::size_t i = 0; i < row.size();) {
+                                std::size_t parent = row[i] / arity;
+                                for (std::size_t child = parent * arity; child < (parent + 1) * arity; ++child) {
+                                    if (i < row.size() && row[i] == child) {
+                                        ++i;
+                                    } else {
+                                        _hashes.push_back(tree[row_begin_idx + child]);
+                                    }
+                                }
+                                next_row.push_back(parent);
+                            }
+                            row = std::move(next_row);
+                            row_begin_idx += row_len;
+                        }
+                    }
+
+                    /// Checks that leaves[i] is at leaf_idxs[i] in the tree. The same index may be given several times.
+                    template<typename Hashable>
+                    bool validate(const std::vector<std::size_t> &leaf_idxs, const std::vector<Hashable> &leaves) const {
+                        BOOST_ASSERT(leaf_idxs.size() == leaves.size());
+                        if (leaf_idxs.empty()) {
+                            return false;
+                        }
+
+                        std::vector<std::pair<std::size_t, value_type>> row;
+                        row.reserve(leaf_idxs.size());
+                        for (std::size_t i = 0; i < leaf_idxs.size(); ++i) {
+                            if (leaf_idxs[i] >= _leaves) {
+                                return false;
+                            }
+                            row.emplace_back(leaf_idxs[i], crypto3::hash<hash_type>(leaves[i]));
+                        }
+                        std::sort(row.begin(), row.end(),
+                                  [](const auto &a, const auto &b) { return a.first < b.first; });
+                        for (std::size_t i = 1; i < row.size(); ++i) {
+                            if (row[i].first == row[i - 1].first && row[i].second != row[i - 1].second) {
+                                return false;
+                            }
+                        }
+                        row.erase(std::unique(row.begin(), row.end(),
+                                              [](const auto &a, const auto &b) { return a.first == b.first; }),
+                                  row.end());
+
+                        auto hashes_itr = _hashes.begin();
+                        for (std::size_t row_len = _leaves; row_len > 1; row_len /= arity) {
+                            std::vector<std::pair<std::size_t, value_type>> next_row;
+                            for (std::size_t i = 0; i < row.size();) {
+                                std::size_t parent = row[i].first / arity;
+                                accumulator_set<hash_type> acc;
+                                for (std::size_t child = parent * arity; child < (parent + 1) * arity; ++child) {
+                                    if (i < row.size() && row[i].first == child) {
+                                        crypto3::hash<hash_type>(row[i].second, acc);
+                                        ++i;
+                                    } else {
+                                        if (hashes_itr == _hashes.end()) {
+                                            return false;
+                                        }
+                                        crypto3::hash<hash_type>(*hashes_itr, acc);
+                                        ++hashes_itr;
+                                    }
+                                }
+                                next_row.emplace_back(parent, accumulators::extract::hash<hash_type>(acc));
+                            }
+                            row = std::move(next_row);
+                        }
+                        return hashes_itr == _hashes.end() && row.front().second == _root;
+                    }
+
+                    bool operator==(const merkle_multiproof_impl &rhs) const {
+                        return _leaves == rhs._leaves && _root == rhs._root && _hashes == rhs._hashes;
+                    }
+                    bool operator!=(const merkle_multiproof_impl &rhs) const {
+                        return !(rhs == *this);
+                    }
+
+                    std::size_t leaves() const {
+                        return _leaves;
+                    }
+
+                    const value_type &root() const {
+                        return _root;
+                    }
+
+                    const std::vector<value_type> &hashes() const {
+                        return _hashes;
+                    }
+
+                private:
+                    std::size_t _leaves;
+                    value_type _root;
+                    std::vector<value_type> _hashes;
+                };
+
 
             }    // namespace detail
 
@@ -302,6 +432,12 @@ namespace nil {
                                           detail::merkle_proof_impl<detail::merkle_tree_node<T>, Arity>,
                                           detail::merkle_proof_impl<T, Arity>>::type;
 
+            template<typename T, std::size_t Arity>
+            using merkle_multiproof =
+                typename std::conditional<nil::crypto3::detail::is_hash<T>::value,
+                                          detail::merkle_multiproof_impl<detail::merkle_tree_node<T>, Arity>,
+                                          detail::merkle_multiproof_impl<T, Arity>>::type;
+
         }    // namespace containers
     }        // namespace crypto3
 }    // namespace nil
@@ -363,4 +363,80 @@ BOOST_AUTO_TEST_CASE(merkletree_hash_test_2) {
     testing_hash_template<hashes::sha2<256>, 3>(v, "6831d4d32538bedaa7a51970ac10474d5884701c840781f0a434e5b6868d4b73");
 }
 
+template<typename Hash, size_t Arity, std::size_t N>
+void testing_keccak_batched_template(std::size_t leaf_number) {
+    // Byte leaves take the batched Keccak path, char leaves with the same contents take the generic one.
+    auto data = generate_random_data<std::uint8_t, N>(leaf_number);
+    std::vector<std::array<char, N>> char_data(leaf_number);
+    for (std::size_t i = 0; i < leaf_number; ++i) {
+        std::copy(data[i].begin(), data[i].end(), char_data[i].begin());
+    }
+
+    merkle_tree<Hash, Arity> tree = make_merkle_tree<Hash, Arity>(data.begin(), data.end());
+    merkle_tree<Hash, Arity> expected = make_merkle_tree<Hash, Arity>(char_data.begin(), char_data.end());
+    BOOST_CHECK_EQUAL(tree.size(), expected.size());
+    BOOST_CHECK(std::equal(tree.begin(), tree.end(), expected.begin()));
+
+    std::size_t proof_idx = std::rand() % leaf_number;
+    merkle_proof<Hash, Arity> proof(tree, proof_idx);
+    BOOST_CHECK(proof.validate(data[proof_idx]));
+}
+
+BOOST_AUTO_TEST_CASE(merkletree_keccak_batched_test) {
+    std::vector<std::vector<std::uint8_t>> v = {{'0'}, {'1'}, {'2'}, {'3'}, {'4'}, {'5'}, {'6'}, {'7'}};
+    testing_hash_template<hashes::keccak_1600<256>, 2>(v, "568ff5eb286f51b8a3e8de4e53aa8daed44594a246deebbde119ea2eb27acd6b");
+
+    testing_keccak_batched_template<hashes::keccak_1600<256>, 2, 1>(8);
+    testing_keccak_batched_template<hashes::keccak_1600<256>, 2, 200>(1024);
+    testing_keccak_batched_template<hashes::keccak_1600<256>, 4, 32>(256);
+    testing_keccak_batched_template<hashes::keccak_1600<512>, 2, 64>(64);
+}
+
+template<typename Hash, size_t Arity, typename ValueType, std::size_t N>
+void testing_validate_template_random_data_multiproof(std::size_t leaf_number, std::size_t num_idxs) {
+    using Element = std::array<ValueType, N>;
+    auto data = generate_random_data<ValueType, N>(leaf_number);
+    auto tree = make_merkle_tree<Hash, Arity>(data.begin(), data.end());
+
+    // Repeated indices are expected, FRI queries often open the same leaf.
+    std::vector<std::size_t> proof_idxs;
+    std::vector<Element> data_for_validation;
+    for (std::size_t i = 0; i < num_idxs; ++i) {
+        proof_idxs.emplace_back(std::rand() % leaf_number);
+        data_for_validation.emplace_back(data[proof_idxs.back()]);
+    }
+
+    merkle_multiproof<Hash, Arity> multiproof(tree, proof_idxs);
+    BOOST_CHECK(multiproof.root() == tree.root());
+    BOOST_CHECK(multiproof.validate(proof_idxs, data_for_validation));
+
+    std::size_t path_hashes = num_idxs * (tree.row_count() - 1) * (Arity - 1);
+    BOOST_CHECK(multiproof.hashes().size() <= path_hashes);
+
+    std::size_t wrong_idx = std::rand() % num_idxs;
+    std::vector<std::size_t> wrong_idxs = proof_idxs;
+    wrong_idxs[wrong_idx] = (wrong_idxs[wrong_idx] + 1) % leaf_number;
+    BOOST_CHECK(!multiproof.validate(wrong_idxs, data_for_validation));
+
+    std::vector<Element> wrong_data = data_for_validation;
+    wrong_data[wrong_idx] = data[(proof_idxs[wrong_idx] + 1) % leaf_number];
+    BOOST_CHECK(!multiproof.validate(proof_idxs, wrong_data));
+
+    std::vector<typename merkle_multiproof<Hash, Arity>::value_type> hashes = multiproof.hashes();
+    if (!hashes.empty()) {
+        hashes.pop_back();
+        merkle_multiproof<Hash, Arity> truncated(multiproof.leaves(), multiproof.root(), hashes);
+        BOOST_CHECK(!truncated.validate(proof_idxs, data_for_validation));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(merkletree_multiproof_test) {
+    testing_validate_template_random_data_multiproof<hashes::sha2<256>, 2, std::uint8_t, 32>(8, 1);
+    testing_validate_template_random_data_multiproof<hashes::sha2<256>, 2, std::uint8_t, 32>(8, 8);
+    testing_validate_template_random_data_multiproof<hashes::keccak_1600<256>, 2, std::uint8_t, 64>(1024, 20);
+    testing_validate_template_random_data_multiproof<hashes::keccak_1600<256>, 2, std::uint8_t, 64>(64, 100);
+    testing_validate_template_random_data_multiproof<hashes::sha2<256>, 4, std::uint8_t, 32>(256, 30);
+    testing_validate_template_random_data_multiproof<hashes::sha2<256>, 3, std::uint8_t, 32>(81, 10);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
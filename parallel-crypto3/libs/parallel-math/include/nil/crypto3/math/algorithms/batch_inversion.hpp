@@ -0,0 +1,87 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef PARALLEL_CRYPTO3_MATH_BATCH_INVERSION_HPP
+#define PARALLEL_CRYPTO3_MATH_BATCH_INVERSION_HPP
+
+#ifdef CRYPTO3_MATH_BATCH_INVERSION_HPP
+#error "You're mixing parallel and non-parallel crypto3 versions"
+#endif
+
+#include <iterator>
+#include <vector>
+
+#include <nil/actor/core/thread_pool.hpp>
+#include <nil/actor/core/parallelization_utils.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+
+            /*
+             * Inverts all the values in [first, last) in-place with Montgomery's trick: prefix products are
+             * accumulated, their total is inverted once, and the individual inverses are recovered walking
+             * backwards. The range is split into chunks by the thread pool, each chunk pays for one inversion.
+             * Zero values are skipped and stay zero.
+             */
+            template<typename RandomAccessIterator>
+            void batch_inversion(RandomAccessIterator first, RandomAccessIterator last,
+                                 ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW) {
+                typedef typename std::iterator_traits<RandomAccessIterator>::value_type value_type;
+
+                wait_for_all(parallel_run_in_chunks<void>(
+                    std::distance(first, last),
+                    [first](std::size_t begin, std::size_t end) {
+                        // prefix[i - begin] holds the product of all non-zero values in [begin, i).
+                        std::vector<value_type> prefix(end - begin);
+                        value_type acc = value_type::one();
+                        for (std::size_t i = begin; i < end; ++i) {
+                            prefix[i - begin] = acc;
+                            const value_type &v = first[i];
+                            if (!v.is_zero()) {
+                                acc *= v;
+                            }
+                        }
+
+                        acc = acc.inversed();
+                        for (std::size_t i = end; i-- > begin;) {
+                            value_type &v = first[i];
+                            if (v.is_zero()) {
+                                continue;
+                            }
+                            value_type inv = acc * prefix[i - begin];
+                            acc *= v;
+                            v = inv;
+                        }
+                    }, pool_id));
+            }
+
+            template<typename Range>
+            void batch_inversion(Range &values, ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW) {
+                batch_inversion(std::begin(values), std::end(values), pool_id);
+            }
+
+        }    // namespace math
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // PARALLEL_CRYPTO3_MATH_BATCH_INVERSION_HPP
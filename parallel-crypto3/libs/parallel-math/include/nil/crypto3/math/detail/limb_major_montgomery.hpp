@@ -0,0 +1,707 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef PARALLEL_CRYPTO3_MATH_LIMB_MAJOR_MONTGOMERY_HPP
+#define PARALLEL_CRYPTO3_MATH_LIMB_MAJOR_MONTGOMERY_HPP
+
+#ifdef CRYPTO3_MATH_LIMB_MAJOR_MONTGOMERY_HPP
+#error "You're mixing parallel and non-parallel crypto3 versions"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <boost/predef/architecture.h>
+
+#include <nil/crypto3/multiprecision/big_mod.hpp>
+
+// Define CRYPTO3_MATH_LIMB_MAJOR_PORTABLE to always evaluate field elements one by one.
+#if !defined(CRYPTO3_MATH_LIMB_MAJOR_PORTABLE) && BOOST_ARCH_X86_64 && (defined(__GNUC__) || defined(__clang__))
+#define CRYPTO3_MATH_HAS_LIMB_MAJOR_BACKENDS 1
+#define CRYPTO3_MATH_LIMB_MAJOR_AVX2_TARGET __attribute__((target("avx2")))
+#define CRYPTO3_MATH_LIMB_MAJOR_AVX512_TARGET __attribute__((target("avx512f")))
+#define CRYPTO3_MATH_LIMB_MAJOR_IFMA_TARGET __attribute__((target("avx512f,avx512ifma")))
+#include <immintrin.h>
+#endif
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+
+            enum class limb_major_backend { scalar, avx2, avx512, avx512_ifma };
+
+            // True for prime field elements with a compile-time modulus kept in Montgomery form.
+            template<typename ValueType, typename = void>
+            struct is_limb_major_field_element : std::false_type {};
+
+            template<typename ValueType>
+            struct is_limb_major_field_element<
+                ValueType, std::void_t<typename ValueType::modular_type::modular_ops_t, decltype(ValueType::modulus)>>
+                : std::is_same<typename ValueType::modular_type::modular_ops_t,
+                               multiprecision::detail::montgomery_modular_ops<ValueType::modular_type::Bits>> {};
+
+            /*
+             * Field arithmetic on blocks of BlockSize values stored limb-major: word w of value r is at
+             * block[w * BlockSize + r], so word w of all the values is loaded as a single vector and one instruction
+             * works on 4 (AVX2) or 8 (AVX-512) values. AVX2 and AVX-512F multiply 32-bit words with vpmuludq,
+             * a block of them is the raw Montgomery form of the values split into halves of limbs. AVX-512 IFMA
+             * multiplies 52-bit words with vpmadd52, its Montgomery radix is 2^(52 * words()), so values are
+             * moved to it and back when loaded and stored. All the backends return the same values as the scalar
+             * field operations. Only prime fields in Montgomery form are supported, see is_limb_major_field_element.
+             */
+            template<typename ValueType, std::size_t BlockSize>
+            class limb_major_montgomery {
+            public:
+                static_assert(is_limb_major_field_element<ValueType>::value,
+                              "limb_major_montgomery needs a prime field element in Montgomery form");
+                static_assert(BlockSize % 8 == 0, "limb_major_montgomery block should be a whole number of vectors");
+
+            private:
+                using big_uint_type = typename ValueType::modular_type::big_uint_t;
+                using limb_type = typename big_uint_type::limb_type;
+
+                static constexpr std::size_t limb_bits = big_uint_type::limb_bits;
+                static constexpr std::size_t limbs_count = big_uint_type::internal_limb_count;
+                // The Montgomery radix of ValueType is 2^montgomery_bits.
+                static constexpr std::size_t montgomery_bits = limbs_count * limb_bits;
+
+                static constexpr std::size_t words32 = montgomery_bits / 32;
+                static constexpr std::size_t words52 = (montgomery_bits + 51) / 52;
+
+            public:
+                explicit limb_major_montgomery(limb_major_backend backend) : _backend(backend) {
+                    if (backend == limb_major_backend::scalar || !is_available(backend)) {
+                        throw std::invalid_argument("limb_major_montgomery: no such vector backend on this CPU");
+                    }
+                    const limb_type* modulus = ValueType::modulus.limbs();
+                    std::uint64_t inverse = 0;
+                    if (_backend == limb_major_backend::avx512_ifma) {
+                        for (std::size_t w = 0; w < words52; ++w) {
+                            _modulus[w] = extract_bits(modulus, w * 52, 52);
+                        }
+                        inverse = inverse_modulo_word(_modulus[0]);
+                        _modulus_dash = (0 - inverse) & word_mask(52);
+
+                        // Multiplying by F * F moves x * R to x * R', multiplying by one() moves it back, where
+                        // R' = R * F and F = 2^(52 * words52 - montgomery_bits).
+                        const ValueType factor(std::uint64_t(1) << (52 * words52 - montgomery_bits));
+                        const ValueType to_radix = factor * factor;
+                        _to_radix.resize(words52 * BlockSize);
+                        _from_radix.resize(words52 * BlockSize);
+                        split(to_radix, 0, _to_radix.data());
+                        split(ValueType::one(), 0, _from_radix.data());
+                        for (std::size_t r = 1; r < BlockSize; ++r) {
+                            for (std::size_t w = 0; w < words52; ++w) {
+                                _to_radix[w * BlockSize + r] = _to_radix[w * BlockSize];
+                                _from_radix[w * BlockSize + r] = _from_radix[w * BlockSize];
+                            }
+                        }
+                    } else {
+                        for (std::size_t w = 0; w < words32; ++w) {
+                            _modulus[w] = extract_bits(modulus, w * 32, 32);
+                        }
+                        inverse = inverse_modulo_word(_modulus[0]);
+                        _modulus_dash = (0 - inverse) & word_mask(32);
+                    }
+                }
+
+                limb_major_backend backend() const {
+                    return _backend;
+                }
+
+                // Number of words per value, a block takes words() * BlockSize 64-bit integers.
+                std::size_t words() const {
+                    return _backend == limb_major_backend::avx512_ifma ? words52 : words32;
+                }
+
+                /*
+                 * Writes values[0], values[step], ..., values[(rows - 1) * step] to the block.
+                 * Step 0 repeats a single value over all the rows, the rest of the block is filled with zeros.
+                 */
+                void load(const ValueType* values, std::size_t step, std::size_t rows, std::uint64_t* block) const {
+                    if (step == 0) {
+                        split(values[0], 0, block);
+                        for (std::size_t w = 0; w < words(); ++w) {
+                            std::fill(block + w * BlockSize + 1, block + (w + 1) * BlockSize, block[w * BlockSize]);
+                        }
+                    } else {
+                        for (std::size_t r = 0; r < rows; ++r) {
+                            split(values[r * step], r, block);
+                        }
+                        for (std::size_t w = 0; w < words(); ++w) {
+                            std::fill(block + w * BlockSize + rows, block + (w + 1) * BlockSize, 0);
+                        }
+                    }
+                    if (_backend == limb_major_backend::avx512_ifma) {
+                        mul(block, _to_radix.data(), block);
+                    }
+                }
+
+                // Writes the first rows values of the block to values. The block is overwritten.
+                void store(std::uint64_t* block, std::size_t rows, ValueType* values) const {
+                    if (_backend == limb_major_backend::avx512_ifma) {
+                        mul(block, _from_radix.data(), block);
+                    }
+                    for (std::size_t r = 0; r < rows; ++r) {
+                        join(block, r, values[r]);
+                    }
+                }
+
+                // dst = a + b, dst = a - b and dst = a * b value by value. dst may be a or b.
+                void add(const std::uint64_t* a, const std::uint64_t* b, std::uint64_t* dst) const {
+#if CRYPTO3_MATH_HAS_LIMB_MAJOR_BACKENDS
+                    switch (_backend) {
+                        case limb_major_backend::avx2:
+                            add_avx2(a, b, _modulus, dst);
+                            return;
+                        case limb_major_backend::avx512:
+                            add_avx512<words32, 32>(a, b, _modulus, dst);
+                            return;
+                        case limb_major_backend::avx512_ifma:
+                            add_avx512<words52, 52>(a, b, _modulus, dst);
+                            return;
+                        default:
+                            break;
+                    }
+#endif
+                    throw std::invalid_argument("limb_major_montgomery: unknown backend");
+                }
+
+                void sub(const std::uint64_t* a, const std::uint64_t* b, std::uint64_t* dst) const {
+#if CRYPTO3_MATH_HAS_LIMB_MAJOR_BACKENDS
+                    switch (_backend) {
+                        case limb_major_backend::avx2:
+                            sub_avx2(a, b, _modulus, dst);
+                            return;
+                        case limb_major_backend::avx512:
+                            sub_avx512<words32, 32>(a, b, _modulus, dst);
+                            return;
+                        case limb_major_backend::avx512_ifma:
+                            sub_avx512<words52, 52>(a, b, _modulus, dst);
+                            return;
+                        default:
+                            break;
+                    }
+#endif
+                    throw std::invalid_argument("limb_major_montgomery: unknown backend");
+                }
+
+                void mul(const std::uint64_t* a, const std::uint64_t* b, std::uint64_t* dst) const {
+#if CRYPTO3_MATH_HAS_LIMB_MAJOR_BACKENDS
+                    switch (_backend) {
+                        case limb_major_backend::avx2:
+                            mul_avx2(a, b, _modulus, _modulus_dash, dst);
+                            return;
+                        case limb_major_backend::avx512:
+                            mul_avx512(a, b, _modulus, _modulus_dash, dst);
+                            return;
+                        case limb_major_backend::avx512_ifma:
+                            mul_ifma(a, b, _modulus, _modulus_dash, dst);
+                            return;
+                        default:
+                            break;
+                    }
+#endif
+                    throw std::invalid_argument("limb_major_montgomery: unknown backend");
+                }
+
+                // True if the backend is compiled in and the CPU supports it. The scalar one is always available.
+                static bool is_available(limb_major_backend backend) {
+#if CRYPTO3_MATH_HAS_LIMB_MAJOR_BACKENDS
+                    switch (backend) {
+                        case limb_major_backend::scalar:
+                            return true;
+                        case limb_major_backend::avx2:
+                            return __builtin_cpu_supports("avx2");
+                        case limb_major_backend::avx512:
+                            return __builtin_cpu_supports("avx512f");
+                        case limb_major_backend::avx512_ifma:
+                            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma");
+                    }
+                    return false;
+#else
+                    return backend == limb_major_backend::scalar;
+#endif
+                }
+
+                /*
+                 * The backend to use for ValueType, picked once per process. Every available vector backend must
+                 * reproduce the scalar results on a few blocks, then the fastest multiplication on a short run wins,
+                 * which may be the scalar one.
+                 */
+                static limb_major_backend best_backend() {
+                    static const limb_major_backend selected = select_backend();
+                    return selected;
+                }
+
+            private:
+                static std::uint64_t word_mask(std::size_t bits) {
+                    return bits == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bits) - 1;
+                }
+
+                // -1 / odd mod 2^64 by Newton's iteration, each step doubles the number of correct bits.
+                static std::uint64_t inverse_modulo_word(std::uint64_t odd) {
+                    std::uint64_t inverse = odd;
+                    for (std::size_t i = 0; i < 6; ++i) {
+                        inverse *= 2 - odd * inverse;
+                    }
+                    return inverse;
+                }
+
+                // Bits [offset, offset + count) of a number of limbs_count limbs, count <= 64.
+                static std::uint64_t extract_bits(const limb_type* limbs, std::size_t offset, std::size_t count) {
+                    std::uint64_t result = 0;
+                    for (std::size_t done = 0; done < count;) {
+                        const std::size_t limb = (offset + done) / limb_bits;
+                        if (limb >= limbs_count) {
+                            break;
+                        }
+                        const std::size_t shift = (offset + done) % limb_bits;
+                        const std::size_t taken = std::min(count - done, limb_bits - shift);
+                        result |= (static_cast<std::uint64_t>(limbs[limb] >> shift) & word_mask(taken)) << done;
+                        done += taken;
+                    }
+                    return result;
+                }
+
+                std::size_t word_bits() const {
+                    return _backend == limb_major_backend::avx512_ifma ? 52 : 32;
+                }
+
+                // Writes the raw Montgomery form of value to lane r of the block.
+                void split(const ValueType& value, std::size_t r, std::uint64_t* block) const {
+                    const limb_type* limbs = value.data.raw_base().limbs();
+                    for (std::size_t w = 0; w < words(); ++w) {
+                        block[w * BlockSize + r] = extract_bits(limbs, w * word_bits(), word_bits());
+                    }
+                }
+
+                void join(const std::uint64_t* block, std::size_t r, ValueType& value) const {
+                    limb_type* limbs = value.data.raw_base().limbs();
+                    std::fill(limbs, limbs + limbs_count, limb_type(0));
+                    for (std::size_t w = 0; w < words(); ++w) {
+                        const std::uint64_t word = block[w * BlockSize + r];
+                        for (std::size_t done = 0; done < word_bits();) {
+                            const std::size_t limb = (w * word_bits() + done) / limb_bits;
+                            if (limb >= limbs_count) {
+                                break;
+                            }
+                            const std::size_t shift = (w * word_bits() + done) % limb_bits;
+                            const std::size_t taken = std::min(word_bits() - done, limb_bits - shift);
+                            limbs[limb] |= static_cast<limb_type>((word >> done) & word_mask(taken)) << shift;
+                            done += taken;
+                        }
+                    }
+                }
+
+                static limb_major_backend select_backend() {
+                    limb_major_backend best = limb_major_backend::scalar;
+#if CRYPTO3_MATH_HAS_LIMB_MAJOR_BACKENDS
+                    std::vector<ValueType> a(BlockSize), b(BlockSize), expected(BlockSize);
+                    ValueType x = ValueType(3), y = -ValueType(5);
+                    for (std::size_t r = 0; r < BlockSize; ++r) {
+                        a[r] = x;
+                        b[r] = y;
+                        x = x * x + ValueType(7);
+                        y = y * x - ValueType(1);
+                    }
+                    a[0] = ValueType::zero();
+                    b[1] = ValueType::zero();
+                    a[2] = ValueType::one();
+                    a[3] = b[3] = -ValueType::one();
+
+                    auto best_time = measure([&a, &b, &expected]() {
+                        for (std::size_t r = 0; r < BlockSize; ++r) {
+                            expected[r] = a[r] * b[r];
+                        }
+                    });
+                    for (limb_major_backend candidate : {limb_major_backend::avx2, limb_major_backend::avx512,
+                                                         limb_major_backend::avx512_ifma}) {
+                        if (!is_available(candidate)) {
+                            continue;
+                        }
+                        const limb_major_montgomery limb_major(candidate);
+                        if (!limb_major.reproduces_scalar(a, b)) {
+                            continue;
+                        }
+                        std::vector<std::uint64_t> a_block(limb_major.words() * BlockSize),
+                            b_block(limb_major.words() * BlockSize);
+                        limb_major.load(a.data(), 1, BlockSize, a_block.data());
+                        limb_major.load(b.data(), 1, BlockSize, b_block.data());
+                        auto time = measure([&limb_major, &a_block, &b_block]() {
+                            limb_major.mul(a_block.data(), b_block.data(), b_block.data());
+                        });
+                        if (time < best_time) {
+                            best = candidate;
+                            best_time = time;
+                        }
+                    }
+#endif
+                    return best;
+                }
+
+                bool reproduces_scalar(const std::vector<ValueType>& a, const std::vector<ValueType>& b) const {
+                    std::vector<std::uint64_t> a_block(words() * BlockSize), b_block(words() * BlockSize),
+                        result_block(words() * BlockSize);
+                    std::vector<ValueType> result(BlockSize);
+                    load(a.data(), 1, BlockSize, a_block.data());
+                    load(b.data(), 1, BlockSize, b_block.data());
+
+                    add(a_block.data(), b_block.data(), result_block.data());
+                    store(result_block.data(), BlockSize, result.data());
+                    for (std::size_t r = 0; r < BlockSize; ++r) {
+                        if (result[r] != a[r] + b[r]) {
+                            return false;
+                        }
+                    }
+                    sub(a_block.data(), b_block.data(), result_block.data());
+                    store(result_block.data(), BlockSize, result.data());
+                    for (std::size_t r = 0; r < BlockSize; ++r) {
+                        if (result[r] != a[r] - b[r]) {
+                            return false;
+                        }
+                    }
+                    mul(a_block.data(), b_block.data(), result_block.data());
+                    store(result_block.data(), BlockSize, result.data());
+                    for (std::size_t r = 0; r < BlockSize; ++r) {
+                        if (result[r] != a[r] * b[r]) {
+                            return false;
+                        }
+                    }
+                    return true;
+                }
+
+                template<typename Operation>
+                static std::chrono::steady_clock::duration measure(Operation operation) {
+                    constexpr std::size_t runs = 3;
+                    constexpr std::size_t operations_per_run = 64;
+
+                    auto best = std::chrono::steady_clock::duration::max();
+                    for (std::size_t run = 0; run < runs; ++run) {
+                        auto start = std::chrono::steady_clock::now();
+                        for (std::size_t i = 0; i < operations_per_run; ++i) {
+                            operation();
+                        }
+                        best = std::min(best, std::chrono::steady_clock::now() - start);
+                    }
+                    return best;
+                }
+
+#if CRYPTO3_MATH_HAS_LIMB_MAJOR_BACKENDS
+                typedef std::uint64_t vector_x4_type __attribute__((vector_size(32)));
+                typedef std::uint64_t vector_x8_type __attribute__((vector_size(64)));
+
+                /*
+                 * The parts shared by all the backends, written with vector extensions so they compile to the
+                 * instructions of the backend they are inlined into. The arguments point to word 0 of the
+                 * values in a vector, word w of them is BlockSize further.
+                 */
+
+                // Writes t mod modulus to dst, where t < 2 * modulus is Words words and a carry in t[Words].
+                template<typename VectorType, std::size_t Words, std::size_t WordBits>
+                __attribute__((always_inline)) static inline void reduce_once(const VectorType* t,
+                                                                              const std::uint64_t* modulus,
+                                                                              std::uint64_t* dst) {
+                    constexpr std::uint64_t mask = (std::uint64_t(1) << WordBits) - 1;
+                    VectorType difference[Words];
+                    VectorType borrow = {};
+                    for (std::size_t w = 0; w < Words; ++w) {
+                        const VectorType s = t[w] - modulus[w] - borrow;
+                        difference[w] = s & mask;
+                        borrow = s >> 63;
+                    }
+                    const VectorType use_difference = -(t[Words] | (borrow ^ 1));
+                    for (std::size_t w = 0; w < Words; ++w) {
+                        const VectorType result = (difference[w] & use_difference) | (t[w] & ~use_difference);
+                        std::memcpy(dst + w * BlockSize, &result, sizeof(VectorType));
+                    }
+                }
+
+                template<typename VectorType, std::size_t Words, std::size_t WordBits>
+                __attribute__((always_inline)) static inline void add_vectors(const std::uint64_t* a,
+                                                                              const std::uint64_t* b,
+                                                                              const std::uint64_t* modulus,
+                                                                              std::uint64_t* dst) {
+                    constexpr std::uint64_t mask = (std::uint64_t(1) << WordBits) - 1;
+                    VectorType t[Words + 1];
+                    VectorType carry = {};
+                    for (std::size_t w = 0; w < Words; ++w) {
+                        VectorType x, y;
+                        std::memcpy(&x, a + w * BlockSize, sizeof(VectorType));
+                        std::memcpy(&y, b + w * BlockSize, sizeof(VectorType));
+                        const VectorType s = x + y + carry;
+                        t[w] = s & mask;
+                        carry = s >> WordBits;
+                    }
+                    t[Words] = carry;
+                    reduce_once<VectorType, Words, WordBits>(t, modulus, dst);
+                }
+
+                template<typename VectorType, std::size_t Words, std::size_t WordBits>
+                __attribute__((always_inline)) static inline void sub_vectors(const std::uint64_t* a,
+                                                                              const std::uint64_t* b,
+                                                                              const std::uint64_t* modulus,
+                                                                              std::uint64_t* dst) {
+                    constexpr std::uint64_t mask = (std::uint64_t(1) << WordBits) - 1;
+                    VectorType t[Words];
+                    VectorType borrow = {};
+                    for (std::size_t w = 0; w < Words; ++w) {
+                        VectorType x, y;
+                        std::memcpy(&x, a + w * BlockSize, sizeof(VectorType));
+                        std::memcpy(&y, b + w * BlockSize, sizeof(VectorType));
+                        const VectorType s = x - y - borrow;
+                        t[w] = s & mask;
+                        borrow = s >> 63;
+                    }
+                    // Adds the modulus back if a < b.
+                    const VectorType add_modulus = -borrow;
+                    VectorType carry = {};
+                    for (std::size_t w = 0; w < Words; ++w) {
+                        const VectorType s = t[w] + (add_modulus & modulus[w]) + carry;
+                        const VectorType result = s & mask;
+                        carry = s >> WordBits;
+                        std::memcpy(dst + w * BlockSize, &result, sizeof(VectorType));
+                    }
+                }
+
+                CRYPTO3_MATH_LIMB_MAJOR_AVX2_TARGET static void add_avx2(const std::uint64_t* a,
+                                                                           const std::uint64_t* b,
+                                                                           const std::uint64_t* modulus,
+                                                                           std::uint64_t* dst) {
+                    for (std::size_t g = 0; g < BlockSize; g += 4) {
+                        add_vectors<vector_x4_type, words32, 32>(a + g, b + g, modulus, dst + g);
+                    }
+                }
+
+                CRYPTO3_MATH_LIMB_MAJOR_AVX2_TARGET static void sub_avx2(const std::uint64_t* a,
+                                                                           const std::uint64_t* b,
+                                                                           const std::uint64_t* modulus,
+                                                                           std::uint64_t* dst) {
+                    for (std::size_t g = 0; g < BlockSize; g += 4) {
+                        sub_vectors<vector_x4_type, words32, 32>(a + g, b + g, modulus, dst + g);
+                    }
+                }
+
+                template<std::size_t Words, std::size_t WordBits>
+                CRYPTO3_MATH_LIMB_MAJOR_AVX512_TARGET static void add_avx512(const std::uint64_t* a,
+                                                                               const std::uint64_t* b,
+                                                                               const std::uint64_t* modulus,
+                                                                               std::uint64_t* dst) {
+                    for (std::size_t g = 0; g < BlockSize; g += 8) {
+                        add_vectors<vector_x8_type, Words, WordBits>(a + g, b + g, modulus, dst + g);
+                    }
+                }
+
+                template<std::size_t Words, std::size_t WordBits>
+                CRYPTO3_MATH_LIMB_MAJOR_AVX512_TARGET static void sub_avx512(const std::uint64_t* a,
+                                                                               const std::uint64_t* b,
+                                                                               const std::uint64_t* modulus,
+                                                                               std::uint64_t* dst) {
+                    for (std::size_t g = 0; g < BlockSize; g += 8) {
+                        sub_vectors<vector_x8_type, Words, WordBits>(a + g, b + g, modulus, dst + g);
+                    }
+                }
+
+                // The multiplications of the backends. Only the low 32 bits of the lanes of x and y are read.
+                CRYPTO3_MATH_LIMB_MAJOR_AVX2_TARGET __attribute__((always_inline)) static inline vector_x4_type
+                    mul_lo32(vector_x4_type x, vector_x4_type y) {
+                    return (vector_x4_type)_mm256_mul_epu32((__m256i)x, (__m256i)y);
+                }
+
+                CRYPTO3_MATH_LIMB_MAJOR_AVX512_TARGET __attribute__((always_inline)) static inline vector_x8_type
+                    mul_lo32(vector_x8_type x, vector_x8_type y) {
+                    return (vector_x8_type)_mm512_maskz_mul_epu32(0xff, (__m512i)x, (__m512i)y);
+                }
+
+                // t + the low or the high 52 bits of x * y. Only the low 52 bits of the lanes of x and y are read.
+                CRYPTO3_MATH_LIMB_MAJOR_IFMA_TARGET __attribute__((always_inline)) static inline vector_x8_type
+                    madd52lo(vector_x8_type t, vector_x8_type x, vector_x8_type y) {
+                    return (vector_x8_type)_mm512_madd52lo_epu64((__m512i)t, (__m512i)x, (__m512i)y);
+                }
+
+                CRYPTO3_MATH_LIMB_MAJOR_IFMA_TARGET __attribute__((always_inline)) static inline vector_x8_type
+                    madd52hi(vector_x8_type t, vector_x8_type x, vector_x8_type y) {
+                    return (vector_x8_type)_mm512_madd52hi_epu64((__m512i)t, (__m512i)x, (__m512i)y);
+                }
+
+                /*
+                 * Montgomery multiplication with 32-bit words (CIOS). Words are kept in 64-bit lanes, so
+                 * t + x * y + carry of 32-bit t, x, y and carry never overflows a lane. The low 32 bits of
+                 * m = t[0] * modulus_dash are all that mul_lo32 reads, so m is not masked.
+                 */
+                CRYPTO3_MATH_LIMB_MAJOR_AVX2_TARGET static void mul_avx2(const std::uint64_t* a,
+                                                                           const std::uint64_t* b,
+                                                                           const std::uint64_t* modulus,
+                                                                           std::uint64_t modulus_dash,
+                                                                           std::uint64_t* dst) {
+                    constexpr std::size_t Words = words32;
+                    const vector_x4_type dash = vector_x4_type{} + modulus_dash;
+                    vector_x4_type p[Words];
+                    for (std::size_t w = 0; w < Words; ++w) {
+                        p[w] = vector_x4_type{} + modulus[w];
+                    }
+                    for (std::size_t g = 0; g < BlockSize; g += 4) {
+                        vector_x4_type x[Words], t[Words + 2] = {};
+                        for (std::size_t w = 0; w < Words; ++w) {
+                            std::memcpy(&x[w], a + w * BlockSize + g, sizeof(vector_x4_type));
+                        }
+                        for (std::size_t i = 0; i < Words; ++i) {
+                            vector_x4_type y, s, carry = {};
+                            std::memcpy(&y, b + i * BlockSize + g, sizeof(vector_x4_type));
+                            for (std::size_t j = 0; j < Words; ++j) {
+                                s = t[j] + mul_lo32(x[j], y) + carry;
+                                t[j] = s & 0xffffffff;
+                                carry = s >> 32;
+                            }
+                            s = t[Words] + carry;
+                            t[Words] = s & 0xffffffff;
+                            t[Words + 1] = s >> 32;
+
+                            const vector_x4_type m = mul_lo32(t[0], dash);
+                            carry = (t[0] + mul_lo32(m, p[0])) >> 32;
+                            for (std::size_t j = 1; j < Words; ++j) {
+                                s = t[j] + mul_lo32(m, p[j]) + carry;
+                                t[j - 1] = s & 0xffffffff;
+                                carry = s >> 32;
+                            }
+                            s = t[Words] + carry;
+                            t[Words - 1] = s & 0xffffffff;
+                            t[Words] = t[Words + 1] + (s >> 32);
+                        }
+                        reduce_once<vector_x4_type, Words, 32>(t, modulus, dst + g);
+                    }
+                }
+
+                // mul_avx2 with 8 values per vector.
+                CRYPTO3_MATH_LIMB_MAJOR_AVX512_TARGET static void mul_avx512(const std::uint64_t* a,
+                                                                               const std::uint64_t* b,
+                                                                               const std::uint64_t* modulus,
+                                                                               std::uint64_t modulus_dash,
+                                                                               std::uint64_t* dst) {
+                    constexpr std::size_t Words = words32;
+                    const vector_x8_type dash = vector_x8_type{} + modulus_dash;
+                    vector_x8_type p[Words];
+                    for (std::size_t w = 0; w < Words; ++w) {
+                        p[w] = vector_x8_type{} + modulus[w];
+                    }
+                    for (std::size_t g = 0; g < BlockSize; g += 8) {
+                        vector_x8_type x[Words], t[Words + 2] = {};
+                        for (std::size_t w = 0; w < Words; ++w) {
+                            std::memcpy(&x[w], a + w * BlockSize + g, sizeof(vector_x8_type));
+                        }
+                        for (std::size_t i = 0; i < Words; ++i) {
+                            vector_x8_type y, s, carry = {};
+                            std::memcpy(&y, b + i * BlockSize + g, sizeof(vector_x8_type));
+                            for (std::size_t j = 0; j < Words; ++j) {
+                                s = t[j] + mul_lo32(x[j], y) + carry;
+                                t[j] = s & 0xffffffff;
+                                carry = s >> 32;
+                            }
+                            s = t[Words] + carry;
+                            t[Words] = s & 0xffffffff;
+                            t[Words + 1] = s >> 32;
+
+                            const vector_x8_type m = mul_lo32(t[0], dash);
+                            carry = (t[0] + mul_lo32(m, p[0])) >> 32;
+                            for (std::size_t j = 1; j < Words; ++j) {
+                                s = t[j] + mul_lo32(m, p[j]) + carry;
+                                t[j - 1] = s & 0xffffffff;
+                                carry = s >> 32;
+                            }
+                            s = t[Words] + carry;
+                            t[Words - 1] = s & 0xffffffff;
+                            t[Words] = t[Words + 1] + (s >> 32);
+                        }
+                        reduce_once<vector_x8_type, Words, 32>(t, modulus, dst + g);
+                    }
+                }
+
+                /*
+                 * Montgomery multiplication with 52-bit words. madd52lo and madd52hi add the low or the high half
+                 * of a product to a 64-bit lane, so carries are left in the lanes and only the one out of t[0]
+                 * is taken before the shift. A lane collects less than 4 * Words halves of 52 bits, which fits
+                 * in 64 bits, and is normalized once at the end.
+                 */
+                CRYPTO3_MATH_LIMB_MAJOR_IFMA_TARGET static void mul_ifma(const std::uint64_t* a,
+                                                                           const std::uint64_t* b,
+                                                                           const std::uint64_t* modulus,
+                                                                           std::uint64_t modulus_dash,
+                                                                           std::uint64_t* dst) {
+                    constexpr std::size_t Words = words52;
+                    constexpr std::uint64_t mask = (std::uint64_t(1) << 52) - 1;
+                    const vector_x8_type dash = vector_x8_type{} + modulus_dash;
+                    vector_x8_type p[Words];
+                    for (std::size_t w = 0; w < Words; ++w) {
+                        p[w] = vector_x8_type{} + modulus[w];
+                    }
+                    for (std::size_t g = 0; g < BlockSize; g += 8) {
+                        vector_x8_type x[Words], t[Words + 1] = {};
+                        for (std::size_t w = 0; w < Words; ++w) {
+                            std::memcpy(&x[w], a + w * BlockSize + g, sizeof(vector_x8_type));
+                        }
+                        for (std::size_t i = 0; i < Words; ++i) {
+                            vector_x8_type y;
+                            std::memcpy(&y, b + i * BlockSize + g, sizeof(vector_x8_type));
+                            for (std::size_t j = 0; j < Words; ++j) {
+                                t[j] = madd52lo(t[j], x[j], y);
+                                t[j + 1] = madd52hi(t[j + 1], x[j], y);
+                            }
+                            const vector_x8_type m = madd52lo(vector_x8_type{}, t[0], dash);
+                            for (std::size_t j = 0; j < Words; ++j) {
+                                t[j] = madd52lo(t[j], m, p[j]);
+                                t[j + 1] = madd52hi(t[j + 1], m, p[j]);
+                            }
+                            t[1] += t[0] >> 52;
+                            for (std::size_t j = 0; j < Words; ++j) {
+                                t[j] = t[j + 1];
+                            }
+                            t[Words] = vector_x8_type{};
+                        }
+                        vector_x8_type carry = {};
+                        for (std::size_t j = 0; j < Words; ++j) {
+                            const vector_x8_type s = t[j] + carry;
+                            t[j] = s & mask;
+                            carry = s >> 52;
+                        }
+                        t[Words] = carry;
+                        reduce_once<vector_x8_type, Words, 52>(t, modulus, dst + g);
+                    }
+                }
+#endif
+
+                limb_major_backend _backend;
+                std::uint64_t _modulus[std::max(words32, words52)] = {};
+                std::uint64_t _modulus_dash = 0;
+                // Broadcast factors which move values to the IFMA Montgomery radix and back.
+                std::vector<std::uint64_t> _to_radix;
+                std::vector<std::uint64_t> _from_radix;
+            };
+        }    // namespace math
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif    // PARALLEL_CRYPTO3_MATH_LIMB_MAJOR_MONTGOMERY_HPP
@@ -63,6 +63,34 @@ namespace nil {
                     detail::create_fft_cache<FieldType>(this->m, omega.inversed(), fft_cache->second);
                 }
 
+                void resize_columns(const std::vector<std::vector<value_type> *> &columns) {
+                    for (std::vector<value_type> *a : columns) {
+                        if (a->size() != this->m) {
+                            if (a->size() < this->m) {
+                                a->resize(this->m, value_type::zero());
+                            } else {
+                                throw std::invalid_argument("basic_radix2: expected a.size() == this->m");
+                            }
+                        }
+                    }
+                }
+
+                /*
+                 * Splits the elements of 'columns_count' columns of size m into chunks for the LOW level thread pool
+                 * and calls func(column, begin, end) for each part of a column that falls into a chunk.
+                 */
+                template<typename ChunkFunction>
+                void for_each_column_chunk(const std::size_t columns_count, ChunkFunction func) {
+                    const std::size_t m = this->m;
+                    wait_for_all(parallel_run_in_chunks<void>(
+                        columns_count * m,
+                        [m, &func](std::size_t begin, std::size_t end) {
+                            for (std::size_t c = begin / m; c * m < end; ++c) {
+                                func(c, std::max(begin, c * m) - c * m, std::min(end, (c + 1) * m) - c * m);
+                            }
+                        }, ThreadPool::PoolLevel::LOW));
+                }
+
             public:
                 typedef FieldType field_type;
 
@@ -114,6 +142,96 @@ namespace nil {
                     });
                 }
 
+                void fft_batch(const std::vector<std::vector<value_type> *> &columns) override {
+                    resize_columns(columns);
+                    detail::basic_radix2_fft_batch_cached<FieldType>(columns, fft_cache->first);
+                }
+
+                void inverse_fft_batch(const std::vector<std::vector<value_type> *> &columns) override {
+                    resize_columns(columns);
+                    detail::basic_radix2_fft_batch_cached<FieldType>(columns, fft_cache->second);
+
+                    const field_value_type sconst = field_value_type(this->m).inversed();
+                    for_each_column_chunk(columns.size(), [&columns, &sconst](std::size_t c, std::size_t begin, std::size_t end) {
+                        std::vector<value_type> &a = *columns[c];
+                        for (std::size_t i = begin; i < end; ++i) {
+                            a[i] *= sconst;
+                        }
+                    });
+                }
+
+                void low_degree_extension(std::vector<value_type> &a,
+                                          evaluation_domain<FieldType, ValueType> &extended_domain,
+                                          const field_value_type &shift = field_value_type::one()) override {
+                    low_degree_extension_batch({&a}, extended_domain, shift);
+                }
+
+                /**
+                 * If the extended domain is a basic radix2 domain of size k * m, the result is computed with k FFTs
+                 * of size m instead of one FFT of size k * m over a vector that is mostly zeros. Value number
+                 * i * k + r of the result is the value at shift * omega_ext^r * omega^i, i.e. value number i of
+                 * the FFT of the coefficients multiplied by the powers of shift * omega_ext^r.
+                 */
+                void low_degree_extension_batch(const std::vector<std::vector<value_type> *> &columns,
+                                                evaluation_domain<FieldType, ValueType> &extended_domain,
+                                                const field_value_type &shift = field_value_type::one()) override {
+                    basic_radix2_domain *extended = dynamic_cast<basic_radix2_domain *>(&extended_domain);
+                    if (extended == nullptr || extended->m <= this->m) {
+                        evaluation_domain<FieldType, ValueType>::low_degree_extension_batch(columns, extended_domain, shift);
+                        return;
+                    }
+
+                    const std::size_t m = this->m;
+                    const std::size_t extended_m = extended->m;
+                    const std::size_t k = extended_m / m;
+
+                    this->inverse_fft_batch(columns);
+                    if (shift != field_value_type::one()) {
+                        for_each_column_chunk(columns.size(), [&columns, &shift](std::size_t c, std::size_t begin, std::size_t end) {
+                            std::vector<value_type> &a = *columns[c];
+                            field_value_type shift_power = shift.pow(begin);
+                            for (std::size_t i = begin; i < end; ++i) {
+                                a[i] *= shift_power;
+                                shift_power *= shift;
+                            }
+                        });
+                    }
+
+                    // omega_ext^(r * i) is taken from the fft cache of the extended domain, r * i < extended_m.
+                    const std::vector<field_value_type> &extended_omega_powers = extended->fft_cache->first;
+                    std::vector<std::vector<value_type>> results(columns.size(), std::vector<value_type>(extended_m));
+                    std::vector<std::vector<value_type>> coset_values(columns.size(), std::vector<value_type>(m));
+                    std::vector<std::vector<value_type> *> coset_columns(columns.size());
+                    for (std::size_t c = 0; c < columns.size(); ++c) {
+                        coset_columns[c] = &coset_values[c];
+                    }
+
+                    for (std::size_t r = 0; r < k; ++r) {
+                        for_each_column_chunk(columns.size(),
+                            [&columns, &coset_values, &extended_omega_powers, r](std::size_t c, std::size_t begin, std::size_t end) {
+                                const std::vector<value_type> &a = *columns[c];
+                                for (std::size_t i = begin; i < end; ++i) {
+                                    coset_values[c][i] = a[i];
+                                    if (r != 0) {
+                                        coset_values[c][i] *= extended_omega_powers[r * i];
+                                    }
+                                }
+                            });
+
+                        detail::basic_radix2_fft_batch_cached<FieldType>(coset_columns, fft_cache->first);
+
+                        for_each_column_chunk(columns.size(),
+                            [&results, &coset_values, k, r](std::size_t c, std::size_t begin, std::size_t end) {
+                                for (std::size_t i = begin; i < end; ++i) {
+                                    results[c][i * k + r] = coset_values[c][i];
+                                }
+                            });
+                    }
+                    for (std::size_t c = 0; c < columns.size(); ++c) {
+                        *columns[c] = std::move(results[c]);
+                    }
+                }
+
                 std::vector<field_value_type> evaluate_all_lagrange_polynomials(const field_value_type &t) override {
                     return detail::basic_radix2_evaluate_all_lagrange_polynomials<FieldType>(this->m, t);
                 }
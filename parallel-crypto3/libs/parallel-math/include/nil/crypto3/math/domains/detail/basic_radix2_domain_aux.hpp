@@ -38,6 +38,7 @@
 #include <nil/crypto3/algebra/type_traits.hpp>
 
 #include <nil/crypto3/math/algorithms/unity_root.hpp>
+#include <nil/crypto3/math/algorithms/batch_inversion.hpp>
 #include <nil/crypto3/math/detail/field_utils.hpp>
 
 #include <nil/actor/core/thread_pool.hpp>
@@ -69,13 +70,112 @@ namespace nil {
                 }
 
                 /*
-                 * Below we make use of pseudocode from [CLRS 2n Ed, pp. 864].
-                 * Also, note that it's the caller's responsibility to multiply by 1/N.
+                 * Number of butterfly stages performed inside one cache-resident block before the threads
+                 * are synchronized. 2^12 elements of a 256-bit field take 128KB, which fits into L2 cache.
+                 */
+                static constexpr std::size_t FFT_BLOCK_LOG2 = 12;
+
+                /*
+                 * The batched FFT interleaves the butterflies of up to 2^FFT_BATCH_GROUP_LOG2 columns, so each
+                 * twiddle factor is loaded once for the whole group. Its blocks are smaller by the same factor,
+                 * so a block of all the columns of a group still fits into L2 cache.
+                 */
+                static constexpr std::size_t FFT_BATCH_GROUP_LOG2 = 2;
+
+                /*
+                 * Performs 'stages' consecutive butterfly stages, starting with the stage of half-span 'm0'.
+                 * Butterflies of these stages form n / 2^stages independent sub-transforms of 2^stages elements
+                 * taken with stride m0, this function does sub-transform number 'block' in each of the columns.
                  */
                 template<typename FieldType, typename Range>
-                void basic_radix2_fft_cached(Range &a, const std::vector<typename FieldType::value_type> &omega_cache) {
+                void basic_radix2_fft_block(Range *const *columns, const std::size_t columns_count,
+                                            const std::vector<typename FieldType::value_type> &omega_cache,
+                                            const std::size_t n, const std::size_t m0, const std::size_t stages,
+                                            const std::size_t block) {
                     typedef typename std::iterator_traits<decltype(std::begin(std::declval<Range>()))>::value_type
                         value_type;
+
+                    const std::size_t block_size = std::size_t(1) << stages;
+
+                    // Elements of the block are a[base + i * m0], i = 0..block_size-1.
+                    const std::size_t low = block % m0;
+                    const std::size_t base = (block / m0) * (m0 << stages) + low;
+
+                    value_type t;
+                    // invariant: m = m0 * 2^q = m0 * half
+                    for (std::size_t q = 0, half = 1, m = m0, inc = n / (2 * m0); q < stages;
+                         ++q, half <<= 1, m <<= 1, inc >>= 1) {
+                        for (std::size_t g = 0; g < block_size; g += 2 * half) {
+                            std::size_t idx = base + g * m0;
+                            std::size_t omega_idx = low * inc;
+                            for (std::size_t j = 0; j < half; ++j, idx += m0, omega_idx += m0 * inc) {
+                                const typename FieldType::value_type &w = omega_cache[omega_idx];
+                                for (std::size_t c = 0; c < columns_count; ++c) {
+                                    Range &a = *columns[c];
+                                    t = a[idx + m];
+                                    t *= w;
+                                    a[idx + m] = a[idx];
+                                    a[idx + m] -= t;
+                                    a[idx] += t;
+                                }
+                            }
+                        }
+                    }
+                }
+
+                /*
+                 * Performs 'stages' consecutive butterfly stages of each of the columns, see basic_radix2_fft_block.
+                 * Each sub-transform is done by a single thread from the first stage to the last, so its elements
+                 * stay in cache and the whole pass has a single synchronization point.
+                 */
+                template<typename FieldType, typename Range>
+                void basic_radix2_fft_pass(Range *const *columns, const std::size_t columns_count,
+                                           const std::vector<typename FieldType::value_type> &omega_cache,
+                                           const std::size_t m0, const std::size_t stages) {
+                    const std::size_t n = columns[0]->size();
+                    const std::size_t half_block = std::size_t(1) << (stages - 1);
+                    const std::size_t blocks_count = n >> stages;
+
+                    // We split the work by butterflies, not by blocks, so the minimal chunk size keeps its meaning.
+                    // Block number 'b' is processed by the chunk which contains butterfly number 'b * half_block'.
+                    wait_for_all(parallel_run_in_chunks<void>(
+                        blocks_count * half_block,
+                        [columns, columns_count, &omega_cache, n, m0, stages, half_block](std::size_t begin, std::size_t end) {
+                            const std::size_t first_block = (begin + half_block - 1) / half_block;
+                            const std::size_t last_block = (end + half_block - 1) / half_block;
+                            for (std::size_t block = first_block; block < last_block; ++block) {
+                                basic_radix2_fft_block<FieldType>(columns, columns_count, omega_cache, n, m0, stages,
+                                                                  block);
+                            }
+                        }, ThreadPool::PoolLevel::LOW));
+                }
+
+                /*
+                 * Splits log2(n) butterfly stages into passes of at most 'block_log2' stages and calls
+                 * pass(m0, stages) for each of them. The stages are spread evenly over the passes, so the blocks
+                 * of all the passes are of similar size.
+                 */
+                template<typename PassFunction>
+                void for_each_fft_pass(const std::size_t logn, const std::size_t block_log2, PassFunction pass) {
+                    const std::size_t passes = (logn + block_log2 - 1) / block_log2;
+                    for (std::size_t s = 0, pass_index = 0; s < logn; ++pass_index) {
+                        const std::size_t stages = (logn - s + (passes - pass_index) - 1) / (passes - pass_index);
+                        pass(std::size_t(1) << s, stages);
+                        s += stages;
+                    }
+                }
+
+                /*
+                 * Below we make use of pseudocode from [CLRS 2n Ed, pp. 864].
+                 * Also, note that it's the caller's responsibility to multiply by 1/N.
+                 *
+                 * Butterfly stages are grouped into passes of at most 'block_log2' stages, each pass transforms
+                 * cache-sized blocks independently (see basic_radix2_fft_pass). So instead of log2(n) barriers
+                 * we have ceil(log2(n) / block_log2) of them, and the data is read from memory once per pass.
+                 */
+                template<typename FieldType, typename Range>
+                void basic_radix2_fft_cached(Range &a, const std::vector<typename FieldType::value_type> &omega_cache,
+                                             const std::size_t block_log2 = FFT_BLOCK_LOG2) {
                     BOOST_STATIC_ASSERT(algebra::is_field<FieldType>::value);
 
                     // It now supports curve elements too, should probably some other assertion about the field type and value type
@@ -84,6 +184,10 @@ namespace nil {
                     const std::size_t n = a.size(), logn = log2(n);
                     if (n != (1u << logn))
                         throw std::invalid_argument("expected n == (1u << logn)");
+                    if (block_log2 == 0)
+                        throw std::invalid_argument("expected block_log2 > 0");
+
+                    ThreadPool::concurrency_limit_guard stage_limit(ThreadPool::Stage::FFT);
 
                     // swapping in place (from Storer's book)
                     // We can parallelize this look, since k and rk are pairs, they will never intersect.
@@ -95,41 +199,97 @@ namespace nil {
                         }
                     );
 
+                    Range *column = &a;
+                    for_each_fft_pass(logn, block_log2, [&column, &omega_cache](std::size_t m0, std::size_t stages) {
+                        basic_radix2_fft_pass<FieldType>(&column, 1, omega_cache, m0, stages);
+                    });
+                }
 
-                    // invariant: m = 2^{s-1}
-                    value_type t;
-                    for (std::size_t s = 1, m = 1, inc = n / 2; s <= logn; ++s, m <<= 1, inc >>= 1) {
-                        // w_m is 2^s-th root of unity now
-                        size_t count_k = n / (2 * m) + (n % (2 * m) ? 1 : 0);
+                /*
+                 * FFT of several columns of equal size, it's the caller's responsibility to multiply by 1/N.
+                 *
+                 * When there are at least as many columns as threads, each group of 2^FFT_BATCH_GROUP_LOG2 columns
+                 * is transformed by a single thread from start to end, with no synchronization at all. Otherwise
+                 * the groups are transformed one after another, each of them with all the threads. In both cases
+                 * the butterflies of the columns of a group are interleaved, sharing the twiddle factor loads.
+                 */
+                template<typename FieldType, typename Range>
+                void basic_radix2_fft_batch_cached(const std::vector<Range *> &columns,
+                                                   const std::vector<typename FieldType::value_type> &omega_cache) {
+                    BOOST_STATIC_ASSERT(algebra::is_field<FieldType>::value);
+
+                    if (columns.empty())
+                        return;
+
+                    const std::size_t n = columns[0]->size(), logn = log2(n);
+                    if (n != (1u << logn))
+                        throw std::invalid_argument("expected n == (1u << logn)");
+                    for (const Range *column : columns) {
+                        if (column->size() != n)
+                            throw std::invalid_argument("expected all the columns to be of the same size");
+                    }
 
-                        // Here we can parallelize on the both loops with 'k' and 'm', because for each value of k and m
-                        // the ranges of array 'a' used do not intersect. Think of these 2 loops as 1.
+                    ThreadPool::concurrency_limit_guard stage_limit(ThreadPool::Stage::FFT);
+
+                    // A single column is transformed with the blocks of basic_radix2_fft_cached.
+                    std::size_t group_log2 = 0;
+                    while (group_log2 < FFT_BATCH_GROUP_LOG2 && (std::size_t(1) << group_log2) < columns.size()) {
+                        ++group_log2;
+                    }
+                    const std::size_t group_size = std::size_t(1) << group_log2;
+                    const std::size_t groups_count = (columns.size() + group_size - 1) / group_size;
+                    const std::size_t block_log2 = FFT_BLOCK_LOG2 - group_log2;
+
+                    if (columns.size() >= ThreadPool::get_instance(ThreadPool::PoolLevel::LOW).get_pool_size()) {
+                        // Group number 'g' is processed by the chunk which contains element number 'g * n'.
                         wait_for_all(parallel_run_in_chunks<void>(
-                            m * count_k,
-                            [&a, m, count_k, inc, &omega_cache](std::size_t begin, std::size_t end) {
-                                size_t current_index = begin;
-                                size_t start_k = begin / m;
-                                value_type t;
-                                for (std::size_t k_index = start_k; k_index < count_k; ++k_index) {
-                                    std::size_t k = k_index * 2 * m;
-
-                                    std::size_t j = (start_k == k_index) ? (begin % m): 0;
-                                    std::size_t idx = j * inc;
-
-                                    for (; j < m; ++j, idx += inc) {
-                                        t = a[k + j + m];
-                                        t *= omega_cache[idx];
-                                        a[k + j + m] = a[k + j];
-                                        a[k + j + m] -= t;
-                                        a[k + j] += t;
-
-                                        ++current_index;
-                                        if (current_index == end)
-                                            return;
+                            groups_count * n,
+                            [&columns, &omega_cache, n, logn, group_size, block_log2](std::size_t begin, std::size_t end) {
+                                const std::size_t first_group = (begin + n - 1) / n;
+                                const std::size_t last_group = (end + n - 1) / n;
+                                for (std::size_t group = first_group; group < last_group; ++group) {
+                                    Range *const *group_columns = columns.data() + group * group_size;
+                                    const std::size_t group_columns_count =
+                                        std::min(group_size, columns.size() - group * group_size);
+
+                                    for (std::size_t c = 0; c < group_columns_count; ++c) {
+                                        Range &a = *group_columns[c];
+                                        for (std::size_t k = 0; k < n; ++k) {
+                                            const std::size_t rk = crypto3::math::detail::bitreverse(k, logn);
+                                            if (k < rk)
+                                                std::swap(a[k], a[rk]);
+                                        }
                                     }
+                                    for_each_fft_pass(logn, block_log2,
+                                        [group_columns, group_columns_count, &omega_cache, n](std::size_t m0, std::size_t stages) {
+                                            for (std::size_t block = 0; block < (n >> stages); ++block) {
+                                                basic_radix2_fft_block<FieldType>(group_columns, group_columns_count,
+                                                                                  omega_cache, n, m0, stages, block);
+                                            }
+                                        });
                                 }
-                            }, ThreadPool::PoolLevel::LOW
-                        ));
+                            }, ThreadPool::PoolLevel::LOW));
+                        return;
+                    }
+
+                    for (std::size_t group = 0; group < groups_count; ++group) {
+                        Range *const *group_columns = columns.data() + group * group_size;
+                        const std::size_t group_columns_count = std::min(group_size, columns.size() - group * group_size);
+
+                        nil::crypto3::parallel_for(0, n * group_columns_count,
+                            [group_columns, n, logn](std::size_t i) {
+                                Range &a = *group_columns[i / n];
+                                const std::size_t k = i % n;
+                                const std::size_t rk = crypto3::math::detail::bitreverse(k, logn);
+                                if (k < rk)
+                                    std::swap(a[k], a[rk]);
+                            }
+                        );
+                        for_each_fft_pass(logn, block_log2,
+                            [group_columns, group_columns_count, &omega_cache](std::size_t m0, std::size_t stages) {
+                                basic_radix2_fft_pass<FieldType>(group_columns, group_columns_count, omega_cache, m0,
+                                                                 stages);
+                            });
                     }
                 }
 
@@ -176,7 +336,8 @@ namespace nil {
                      then output 1 at the right place, and 0 elsewhere
                      */
 
-                    if (t.pow(m) == value_type::one()) {
+                    const value_type t_m = t.pow(m);
+                    if (t_m == value_type::one()) {
                         value_type omega_i = value_type::one();
                         for (std::size_t i = 0; i < m; ++i) {
                             if (omega_i == t)    // i.e., t equals omega^i
@@ -196,16 +357,32 @@ namespace nil {
                      - Z_{S}(t) = \prod_{j} (t-\omega^j) = (t^m-1), and
                      - v_{i} = 1 / \prod_{j \neq i} (\omega^i-\omega^j).
                      Below we use the fact that v_{0} = 1/m and v_{i+1} = \omega * v_{i}.
+                     All the (t-\omega^i) are inverted with a single batch inversion.
                      */
 
-                    const value_type Z = (t.pow(m)) - value_type::one();
-                    value_type l = Z * value_type(m).inversed();
-                    value_type r = value_type::one();
-                    for (std::size_t i = 0; i < m; ++i) {
-                        u[i] = l * (t - r).inversed();
-                        l *= omega;
-                        r *= omega;
-                    }
+                    wait_for_all(parallel_run_in_chunks<void>(
+                        m,
+                        [&u, &t, &omega](std::size_t begin, std::size_t end) {
+                            value_type r = omega.pow(begin);
+                            for (std::size_t i = begin; i < end; ++i) {
+                                u[i] = t - r;
+                                r *= omega;
+                            }
+                        }, ThreadPool::PoolLevel::LOW));
+
+                    batch_inversion(u);
+
+                    const value_type Z = t_m - value_type::one();
+                    const value_type l0 = Z * value_type(m).inversed();
+                    wait_for_all(parallel_run_in_chunks<void>(
+                        m,
+                        [&u, &l0, &omega](std::size_t begin, std::size_t end) {
+                            value_type l = l0 * omega.pow(begin);
+                            for (std::size_t i = begin; i < end; ++i) {
+                                u[i] *= l;
+                                l *= omega;
+                            }
+                        }, ThreadPool::PoolLevel::LOW));
 
                     return u;
                 }
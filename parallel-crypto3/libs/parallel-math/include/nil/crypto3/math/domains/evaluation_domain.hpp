@@ -32,8 +32,12 @@
 
 #include <vector>
 
+#include <nil/crypto3/math/coset.hpp>
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 
+#include <nil/actor/core/thread_pool.hpp>
+#include <nil/actor/core/parallelization_utils.hpp>
+
 namespace nil {
     namespace crypto3 {
         namespace math {
@@ -89,6 +93,52 @@ namespace nil {
                  */
                 virtual void inverse_fft(std::vector<value_type> &a) = 0;
 
+                /**
+                 * Low degree extension. On input 'a' holds the evaluations of a polynomial over S, on output it holds
+                 * the evaluations of the same polynomial over the coset shift * S' of a larger domain S'.
+                 * Domains that can do better than an inverse FFT followed by a zero-padded FFT override this.
+                 */
+                virtual void low_degree_extension(std::vector<value_type> &a, evaluation_domain &extended_domain,
+                                                  const field_value_type &shift = field_value_type::one()) {
+                    this->inverse_fft(a);
+                    if (shift != field_value_type::one()) {
+                        multiply_by_coset(a, shift);
+                    }
+                    a.resize(extended_domain.m, value_type::zero());
+                    extended_domain.fft(a);
+                }
+
+                /**
+                 * Batched versions of fft, inverse_fft and low_degree_extension over columns of equal size.
+                 * By default the columns are transformed in parallel one by one, domains that can share the work
+                 * between the columns override these. They use the HIGH level thread pool, so must not be called
+                 * from it.
+                 */
+                virtual void fft_batch(const std::vector<std::vector<value_type> *> &columns) {
+                    parallel_for(0, columns.size(), [this, &columns](std::size_t i) {
+                        this->fft(*columns[i]);
+                    }, ThreadPool::PoolLevel::HIGH);
+                }
+
+                virtual void inverse_fft_batch(const std::vector<std::vector<value_type> *> &columns) {
+                    parallel_for(0, columns.size(), [this, &columns](std::size_t i) {
+                        this->inverse_fft(*columns[i]);
+                    }, ThreadPool::PoolLevel::HIGH);
+                }
+
+                virtual void low_degree_extension_batch(const std::vector<std::vector<value_type> *> &columns,
+                                                        evaluation_domain &extended_domain,
+                                                        const field_value_type &shift = field_value_type::one()) {
+                    this->inverse_fft_batch(columns);
+                    parallel_for(0, columns.size(), [&columns, &extended_domain, &shift](std::size_t i) {
+                        if (shift != field_value_type::one()) {
+                            multiply_by_coset(*columns[i], shift);
+                        }
+                        columns[i]->resize(extended_domain.m, value_type::zero());
+                    }, ThreadPool::PoolLevel::HIGH);
+                    extended_domain.fft_batch(columns);
+                }
+
                 /**
                  * Evaluate all Lagrange polynomials.
                  *
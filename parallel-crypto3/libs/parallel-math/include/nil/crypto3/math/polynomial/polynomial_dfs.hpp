@@ -37,6 +37,7 @@
 #include <vector>
 #include <ostream>
 #include <iterator>
+#include <map>
 #include <unordered_map>
 
 #include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
@@ -144,7 +145,7 @@ namespace nil {
                                      "DFS optimal polynomial size must be a power of two");
                 }
 
-                polynomial_dfs(size_t d, container_type&& c) : val(c), _d(d) {
+                polynomial_dfs(size_t d, container_type&& c) : val(std::move(c)), _d(d) {
                     BOOST_ASSERT_MSG(val.size() == detail::power_of_two(val.size()),
                                      "DFS optimal polynomial size must be a power of two");
                 }
@@ -358,14 +359,18 @@ namespace nil {
                         } else {
                             BOOST_ASSERT_MSG(old_domain->size() == this->size(), "Old domain size is not equal to the polynomial size");
                         }
-                        old_domain->inverse_fft(this->val);
-                        this->val.resize(_sz, FieldValueType::zero());
                         if (new_domain == nullptr) {
                             new_domain = make_evaluation_domain<FieldType>(_sz);
                         } else {
                             BOOST_ASSERT_MSG(new_domain->size() == _sz, "New domain size is not equal to the polynomial size");
                         }
-                        new_domain->fft(this->val);
+                        if (_sz > this->size()) {
+                            old_domain->low_degree_extension(this->val, *new_domain);
+                        } else {
+                            old_domain->inverse_fft(this->val);
+                            this->val.resize(_sz, FieldValueType::zero());
+                            new_domain->fft(this->val);
+                        }
                     }
                 }
 
@@ -375,12 +380,34 @@ namespace nil {
                 }
 
                 FieldValueType evaluate(const FieldValueType& value) const {
-                    std::vector<FieldValueType> tmp = this->coefficients();
+                    typedef typename value_type::field_type FieldType;
+                    return evaluate_with_lagrange_coefficients(
+                        detail::basic_radix2_evaluate_all_lagrange_polynomials<FieldType>(this->size(), value));
+                }
+
+                /**
+                 * Barycentric evaluation: 'lagrange_coefficients' are the values of the Lagrange basis polynomials
+                 * of the domain of size this->size() at some point, as returned by
+                 * basic_radix2_evaluate_all_lagrange_polynomials. They can be shared by all the polynomials of the
+                 * same size evaluated at that point.
+                 */
+                FieldValueType evaluate_with_lagrange_coefficients(
+                        const std::vector<FieldValueType>& lagrange_coefficients) const {
+                    BOOST_ASSERT(lagrange_coefficients.size() == this->size());
+
+                    std::vector<FieldValueType> partial_sums = wait_for_all(parallel_run_in_chunks<FieldValueType>(
+                        this->size(),
+                        [this, &lagrange_coefficients](std::size_t begin, std::size_t end) {
+                            FieldValueType result = FieldValueType::zero();
+                            for (std::size_t i = begin; i < end; ++i) {
+                                result += val[i] * lagrange_coefficients[i];
+                            }
+                            return result;
+                        }, ThreadPool::PoolLevel::LOW));
+
                     FieldValueType result = FieldValueType::zero();
-                    auto end = tmp.end();
-                    // TODO(martun): parallelize the lower loop.
-                    while (end != tmp.begin()) {
-                        result = result * value + *--end;
+                    for (const auto& partial_sum : partial_sums) {
+                        result += partial_sum;
                     }
                     return result;
                 }
@@ -929,6 +956,84 @@ namespace nil {
                 return multipliers[0];
             }
 
+            /**
+             * Same as calling coefficients() on each of the polynomials. The polynomials are grouped by size and
+             * each group is converted with a single inverse_fft_batch call.
+             */
+            template<typename FieldType>
+            static inline std::vector<polynomial<typename FieldType::value_type>> polynomials_coefficients(
+                    const std::vector<const polynomial_dfs<typename FieldType::value_type> *> &polys) {
+                using FieldValueType = typename FieldType::value_type;
+
+                std::vector<std::vector<FieldValueType>> coefficients(polys.size());
+                std::map<std::size_t, std::vector<std::size_t>> size_to_indices;
+                for (std::size_t i = 0; i < polys.size(); ++i) {
+                    size_to_indices[polys[i]->size()].push_back(i);
+                }
+
+                for (const auto& [size, indices] : size_to_indices) {
+                    std::vector<std::vector<FieldValueType> *> columns;
+                    for (std::size_t i : indices) {
+                        coefficients[i].assign(polys[i]->begin(), polys[i]->end());
+                        columns.push_back(&coefficients[i]);
+                    }
+                    // A single value is its own coefficient, and there is no evaluation domain of size 1.
+                    if (size > 1) {
+                        make_evaluation_domain<FieldType>(size)->inverse_fft_batch(columns);
+                    }
+                }
+
+                std::vector<polynomial<FieldValueType>> result(polys.size());
+                for (std::size_t i = 0; i < polys.size(); ++i) {
+                    std::size_t r_size = coefficients[i].size();
+                    while (r_size > 1 && coefficients[i][r_size - 1] == FieldValueType::zero()) {
+                        --r_size;
+                    }
+                    coefficients[i].resize(r_size);
+                    result[i] = polynomial<FieldValueType>(std::move(coefficients[i]));
+                }
+                return result;
+            }
+
+            /**
+             * Same as calling resize(new_size, nullptr, new_domain) on each of the polynomials. Polynomials of
+             * equal size are extended with a single low_degree_extension_batch call.
+             */
+            template<typename FieldType>
+            static inline void resize_polynomials(
+                    const std::vector<polynomial_dfs<typename FieldType::value_type> *> &polys,
+                    std::size_t new_size,
+                    std::shared_ptr<evaluation_domain<FieldType>> new_domain = nullptr) {
+                using FieldValueType = typename FieldType::value_type;
+
+                std::map<std::size_t, std::vector<polynomial_dfs<FieldValueType> *>> size_to_polys;
+                for (polynomial_dfs<FieldValueType> *poly : polys) {
+                    if (poly->size() == new_size) {
+                        continue;
+                    }
+                    if (poly->degree() == 0 || poly->size() > new_size) {
+                        // Constants are only copied, and shrinking is rare, no need to batch these.
+                        poly->resize(new_size, nullptr, new_domain);
+                        continue;
+                    }
+                    size_to_polys[poly->size()].push_back(poly);
+                }
+                if (size_to_polys.empty()) {
+                    return;
+                }
+
+                if (new_domain == nullptr) {
+                    new_domain = make_evaluation_domain<FieldType>(new_size);
+                }
+                for (const auto& [size, group] : size_to_polys) {
+                    std::vector<std::vector<FieldValueType> *> columns;
+                    for (polynomial_dfs<FieldValueType> *poly : group) {
+                        columns.push_back(&poly->get_storage());
+                    }
+                    make_evaluation_domain<FieldType>(size)->low_degree_extension_batch(columns, *new_domain);
+                }
+            }
+
         }    // namespace math
     }        // namespace crypto3
 }    // namespace nil
@@ -37,11 +37,14 @@
 #include <nil/crypto3/math/polynomial/polynomial.hpp>
 #include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
 #include <nil/crypto3/math/polynomial/shift.hpp>
+#include <nil/crypto3/math/coset.hpp>
 #include <nil/crypto3/math/algorithms/unity_root.hpp>
 #include <nil/crypto3/math/domains/detail/basic_radix2_domain_aux.hpp>
 
 #include <nil/crypto3/algebra/random_element.hpp>
 
+#include <nil/actor/core/first_touch_allocator.hpp>
+
 using namespace nil::crypto3::algebra;
 using namespace nil::crypto3::math;
 
@@ -111,6 +114,181 @@ BOOST_AUTO_TEST_CASE(basic_radix2_domain_benchmark, *boost::unit_test::disabled(
               << " ms" << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE(blocked_fft_matches_evaluation) {
+    using value_type = FieldType::value_type;
+    const std::size_t fft_size = 1 << 10;
+    const value_type omega = unity_root<FieldType>(fft_size);
+
+    std::vector<value_type> coefficients(fft_size);
+    for (std::size_t i = 0; i < fft_size; ++i) {
+        coefficients[i] = nil::crypto3::algebra::random_element<FieldType>();
+    }
+    polynomial<value_type> poly(coefficients.begin(), coefficients.end());
+
+    std::vector<value_type> omega_powers;
+    nil::crypto3::math::detail::create_fft_cache<FieldType>(fft_size, omega, omega_powers);
+
+    // Block sizes from one stage per pass up to the whole transform in a single pass.
+    for (std::size_t block_log2 = 1; block_log2 <= 11; ++block_log2) {
+        std::vector<value_type> evaluations(coefficients);
+        nil::crypto3::math::detail::basic_radix2_fft_cached<FieldType>(evaluations, omega_powers, block_log2);
+
+        value_type point = value_type::one();
+        for (std::size_t i = 0; i < fft_size; i += 37, point *= omega.pow(37)) {
+            BOOST_CHECK_EQUAL(evaluations[i], poly.evaluate(point));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(blocked_fft_inverse_roundtrip) {
+    using value_type = FieldType::value_type;
+    // Large enough to be split into several passes by default.
+    const std::size_t fft_size = 1 << 14;
+
+    std::vector<value_type> data(fft_size);
+    for (std::size_t i = 0; i < fft_size; ++i) {
+        data[i] = nil::crypto3::algebra::random_element<FieldType>();
+    }
+    std::vector<value_type> transformed(data);
+
+    auto domain = make_evaluation_domain<FieldType>(fft_size);
+    domain->fft(transformed);
+    domain->inverse_fft(transformed);
+
+    BOOST_CHECK(transformed == data);
+}
+
+BOOST_AUTO_TEST_CASE(low_degree_extension_matches_zero_padded_fft) {
+    using value_type = FieldType::value_type;
+    const std::size_t small_size = 1 << 8;
+
+    std::vector<value_type> evaluations(small_size);
+    for (std::size_t i = 0; i < small_size; ++i) {
+        evaluations[i] = nil::crypto3::algebra::random_element<FieldType>();
+    }
+    auto small_domain = make_evaluation_domain<FieldType>(small_size);
+    const value_type shift = nil::crypto3::math::detail::coset_shift<FieldType>();
+
+    for (std::size_t k : {2, 4, 8}) {
+        auto extended_domain = make_evaluation_domain<FieldType>(small_size * k);
+        for (const value_type& coset : {value_type::one(), shift}) {
+            std::vector<value_type> expected(evaluations);
+            small_domain->inverse_fft(expected);
+            multiply_by_coset(expected, coset);
+            expected.resize(small_size * k, value_type::zero());
+            extended_domain->fft(expected);
+
+            std::vector<value_type> extended(evaluations);
+            small_domain->low_degree_extension(extended, *extended_domain, coset);
+
+            BOOST_CHECK(extended == expected);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(batched_fft_matches_single_column_fft) {
+    using value_type = FieldType::value_type;
+    const std::size_t fft_size = 1 << 10;
+    auto domain = make_evaluation_domain<FieldType>(fft_size);
+
+    // Fewer columns than a group, a partial last group, and enough columns to go column-parallel.
+    const std::size_t many_columns = 2 * nil::crypto3::ThreadPool::get_instance(
+        nil::crypto3::ThreadPool::PoolLevel::LOW).get_pool_size() + 1;
+    for (std::size_t columns_count : {std::size_t(1), std::size_t(3), std::size_t(6), many_columns}) {
+        std::vector<std::vector<value_type>> columns(columns_count, std::vector<value_type>(fft_size));
+        for (auto& column : columns) {
+            for (std::size_t i = 0; i < fft_size; ++i) {
+                column[i] = nil::crypto3::algebra::random_element<FieldType>();
+            }
+        }
+        std::vector<std::vector<value_type>> expected(columns);
+        std::vector<std::vector<value_type>*> column_pointers;
+        for (std::size_t c = 0; c < columns_count; ++c) {
+            domain->fft(expected[c]);
+            column_pointers.push_back(&columns[c]);
+        }
+
+        domain->fft_batch(column_pointers);
+        BOOST_CHECK(columns == expected);
+
+        for (std::size_t c = 0; c < columns_count; ++c) {
+            domain->inverse_fft(expected[c]);
+        }
+        domain->inverse_fft_batch(column_pointers);
+        BOOST_CHECK(columns == expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(batched_low_degree_extension_matches_single_column) {
+    using value_type = FieldType::value_type;
+    const std::size_t small_size = 1 << 8;
+    const std::size_t columns_count = 5;
+    auto small_domain = make_evaluation_domain<FieldType>(small_size);
+    auto extended_domain = make_evaluation_domain<FieldType>(small_size * 4);
+    const value_type shift = nil::crypto3::math::detail::coset_shift<FieldType>();
+
+    std::vector<std::vector<value_type>> columns(columns_count, std::vector<value_type>(small_size));
+    for (auto& column : columns) {
+        for (std::size_t i = 0; i < small_size; ++i) {
+            column[i] = nil::crypto3::algebra::random_element<FieldType>();
+        }
+    }
+    std::vector<std::vector<value_type>> expected(columns);
+    std::vector<std::vector<value_type>*> column_pointers;
+    for (std::size_t c = 0; c < columns_count; ++c) {
+        small_domain->low_degree_extension(expected[c], *extended_domain, shift);
+        column_pointers.push_back(&columns[c]);
+    }
+
+    small_domain->low_degree_extension_batch(column_pointers, *extended_domain, shift);
+    BOOST_CHECK(columns == expected);
+}
+
+// Run with CRYPTO3_THREAD_POOL_NUMA=1 on a multi-socket machine, otherwise both timings are the same.
+BOOST_AUTO_TEST_CASE(numa_first_touch_fft_benchmark, *boost::unit_test::disabled()) {
+    using value_type = FieldType::value_type;
+    const std::size_t fft_size = 1 << 20;
+    const std::size_t passes = 10;
+
+    std::cout << "NUMA mode: " << nil::crypto3::ThreadPool::get_instance(
+                     nil::crypto3::ThreadPool::PoolLevel::LOW).numa_enabled() << std::endl;
+
+    std::vector<value_type> test_data(fft_size);
+    for (std::size_t i = 0; i < fft_size; ++i) {
+        test_data[i] = nil::crypto3::algebra::random_element<FieldType>();
+    }
+    std::shared_ptr<std::vector<value_type>> omega_powers = std::make_shared<std::vector<value_type>>();
+    nil::crypto3::math::detail::create_fft_cache<FieldType>(fft_size, unity_root<FieldType>(fft_size), *omega_powers);
+
+    std::vector<value_type> plain_data(test_data.begin(), test_data.end());
+    std::vector<value_type, nil::crypto3::first_touch_allocator<value_type>> placed_data(
+        test_data.begin(), test_data.end());
+
+    std::chrono::time_point<std::chrono::high_resolution_clock> start_plain(std::chrono::high_resolution_clock::now());
+    for (std::size_t i = 0; i < passes; ++i) {
+        nil::crypto3::math::detail::basic_radix2_fft<FieldType>(
+            plain_data, unity_root<FieldType>(fft_size), omega_powers);
+    }
+    std::cout << "FFT, std::allocator: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::high_resolution_clock::now() - start_plain)
+                 .count()
+              << " ms" << std::endl;
+
+    std::chrono::time_point<std::chrono::high_resolution_clock> start_placed(std::chrono::high_resolution_clock::now());
+    for (std::size_t i = 0; i < passes; ++i) {
+        nil::crypto3::math::detail::basic_radix2_fft<FieldType>(
+            placed_data, unity_root<FieldType>(fft_size), omega_powers);
+    }
+    std::cout << "FFT, first_touch_allocator: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::high_resolution_clock::now() - start_placed)
+                 .count()
+              << " ms" << std::endl;
+
+    BOOST_CHECK(std::equal(plain_data.begin(), plain_data.end(), placed_data.begin()));
+}
+
 BOOST_AUTO_TEST_CASE(fft_vs_multiplication_benchmark) {
     using value_type = FieldType::value_type;
     const std::size_t fft_size = 1 << 16;
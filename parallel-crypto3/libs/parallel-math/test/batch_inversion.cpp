@@ -0,0 +1,89 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE batch_inversion_test
+
+#include <vector>
+#include <cstdint>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
+#include <nil/crypto3/math/algorithms/batch_inversion.hpp>
+
+#include <nil/crypto3/algebra/random_element.hpp>
+
+using namespace nil::crypto3::algebra;
+using namespace nil::crypto3::math;
+
+typedef fields::bls12_fr<381> FieldType;
+
+BOOST_AUTO_TEST_SUITE(batch_inversion_test_suite)
+
+BOOST_AUTO_TEST_CASE(batch_inversion_matches_single_inversions) {
+    using value_type = FieldType::value_type;
+
+    // Large enough to be split into several chunks by the thread pool.
+    for (std::size_t size : {0, 1, 7, (1 << 14) + 3}) {
+        std::vector<value_type> values(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            values[i] = random_element<FieldType>();
+        }
+        if (size > 3) {
+            values[0] = value_type::zero();
+            values[size / 2] = value_type::zero();
+        }
+
+        std::vector<value_type> inverses = values;
+        batch_inversion(inverses);
+
+        for (std::size_t i = 0; i < size; ++i) {
+            if (values[i].is_zero()) {
+                BOOST_CHECK(inverses[i].is_zero());
+            } else {
+                BOOST_CHECK(inverses[i] == values[i].inversed());
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(batch_inversion_of_subrange) {
+    using value_type = FieldType::value_type;
+
+    std::vector<value_type> values(100);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = random_element<FieldType>();
+    }
+
+    std::vector<value_type> inverses = values;
+    batch_inversion(inverses.begin() + 10, inverses.begin() + 90);
+
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (i < 10 || i >= 90) {
+            BOOST_CHECK(inverses[i] == values[i]);
+        } else {
+            BOOST_CHECK(inverses[i] * values[i] == value_type::one());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
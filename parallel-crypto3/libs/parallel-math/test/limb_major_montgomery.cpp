@@ -0,0 +1,129 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#define BOOST_TEST_MODULE limb_major_montgomery_test
+
+#include <vector>
+#include <cstdint>
+
+#include <boost/test/unit_test.hpp>
+
+#include <nil/crypto3/algebra/fields/arithmetic_params/bls12.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/pallas.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/goldilocks64.hpp>
+#include <nil/crypto3/math/detail/limb_major_montgomery.hpp>
+
+#include <nil/crypto3/algebra/random_element.hpp>
+
+using namespace nil::crypto3::algebra;
+using namespace nil::crypto3::math;
+
+constexpr std::size_t block_size = 64;
+
+// Every available vector backend against the field operations, on full and partial blocks.
+template<typename FieldType>
+void test_backends() {
+    using value_type = typename FieldType::value_type;
+    using limb_major_type = limb_major_montgomery<value_type, block_size>;
+
+    for (limb_major_backend backend :
+         {limb_major_backend::avx2, limb_major_backend::avx512, limb_major_backend::avx512_ifma}) {
+        if (!limb_major_type::is_available(backend)) {
+            BOOST_TEST_MESSAGE("backend " << static_cast<int>(backend) << " is not available");
+            continue;
+        }
+        const limb_major_type limb_major(backend);
+
+        for (std::size_t rows : {block_size, std::size_t(1), std::size_t(37)}) {
+            std::vector<value_type> a(rows), b(rows), result(rows);
+            for (std::size_t r = 0; r < rows; ++r) {
+                a[r] = random_element<FieldType>();
+                b[r] = random_element<FieldType>();
+            }
+            if (rows > 3) {
+                a[0] = value_type::zero();
+                b[1] = value_type::zero();
+                a[2] = b[2] = -value_type::one();
+                a[3] = value_type::one();
+            }
+
+            const std::size_t block_words = limb_major.words() * block_size;
+            std::vector<std::uint64_t> a_block(block_words), b_block(block_words), result_block(block_words);
+            limb_major.load(a.data(), 1, rows, a_block.data());
+            limb_major.load(b.data(), 1, rows, b_block.data());
+
+            limb_major.add(a_block.data(), b_block.data(), result_block.data());
+            limb_major.store(result_block.data(), rows, result.data());
+            for (std::size_t r = 0; r < rows; ++r) {
+                BOOST_CHECK(result[r] == a[r] + b[r]);
+            }
+
+            limb_major.sub(a_block.data(), b_block.data(), result_block.data());
+            limb_major.store(result_block.data(), rows, result.data());
+            for (std::size_t r = 0; r < rows; ++r) {
+                BOOST_CHECK(result[r] == a[r] - b[r]);
+            }
+
+            limb_major.mul(a_block.data(), b_block.data(), result_block.data());
+            limb_major.store(result_block.data(), rows, result.data());
+            for (std::size_t r = 0; r < rows; ++r) {
+                BOOST_CHECK(result[r] == a[r] * b[r]);
+            }
+
+            // A broadcast value, multiplied in place.
+            limb_major.load(&b[0], 0, rows, b_block.data());
+            limb_major.mul(a_block.data(), b_block.data(), a_block.data());
+            limb_major.store(a_block.data(), rows, result.data());
+            for (std::size_t r = 0; r < rows; ++r) {
+                BOOST_CHECK(result[r] == a[r] * b[0]);
+            }
+        }
+    }
+
+    BOOST_CHECK(limb_major_type::is_available(limb_major_type::best_backend()));
+}
+
+BOOST_AUTO_TEST_SUITE(limb_major_montgomery_test_suite)
+
+BOOST_AUTO_TEST_CASE(limb_major_montgomery_bls12_381_fr) {
+    test_backends<fields::bls12_fr<381>>();
+}
+
+BOOST_AUTO_TEST_CASE(limb_major_montgomery_bls12_381_fq) {
+    test_backends<fields::bls12_fq<381>>();
+}
+
+BOOST_AUTO_TEST_CASE(limb_major_montgomery_pallas) {
+    test_backends<fields::pallas_base_field>();
+}
+
+BOOST_AUTO_TEST_CASE(limb_major_montgomery_goldilocks64) {
+    test_backends<fields::goldilocks64>();
+}
+
+BOOST_AUTO_TEST_CASE(limb_major_montgomery_supported_types) {
+    BOOST_CHECK(is_limb_major_field_element<fields::pallas_base_field::value_type>::value);
+    BOOST_CHECK(!is_limb_major_field_element<fields::fp2<fields::bls12_fq<381>>::value_type>::value);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
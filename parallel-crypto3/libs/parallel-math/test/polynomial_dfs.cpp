@@ -1280,6 +1280,29 @@ BOOST_AUTO_TEST_CASE(polynomial_dfs_evaluate_after_resize_test) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(polynomial_dfs_barycentric_evaluate_test) {
+    using value_type = typename FieldType::value_type;
+
+    const std::size_t size = 1 << 13;
+    polynomial<value_type> coefficients(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        coefficients[i] = random_element<FieldType>();
+    }
+    polynomial_dfs<value_type> poly;
+    poly.from_coefficients(coefficients);
+
+    value_type point = random_element<FieldType>();
+    BOOST_CHECK(poly.evaluate(point) == coefficients.evaluate(point));
+
+    std::vector<value_type> lagrange_coefficients =
+        detail::basic_radix2_evaluate_all_lagrange_polynomials<FieldType>(size, point);
+    BOOST_CHECK(poly.evaluate_with_lagrange_coefficients(lagrange_coefficients) == coefficients.evaluate(point));
+
+    // Points of the domain hit the values directly.
+    value_type omega = unity_root<FieldType>(size);
+    BOOST_CHECK(poly.evaluate(omega.pow(5)) == poly[5]);
+}
+
 BOOST_AUTO_TEST_CASE(polynomial_dfs_evaluate_after_resize_and_shift_test) {
 
     polynomial_dfs<typename FieldType::value_type> small_poly = {
@@ -1332,6 +1355,25 @@ BOOST_AUTO_TEST_CASE(polynomial_dfs_zero_one_test) {
     BOOST_CHECK((small_poly - one * small_poly).is_zero());
 }
 
+BOOST_AUTO_TEST_CASE(polynomial_dfs_polynomials_coefficients_test) {
+    polynomial_dfs<typename FieldType::value_type> constant = {0, {0x15_big_uint255}};
+    polynomial_dfs<typename FieldType::value_type> small_poly = {
+        3, {0x21_big_uint255, 0x4_big_uint255, 0x7_big_uint255, 0x9_big_uint255}};
+    polynomial_dfs<typename FieldType::value_type> large_poly = {
+        7, 16, nil::crypto3::algebra::random_element<FieldType>()};
+    large_poly[3] = 0x5_big_uint255;
+
+    // Polynomials of a single value have no evaluation domain, and are grouped apart from the others.
+    std::vector<const polynomial_dfs<typename FieldType::value_type> *> polys = {
+        &small_poly, &constant, &large_poly, &small_poly};
+    auto coefficients = polynomials_coefficients<FieldType>(polys);
+
+    BOOST_CHECK_EQUAL(coefficients.size(), polys.size());
+    for (std::size_t i = 0; i < polys.size(); ++i) {
+        BOOST_CHECK(coefficients[i] == polynomial<typename FieldType::value_type>(polys[i]->coefficients()));
+    }
+}
+
 BOOST_AUTO_TEST_CASE(polynomial_dfs_2_levels_test) {
     size_t size = 131072;
 
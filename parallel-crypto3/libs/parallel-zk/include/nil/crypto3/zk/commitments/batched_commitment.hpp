@@ -34,12 +34,15 @@
 #include <vector>
 #include <utility>
 #include <map>
+#include <tuple>
+#include <unordered_map>
 
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
 #include <nil/crypto3/math/polynomial/polynomial_dfs.hpp>
 #include <nil/crypto3/math/polynomial/lagrange_interpolation.hpp>
+#include <nil/crypto3/math/type_traits.hpp>
 
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 #include <nil/crypto3/zk/commitments/type_traits.hpp>
@@ -213,6 +216,11 @@ namespace nil {
                     }
 
                     void eval_polys() {
+                        if constexpr (math::is_polynomial_dfs<polynomial_type>::value) {
+                            eval_polys_dfs();
+                            return;
+                        }
+
                         for(auto const &[k, poly] : _polys) {
                             _z.set_batch_size(k, poly.size());
                             auto const &point = _points.at(k);
@@ -225,7 +233,7 @@ namespace nil {
 
                             // Lambda in parallel_for can not capture structured bindings [k, poly], until C++20
                             auto k_capture = k;
-                            auto poly_capture = poly;
+                            const auto &poly_capture = poly;
 
                             // We use HIGH level thread pool here, because "evaluate" may use the lower level one.
                             parallel_for(0, poly.size(), [this, &point, k_capture, &poly_capture](std::size_t i) {
@@ -236,6 +244,43 @@ namespace nil {
                         }
                     }
 
+                    // Polynomials in DFS form are evaluated barycentrically. Evaluations are grouped by the
+                    // polynomial size and the point, so the Lagrange coefficients are computed once per group and
+                    // each evaluation is a single dot product. Only one group's coefficients are kept in memory.
+                    void eval_polys_dfs() {
+                        // (batch, polynomial, point) indices of the evaluations, grouped by polynomial size and point.
+                        typedef std::tuple<std::size_t, std::size_t, std::size_t> eval_index_type;
+                        std::map<std::size_t, std::unordered_map<value_type, std::vector<eval_index_type>>> groups;
+
+                        for (auto const &[k, poly] : _polys) {
+                            _z.set_batch_size(k, poly.size());
+                            auto const &point = _points.at(k);
+
+                            BOOST_ASSERT(poly.size() == point.size() || point.size() == 1);
+
+                            for (std::size_t i = 0; i < poly.size(); ++i) {
+                                _z.set_poly_points_number(k, i, point[i].size());
+                                for (std::size_t j = 0; j < point[i].size(); j++) {
+                                    groups[poly[i].size()][point[i][j]].emplace_back(k, i, j);
+                                }
+                            }
+                        }
+
+                        for (auto const &[size, points] : groups) {
+                            for (auto const &[point, indices] : points) {
+                                std::vector<value_type> lagrange_coefficients =
+                                    math::detail::basic_radix2_evaluate_all_lagrange_polynomials<field_type>(size, point);
+
+                                // We use HIGH level thread pool here, because the dot product uses the lower level one.
+                                parallel_for(0, indices.size(), [this, &indices, &lagrange_coefficients](std::size_t t) {
+                                    auto const &[k, i, j] = indices[t];
+                                    _z.set(k, i, j, _polys.at(k)[i].evaluate_with_lagrange_coefficients(
+                                        lagrange_coefficients));
+                                }, ThreadPool::PoolLevel::HIGH);
+                            }
+                        }
+                    }
+
                 public:
                     boost::property_tree::ptree get_params() const{
                         boost::property_tree::ptree root;
@@ -112,6 +112,7 @@ namespace nil {
 
                         using merkle_tree_type = containers::merkle_tree<MerkleTreeHashType, 2>;
                         using merkle_proof_type =  typename containers::merkle_proof<MerkleTreeHashType, 2>;
+                        using merkle_multiproof_type = typename containers::merkle_multiproof<MerkleTreeHashType, 2>;
                         using precommitment_type = merkle_tree_type;
                         using commitment_type = typename precommitment_type::value_type;
                         using transcript_type = transcript::fiat_shamir_heuristic_sequential<TranscriptHashType>;
@@ -159,10 +160,14 @@ namespace nil {
                                 std::size_t lambda,
                                 std::size_t expand_factor,
                                 bool use_grinding = false,
-                                std::size_t grinding_parameter = 16
+                                std::size_t grinding_parameter = 16,
+                                bool use_merkle_multiproofs = false,
+                                bool recompute_fri_rounds = false
                             ): lambda(lambda)
                               , use_grinding(use_grinding)
                               , grinding_parameter(grinding_parameter)
+                              , use_merkle_multiproofs(use_merkle_multiproofs)
+                              , recompute_fri_rounds(recompute_fri_rounds)
                               , max_degree((1 << degree_log) - 1)
                               , D(math::calculate_domain_set<FieldType>(degree_log + expand_factor, degree_log - 1))
                               , r(degree_log - 1)
@@ -176,10 +181,14 @@ namespace nil {
                                 std::size_t lambda,
                                 std::size_t expand_factor,
                                 bool use_grinding = false,
-                                std::size_t grinding_parameter = 16
+                                std::size_t grinding_parameter = 16,
+                                bool use_merkle_multiproofs = false,
+                                bool recompute_fri_rounds = false
                             ) : lambda(lambda)
                               , use_grinding(use_grinding)
                               , grinding_parameter(grinding_parameter)
+                              , use_merkle_multiproofs(use_merkle_multiproofs)
+                              , recompute_fri_rounds(recompute_fri_rounds)
                               , max_degree((1 << degree_log) - 1)
                               , D(math::calculate_domain_set<FieldType>(
                                     degree_log + expand_factor,
@@ -220,6 +229,15 @@ namespace nil {
                             const std::size_t lambda;
                             const bool use_grinding;
                             const std::size_t grinding_parameter;
+                            // Makes the prover put the Merkle paths of all the queries to a tree into one multiproof.
+                            // Only the prover looks at it, the verifier follows the proof, so it is not compared.
+                            // Not const, so that it can be set on the params of a commitment scheme read from a file.
+                            bool use_merkle_multiproofs;
+                            // Makes the prover keep only the tree of combined_Q after the commit phase. The query phase
+                            // folds the polynomials of the other rounds and builds their trees once more, one round at
+                            // a time. The proof is the same, it takes less memory and more time to produce.
+                            // Only the prover looks at it, so it is not compared.
+                            bool recompute_fri_rounds;
                             const std::size_t max_degree;
                             const std::vector<std::shared_ptr<math::evaluation_domain<FieldType>>> D;
 
@@ -337,7 +355,10 @@ namespace nil {
 //                                }
                                 return fri_roots == rhs.fri_roots &&
                                        query_proofs == rhs.query_proofs &&
-                                       final_polynomial == rhs.final_polynomial;
+                                       final_polynomial == rhs.final_polynomial &&
+                                       use_merkle_multiproofs == rhs.use_merkle_multiproofs &&
+                                       initial_multiproofs == rhs.initial_multiproofs &&
+                                       round_multiproofs == rhs.round_multiproofs;
                             }
 
                             bool operator!=(const proof_type &rhs) const {
@@ -348,6 +369,13 @@ namespace nil {
                             math::polynomial<typename field_type::value_type>   final_polynomial;
                             std::vector<query_proof_type>                       query_proofs;     // 0...lambda - 1
                             typename GrindingType::output_type                  proof_of_work;
+
+                            // If set, the p of every initial and round proof is empty, and the leaves the queries open
+                            // in the initial tree k and in the tree of round i are checked by initial_multiproofs[k]
+                            // and round_multiproofs[i].
+                            bool                                                use_merkle_multiproofs = false;
+                            std::map<std::size_t, merkle_multiproof_type>       initial_multiproofs;
+                            std::vector<merkle_multiproof_type>                 round_multiproofs;  // 0,..step_list.size()
                         };
                     };
                 }    // namespace detail
@@ -404,6 +432,35 @@ namespace nil {
                     return (x_index + domain_size / FRI::m) % domain_size;
                 }
 
+                /*!
+                 * @brief Offsets of the coset elements from x_index, in the order they go into a leaf.
+                 *
+                 * The element indices of the coset of x_index are (x_index + offset) % domain_size, so the pattern
+                 * depends only on domain_size and fri_step and is shared by all the leaves and polynomials.
+                 */
+                template<typename FRI>
+                static inline std::vector<std::size_t> get_coset_offsets(const std::size_t domain_size,
+                                                                         const std::size_t fri_step) {
+                    const std::size_t coset_size = 1 << fri_step;
+                    std::vector<std::size_t> offsets(coset_size);
+                    offsets[0] = 0;
+                    offsets[1] = get_paired_index<FRI>(0, domain_size);
+
+                    std::size_t base_index = domain_size / (FRI::m * FRI::m);
+                    std::size_t prev_half_size = 1;
+                    std::size_t i = 1;
+                    while (i < coset_size / FRI::m) {
+                        for (std::size_t j = 0; j < prev_half_size; j++) {
+                            offsets[FRI::m * i] = (base_index + offsets[FRI::m * j]) % domain_size;
+                            offsets[FRI::m * i + 1] = get_paired_index<FRI>(offsets[FRI::m * i], domain_size);
+                            i++;
+                        }
+                        base_index /= FRI::m;
+                        prev_half_size <<= 1;
+                    }
+                    return offsets;
+                }
+
                 template<typename FRI,
                     typename std::enable_if<
                         std::is_base_of<
@@ -431,32 +488,18 @@ namespace nil {
                         detail::fri_field_element_consumer<FRI>(coset_size)
                     );
 
-                    for (std::size_t x_index = 0; x_index < leafs_number; x_index++) {
-                        std::vector<std::array<std::size_t, FRI::m>> s_indices(coset_size / FRI::m);
-                        s_indices[0][0] = x_index;
-                        s_indices[0][1] = get_paired_index<FRI>(x_index, domain_size);
-
-                        auto& element_consumer = y_data[x_index].reset_cursor();
-                        element_consumer.consume(f[s_indices[0][0]]);
-                        element_consumer.consume(f[s_indices[0][1]]);
+                    const std::vector<std::size_t> offsets = get_coset_offsets<FRI>(domain_size, fri_step);
 
-                        std::size_t base_index = domain_size / (FRI::m * FRI::m);
-                        std::size_t prev_half_size = 1;
-                        std::size_t i = 1;
-                        while (i < coset_size / FRI::m) {
-                            for (std::size_t j = 0; j < prev_half_size; j++) {
-                                s_indices[i][0] = (base_index + s_indices[j][0]) % domain_size;
-                                s_indices[i][1] = get_paired_index<FRI>(s_indices[i][0], domain_size);
-
-                                element_consumer.consume(f[s_indices[i][0]]);
-                                element_consumer.consume(f[s_indices[i][1]]);
-
-                                i++;
+                    wait_for_all(parallel_run_in_chunks<void>(
+                        leafs_number,
+                        [&y_data, &f, &offsets, domain_size](std::size_t begin, std::size_t end) {
+                            for (std::size_t x_index = begin; x_index < end; x_index++) {
+                                auto& element_consumer = y_data[x_index].reset_cursor();
+                                for (std::size_t offset : offsets) {
+                                    element_consumer.consume(f[(x_index + offset) % domain_size]);
+                                }
                             }
-                            base_index /= FRI::m;
-                            prev_half_size <<= 1;
-                        }
-                    }
+                    }, ThreadPool::PoolLevel::LOW));
 
                     return containers::make_merkle_tree<typename FRI::merkle_tree_hash_type, FRI::m>(y_data.begin(),
                                                                                                      y_data.end());
@@ -506,12 +549,11 @@ namespace nil {
                 ) {
                     PROFILE_SCOPE("Basic FRI Precommit time");
 
-                    // Resize uses low level thread pool, so we need to use the high level one here.
-                    parallel_for(0, poly.size(), [&poly, &D](std::size_t i) {
-                        if (poly[i].size() != D->size()) {
-                            poly[i].resize(D->size(), nullptr, D);
-                        }
-                    }, ThreadPool::PoolLevel::HIGH);
+                    std::vector<math::polynomial_dfs<typename FRI::field_type::value_type> *> columns;
+                    for (auto &p : poly) {
+                        columns.push_back(&p);
+                    }
+                    math::resize_polynomials<typename FRI::field_type>(columns, D->size(), D);
 
                     std::size_t domain_size = D->size();
                     std::size_t list_size = poly.size();
@@ -522,33 +564,26 @@ namespace nil {
                         detail::fri_field_element_consumer<FRI>(coset_size * list_size)
                     );
 
-                    parallel_for(0, leafs_number, [&y_data, &poly, domain_size, coset_size, list_size](std::size_t x_index) {
-                        auto& element_consumer = y_data[x_index].reset_cursor();
-                        for (std::size_t polynom_index = 0; polynom_index < list_size; polynom_index++) {
-                            std::vector<std::array<std::size_t, FRI::m>> s_indices(coset_size / FRI::m);
-                            s_indices[0][0] = x_index;
-                            s_indices[0][1] = get_paired_index<FRI>(x_index, domain_size);
-
-                            element_consumer.consume(poly[polynom_index][s_indices[0][0]]);
-                            element_consumer.consume(poly[polynom_index][s_indices[0][1]]);
-
-                            std::size_t base_index = domain_size / (FRI::m * FRI::m);
-                            std::size_t prev_half_size = 1;
-                            std::size_t i = 1;
-                            while (i < coset_size / FRI::m) {
-                                for (std::size_t j = 0; j < prev_half_size; j++) {
-                                    s_indices[i][0] = (base_index + s_indices[j][0]) % domain_size;
-                                    s_indices[i][1] = get_paired_index<FRI>(s_indices[i][0], domain_size);
-                                    element_consumer.consume(poly[polynom_index][s_indices[i][0]]);
-                                    element_consumer.consume(poly[polynom_index][s_indices[i][1]]);
-
-                                    i++;
+                    const std::vector<std::size_t> offsets = get_coset_offsets<FRI>(domain_size, fri_step);
+
+                    wait_for_all(parallel_run_in_chunks<void>(
+                        leafs_number,
+                        [&y_data, &poly, &offsets, domain_size, list_size](std::size_t begin, std::size_t end) {
+                            // Indices of the current coset, shared by all the polynomials.
+                            std::vector<std::size_t> s_indices(offsets.size());
+                            for (std::size_t x_index = begin; x_index < end; x_index++) {
+                                for (std::size_t i = 0; i < offsets.size(); i++) {
+                                    s_indices[i] = (x_index + offsets[i]) % domain_size;
+                                }
+                                auto& element_consumer = y_data[x_index].reset_cursor();
+                                for (std::size_t polynom_index = 0; polynom_index < list_size; polynom_index++) {
+                                    const auto &polynom = poly[polynom_index];
+                                    for (std::size_t index : s_indices) {
+                                        element_consumer.consume(polynom[index]);
+                                    }
                                 }
-                                base_index /= FRI::m;
-                                prev_half_size <<= 1;
                             }
-                        }
-                    });
+                    }, ThreadPool::PoolLevel::LOW));
 
                     return containers::make_merkle_tree<typename FRI::merkle_tree_hash_type, FRI::m>(y_data.begin(),
                                                                                                      y_data.end());
@@ -600,6 +635,64 @@ namespace nil {
                     return x_index;
                 }
 
+                /// Index of the leaf that holds the coset of x_index, the one make_proof_specialized opens.
+                template<typename FRI>
+                static inline std::size_t get_leaf_index(const std::size_t x_index, const std::size_t domain_size,
+                                                         const std::size_t fri_step) {
+                    std::size_t folded_index = get_folded_index<FRI>(x_index, domain_size, fri_step);
+                    return std::min(folded_index, get_paired_index<FRI>(folded_index, domain_size));
+                }
+
+                /*!
+                 * @brief Finds x_index with D->get_domain_element(x_index) == x for x in the subgroup of D.
+                 *
+                 * D has 2^k elements, so the bits of x_index are found one by one from the lowest: once the lower
+                 * bits are divided out, raising x to the power 2^(k - 1 - j) gives 1 or -1 depending on bit j.
+                 * That is k^2 / 2 squarings, instead of up to 2^k multiplications of a linear search.
+                 */
+                template<typename FRI>
+                static inline std::uint64_t get_domain_element_index(
+                        const typename FRI::field_type::value_type &x,
+                        const std::shared_ptr<math::evaluation_domain<typename FRI::field_type>> &D) {
+                    std::size_t log_size = 0;
+                    while ((std::size_t(1) << log_size) < D->size()) {
+                        log_size++;
+                    }
+                    BOOST_ASSERT((std::size_t(1) << log_size) == D->size());
+
+                    typename FRI::field_type::value_type omega_inv = D->get_domain_element(1).inversed();
+                    typename FRI::field_type::value_type y = x;
+                    std::uint64_t x_index = 0;
+                    for (std::size_t j = 0; j < log_size; j++) {
+                        typename FRI::field_type::value_type sign = y;
+                        for (std::size_t i = j + 1; i < log_size; i++) {
+                            sign = sign.squared();
+                        }
+                        if (sign != FRI::field_type::value_type::one()) {
+                            x_index |= std::uint64_t(1) << j;
+                            y *= omega_inv;
+                        }
+                        omega_inv = omega_inv.squared();
+                    }
+                    BOOST_ASSERT(D->get_domain_element(x_index) == x);
+                    return x_index;
+                }
+
+                /// Indices in D[0] of the points queried by the challenges.
+                template<typename FRI>
+                static inline std::vector<std::uint64_t> get_query_indices(
+                        const typename FRI::params_type &fri_params,
+                        const std::vector<typename FRI::field_type::value_type> &challenges) {
+                    std::vector<std::uint64_t> x_indices(fri_params.lambda);
+                    const std::size_t domain_size = fri_params.D[0]->size();
+                    for (std::size_t query_id = 0; query_id < fri_params.lambda; query_id++) {
+                        typename FRI::field_type::value_type x = challenges[query_id];
+                        x = x.pow((FRI::field_type::modulus - 1) / domain_size);
+                        x_indices[query_id] = get_domain_element_index<FRI>(x, fri_params.D[0]);
+                    }
+                    return x_indices;
+                }
+
                 template<typename FRI>
                 static inline bool check_step_list(const typename FRI::params_type &fri_params) {
                     if (fri_params.step_list.empty()) {
@@ -721,6 +814,44 @@ namespace nil {
                     return correct_order_idx;
                 }
 
+                /// Folds round_f, the polynomial committed in round i, by the challenges of the round. t is the number of
+                /// folds in the preceding rounds, alphas points to the challenge of fold t.
+                template<typename FRI, typename PolynomialType>
+                static PolynomialType fold_round(
+                    const PolynomialType &round_f,
+                    const typename FRI::field_type::value_type *alphas,
+                    std::size_t i,
+                    std::size_t t,
+                    const typename FRI::params_type &fri_params)
+                {
+                    PolynomialType f;
+                    for (std::size_t step_i = 0; step_i < fri_params.step_list[i]; ++step_i, ++t) {
+                        // Calculate next f. Only the first fold of a round reads the committed polynomial, the
+                        // rest replace f, so the intermediate polynomials are freed as soon as they are folded.
+                        const PolynomialType &folded = (step_i == 0 ? round_f : f);
+                        if constexpr (std::is_same<math::polynomial_dfs<typename FRI::field_type::value_type>,
+                                PolynomialType>::value) {
+                            f = commitments::detail::fold_polynomial<typename FRI::field_type>(folded, alphas[step_i],
+                                                                                               fri_params.D[t]);
+                        } else {
+                            f = commitments::detail::fold_polynomial<typename FRI::field_type>(folded, alphas[step_i]);
+                        }
+                    }
+                    if (i != fri_params.step_list.size() - 1) {
+                        if constexpr (std::is_same<math::polynomial_dfs<typename FRI::field_type::value_type>,
+                                PolynomialType>::value) {
+                            const auto& D = fri_params.D[t];
+                            if (f.size() != D->size()) {
+                                f.resize(D->size(), nullptr, D);
+                            }
+                        }
+                    }
+                    return f;
+                }
+
+                /// Returns the polynomials and the trees the query phase reads, and the roots and the final polynomial.
+                /// When fri_params.recompute_fri_rounds is set, only the tree of combined_Q is kept. The challenges of
+                /// all the folds are written to alphas, if given, the query phase needs them to recompute the rounds.
                 template<typename FRI, typename PolynomialType>
                 static std::tuple<
                     std::vector<PolynomialType>,
@@ -729,54 +860,61 @@ namespace nil {
                 >
                 commit_phase(
                     const PolynomialType& combined_Q,
-                    const typename FRI::precommitment_type &combined_Q_precommitment,
+                    typename FRI::precommitment_type combined_Q_precommitment,
                     const typename FRI::params_type &fri_params,
-                    typename FRI::transcript_type &transcript)
+                    typename FRI::transcript_type &transcript,
+                    std::vector<typename FRI::field_type::value_type> *alphas = nullptr)
                 {
                     PROFILE_SCOPE("Basic FRI commit phase");
+                    // Only what the query phase reads is kept: the tree of every round, and fs[i], the polynomial
+                    // committed in round i + 1. The round 0 polynomial is combined_Q, which belongs to the caller,
+                    // and the final polynomial goes to the proof in the coefficients form.
                     std::vector<PolynomialType> fs;
                     std::vector<typename FRI::precommitment_type> fri_trees;
                     typename FRI::commitments_part_of_proof commitments_proof;
+                    std::vector<typename FRI::field_type::value_type> round_alphas;
+
+                    if (!fri_params.recompute_fri_rounds) {
+                        fs.reserve(fri_params.step_list.size() - 1);
+                        fri_trees.reserve(fri_params.step_list.size());
+                    }
+                    fri_trees.emplace_back(std::move(combined_Q_precommitment));
 
-                    auto f = combined_Q;
-                    auto precommitment = combined_Q_precommitment;
+                    PolynomialType f;
                     std::size_t t = 0;
 
                     for (std::size_t i = 0; i < fri_params.step_list.size(); i++) {
-                        fs.push_back(f);
-                        fri_trees.push_back(precommitment);
-                        commitments_proof.fri_roots.push_back(commit<FRI>(precommitment));
-                        transcript(commit<FRI>(precommitment));
-                        for (std::size_t step_i = 0; step_i < fri_params.step_list[i]; ++step_i, ++t) {
-                            typename FRI::field_type::value_type alpha = transcript.template challenge<typename FRI::field_type>();
-                            // Calculate next f
-                            if constexpr (std::is_same<math::polynomial_dfs<typename FRI::field_type::value_type>,
-                                    PolynomialType>::value) {
-                                f = commitments::detail::fold_polynomial<typename FRI::field_type>(f, alpha,
-                                                                                                   fri_params.D[t]);
-                            } else {
-                                f = commitments::detail::fold_polynomial<typename FRI::field_type>(f, alpha);
-                            }
+                        commitments_proof.fri_roots.push_back(commit<FRI>(fri_trees.back()));
+                        transcript(commit<FRI>(fri_trees.back()));
+                        if (fri_params.recompute_fri_rounds && i != 0) {
+                            fri_trees.pop_back();
+                        }
+
+                        for (std::size_t step_i = 0; step_i < fri_params.step_list[i]; ++step_i) {
+                            round_alphas.push_back(transcript.template challenge<typename FRI::field_type>());
                         }
+                        const PolynomialType &round_f =
+                            (i == 0 ? combined_Q : (fri_params.recompute_fri_rounds ? f : fs.back()));
+                        f = fold_round<FRI, PolynomialType>(round_f, &round_alphas[t], i, t, fri_params);
+                        t += fri_params.step_list[i];
+
                         if (i != fri_params.step_list.size() - 1) {
-                            const auto& D = fri_params.D[t];
-                            if constexpr (std::is_same<math::polynomial_dfs<typename FRI::field_type::value_type>,
-                                    PolynomialType>::value) {
-                                if (f.size() != D->size()) {
-                                    f.resize(D->size(), nullptr, D);
-                                }
+                            fri_trees.emplace_back(precommit<FRI>(f, fri_params.D[t], fri_params.step_list[i + 1]));
+                            if (!fri_params.recompute_fri_rounds) {
+                                fs.emplace_back(std::move(f));
                             }
-                            precommitment = precommit<FRI>(f, D, fri_params.step_list[i + 1]);
                         }
                     }
-                    fs.push_back(f);
+                    if (alphas != nullptr) {
+                        *alphas = std::move(round_alphas);
+                    }
                     if constexpr (std::is_same<math::polynomial_dfs<typename FRI::field_type::value_type>, PolynomialType>::value) {
                         commitments_proof.final_polynomial = math::polynomial<typename FRI::field_type::value_type>(f.coefficients());
                     } else {
-                        commitments_proof.final_polynomial = f;
+                        commitments_proof.final_polynomial = std::move(f);
                     }
 
-                    return std::make_tuple(fs, fri_trees, commitments_proof);
+                    return std::make_tuple(std::move(fs), std::move(fri_trees), std::move(commitments_proof));
                 }
 
                 /** @brief Convert a set of polynomials from DFS form into coefficients form, parallel version */
@@ -797,10 +935,7 @@ namespace nil {
                         math::polynomial_dfs<typename FRI::field_type::value_type>,
                         PolynomialType>::value
                     ) {
-                        std::unordered_map<std::size_t,
-                                           std::shared_ptr<math::evaluation_domain<typename FRI::field_type>>> d_cache;
-
-                        std::vector<std::size_t> required_domains;
+                        std::vector<const PolynomialType *> polys;
                         std::vector<std::pair<std::size_t, std::size_t>> key_index_pairs;
 
                         for (const auto &[key, poly_vector]: g) {
@@ -809,26 +944,18 @@ namespace nil {
                             for (std::size_t poly_index = 0; poly_index < poly_vector.size(); ++poly_index) {
                                 const auto& poly = poly_vector[poly_index];
                                 if (poly.size() != fri_params.D[0]->size()) {
-                                    if (d_cache.find(poly.size()) == d_cache.end()) {
-                                        required_domains.push_back(poly.size());
-                                        d_cache[poly.size()] = nullptr;
-                                    }
+                                    polys.push_back(&poly);
                                     key_index_pairs.push_back({key, poly_index});
                                 }
                             }
                         }
 
-                        parallel_for(0, required_domains.size(),
-                            [&required_domains, &d_cache](std::size_t i) {
-                            d_cache[required_domains[i]] = math::make_evaluation_domain<typename FRI::field_type>(required_domains[i]);
-                        }, ThreadPool::PoolLevel::HIGH);
-
-                        parallel_for(0, key_index_pairs.size(),
-                            [&d_cache, &g_coeffs, &key_index_pairs, &g](std::size_t pair_index) {
+                        // Polynomials of equal size are converted together, see math::polynomials_coefficients.
+                        auto coeffs = math::polynomials_coefficients<typename FRI::field_type>(polys);
+                        for (std::size_t pair_index = 0; pair_index < key_index_pairs.size(); ++pair_index) {
                             auto [key, index] = key_index_pairs[pair_index];
-                            const auto& poly = g.at(key)[index];
-                            g_coeffs[key][index] = poly.coefficients(d_cache[poly.size()]);
-                        }, ThreadPool::PoolLevel::HIGH);
+                            g_coeffs[key][index] = std::move(coeffs[pair_index]);
+                        }
                     }
 
                     return std::move(g_coeffs);
@@ -922,6 +1049,77 @@ namespace nil {
                     return std::move(initial_proof);
                 }
 
+                /// Proof of round i for the query x_index. t is the number of folds in the preceding rounds, next_f is
+                /// the polynomial committed in round i + 1, unused in the last round.
+                template<typename FRI, typename PolynomialType>
+                static typename FRI::round_proof_type
+                build_round_proof(
+                    const typename FRI::params_type &fri_params,
+                    std::size_t i,
+                    std::size_t t,
+                    const typename FRI::precommitment_type &tree,
+                    const PolynomialType *next_f,
+                    const math::polynomial<typename FRI::field_type::value_type> &final_polynomial,
+                    std::uint64_t x_index)
+                {
+                    typename FRI::round_proof_type round_proof;
+
+                    std::size_t domain_size = fri_params.D[t]->size();
+                    x_index %= domain_size;
+
+                    round_proof.p = make_proof_specialized<FRI>(
+                            get_folded_index<FRI>(x_index, domain_size, fri_params.step_list[i]),
+                            domain_size, tree);
+
+                    t += fri_params.step_list[i];
+                    if (i < fri_params.step_list.size() - 1) {
+                        x_index %= fri_params.D[t]->size();
+
+                        std::vector<std::array<typename FRI::field_type::value_type, FRI::m>> s;
+                        std::vector<std::array<std::size_t, FRI::m>> s_indices;
+                        std::tie(s, s_indices) = calculate_s<FRI>(x_index, fri_params.step_list[i + 1], fri_params.D[t]);
+
+                        std::size_t coset_size = 1 << fri_params.step_list[i + 1];
+                        BOOST_ASSERT(coset_size / FRI::m == s.size());
+                        BOOST_ASSERT(coset_size / FRI::m == s_indices.size());
+
+                        round_proof.y.resize(coset_size / FRI::m);
+                        for (std::size_t j = 0; j < coset_size / FRI::m; j++) {
+                            if constexpr (std::is_same<math::polynomial_dfs<typename FRI::field_type::value_type>,
+                                    PolynomialType>::value) {
+                                std::size_t ind0 = std::min(s_indices[j][0], s_indices[j][1]);
+                                std::size_t ind1 = std::max(s_indices[j][0], s_indices[j][1]);
+                                round_proof.y[j][0] = (*next_f)[ind0];
+                                round_proof.y[j][1] = (*next_f)[ind1];
+                            } else {
+                                typename FRI::field_type::value_type s0 = (s_indices[j][0] < s_indices[j][1] ? s[j][0] : s[j][1]);
+                                typename FRI::field_type::value_type s1 = (s_indices[j][0] > s_indices[j][1] ? s[j][0] : s[j][1]);
+                                round_proof.y[j][0] = next_f->evaluate(s0);
+                                round_proof.y[j][1] = next_f->evaluate(s1);
+                            }
+                        }
+                    } else {
+                        x_index %= fri_params.D[t - 1]->size();
+
+                        typename FRI::field_type::value_type
+                            x = fri_params.D[t - 1]->get_domain_element(x_index);
+                        x *= x;
+
+                        // Last step
+                        // Assume that FRI rounds continues with step == 1
+                        // x_index % (domain_size / 2) -- index in the next round
+                        // fri_params.D[t-1]->size()/4 -- half of the next domain size
+                        // Then next round values will be written in the straight order if next round index < next domain size - 1
+                        // Otherwise, they will be written in the reverse order.
+
+                        std::size_t ind = (x_index %(fri_params.D[t-1]->size()/2) < fri_params.D[t-1]->size()/4)? 0: 1;
+                        round_proof.y.resize(1);
+                        round_proof.y[0][ind] = final_polynomial.evaluate(x);
+                        round_proof.y[0][1-ind] = final_polynomial.evaluate(-x);
+                    }
+                    return round_proof;
+                }
+
                 template<typename FRI, typename PolynomialType>
                 static std::vector<typename FRI::round_proof_type>
                 build_round_proofs(
@@ -931,65 +1129,14 @@ namespace nil {
                     const math::polynomial<typename FRI::field_type::value_type> &final_polynomial,
                     std::uint64_t x_index)
                 {
-                    std::size_t domain_size = fri_params.D[0]->size();
                     std::size_t t = 0;
                     std::vector<typename FRI::round_proof_type> round_proofs(fri_params.step_list.size());
 
                     for (std::size_t i = 0; i < fri_params.step_list.size(); i++) {
-
-                        domain_size = fri_params.D[t]->size();
-                        x_index %= domain_size;
-
-                        round_proofs[i].p = make_proof_specialized<FRI>(
-                                get_folded_index<FRI>(x_index, domain_size, fri_params.step_list[i]),
-                                domain_size, fri_trees[i]);
-
+                        round_proofs[i] = build_round_proof<FRI, PolynomialType>(
+                            fri_params, i, t, fri_trees[i], (i < fs.size() ? &fs[i] : nullptr),
+                            final_polynomial, x_index);
                         t += fri_params.step_list[i];
-                        if (i < fri_params.step_list.size() - 1) {
-                            x_index %= fri_params.D[t]->size();
-
-                            std::vector<std::array<typename FRI::field_type::value_type, FRI::m>> s;
-                            std::vector<std::array<std::size_t, FRI::m>> s_indices;
-                            std::tie(s, s_indices) = calculate_s<FRI>(x_index, fri_params.step_list[i + 1], fri_params.D[t]);
-
-                            std::size_t coset_size = 1 << fri_params.step_list[i + 1];
-                            BOOST_ASSERT(coset_size / FRI::m == s.size());
-                            BOOST_ASSERT(coset_size / FRI::m == s_indices.size());
-
-                            round_proofs[i].y.resize(coset_size / FRI::m);
-                            for (std::size_t j = 0; j < coset_size / FRI::m; j++) {
-                                if constexpr (std::is_same<math::polynomial_dfs<typename FRI::field_type::value_type>,
-                                        PolynomialType>::value) {
-                                    std::size_t ind0 = std::min(s_indices[j][0], s_indices[j][1]);
-                                    std::size_t ind1 = std::max(s_indices[j][0], s_indices[j][1]);
-                                    round_proofs[i].y[j][0] = fs[i + 1][ind0];
-                                    round_proofs[i].y[j][1] = fs[i + 1][ind1];
-                                } else {
-                                    typename FRI::field_type::value_type s0 = (s_indices[j][0] < s_indices[j][1] ? s[j][0] : s[j][1]);
-                                    typename FRI::field_type::value_type s1 = (s_indices[j][0] > s_indices[j][1] ? s[j][0] : s[j][1]);
-                                    round_proofs[i].y[j][0] = fs[i + 1].evaluate(s0);
-                                    round_proofs[i].y[j][1] = fs[i + 1].evaluate(s1);
-                                }
-                            }
-                        } else {
-                            x_index %= fri_params.D[t - 1]->size();
-
-                            typename FRI::field_type::value_type
-                                x = fri_params.D[t - 1]->get_domain_element(x_index);
-                            x *= x;
-
-                            // Last step
-                            // Assume that FRI rounds continues with step == 1
-                            // x_index % (domain_size / 2) -- index in the next round
-                            // fri_params.D[t-1]->size()/4 -- half of the next domain size
-                            // Then next round values will be written in the straight order if next round index < next domain size - 1
-                            // Otherwise, they will be written in the reverse order.
-
-                            std::size_t ind = (x_index %(fri_params.D[t-1]->size()/2) < fri_params.D[t-1]->size()/4)? 0: 1;
-                            round_proofs[i].y.resize(1);
-                            round_proofs[i].y[0][ind] = final_polynomial.evaluate(x);
-                            round_proofs[i].y[0][1-ind] = final_polynomial.evaluate(-x);
-                        }
                     }
                     return std::move(round_proofs);
                 }
@@ -1004,28 +1151,70 @@ namespace nil {
                     const std::vector<typename FRI::field_type::value_type>& challenges)
                 {
                     typename FRI::round_proofs_batch_type proof;
+                    std::vector<std::uint64_t> x_indices = get_query_indices<FRI>(fri_params, challenges);
 
                     for (std::size_t query_id = 0; query_id < fri_params.lambda; query_id++) {
-                        std::size_t domain_size = fri_params.D[0]->size();
-                        typename FRI::field_type::value_type x = challenges[query_id];
-                        x = x.pow((FRI::field_type::modulus - 1) / domain_size);
-
-                        std::uint64_t x_index = 0;
-
-                        while (fri_params.D[0]->get_domain_element(x_index) != x) {
-                            ++x_index;
-                        }
-
                         // Fill round proofs
                         std::vector<typename FRI::round_proof_type> round_proofs =
                             build_round_proofs<FRI, PolynomialType>(
-                                fri_params, fri_trees, fs, final_polynomial, x_index);
+                                fri_params, fri_trees, fs, final_polynomial, x_indices[query_id]);
 
                         proof.round_proofs.emplace_back(std::move(round_proofs));
                     }
                     return proof;
                 }
 
+                /** @brief Round proofs for the commit phase run with fri_params.recompute_fri_rounds. The polynomials and
+                 *  the trees of the rounds are computed again from combined_Q and the challenges of the folds, and freed
+                 *  as soon as the proofs of the next round are built. The multiproofs of the round trees are made here
+                 *  when round_multiproofs is given, since the trees are gone afterwards.
+                 */
+                template<typename FRI, typename PolynomialType>
+                static typename FRI::round_proofs_batch_type query_phase_recomputed_round_proofs(
+                    const typename FRI::params_type &fri_params,
+                    const typename FRI::precommitment_type &combined_Q_precommitment,
+                    const PolynomialType &combined_Q,
+                    const std::vector<typename FRI::field_type::value_type> &alphas,
+                    const math::polynomial<typename FRI::field_type::value_type> &final_polynomial,
+                    const std::vector<typename FRI::field_type::value_type>& challenges,
+                    std::vector<typename FRI::merkle_multiproof_type> *round_multiproofs = nullptr)
+                {
+                    typename FRI::round_proofs_batch_type proof;
+                    std::vector<std::uint64_t> x_indices = get_query_indices<FRI>(fri_params, challenges);
+                    proof.round_proofs.resize(fri_params.lambda,
+                                              std::vector<typename FRI::round_proof_type>(fri_params.step_list.size()));
+
+                    PolynomialType f;
+                    typename FRI::precommitment_type tree;
+                    std::size_t t = 0;
+                    for (std::size_t i = 0; i < fri_params.step_list.size(); i++) {
+                        const PolynomialType &round_f = (i == 0 ? combined_Q : f);
+                        const typename FRI::precommitment_type &round_tree = (i == 0 ? combined_Q_precommitment : tree);
+
+                        PolynomialType next_f;
+                        if (i < fri_params.step_list.size() - 1) {
+                            next_f = fold_round<FRI, PolynomialType>(round_f, &alphas[t], i, t, fri_params);
+                        }
+
+                        std::vector<std::size_t> leaf_indices(fri_params.lambda);
+                        for (std::size_t query_id = 0; query_id < fri_params.lambda; query_id++) {
+                            proof.round_proofs[query_id][i] = build_round_proof<FRI, PolynomialType>(
+                                fri_params, i, t, round_tree, &next_f, final_polynomial, x_indices[query_id]);
+                            leaf_indices[query_id] = proof.round_proofs[query_id][i].p.leaf_index();
+                        }
+                        if (round_multiproofs != nullptr) {
+                            round_multiproofs->emplace_back(round_tree, leaf_indices);
+                        }
+
+                        t += fri_params.step_list[i];
+                        if (i < fri_params.step_list.size() - 1) {
+                            tree = precommit<FRI>(next_f, fri_params.D[t], fri_params.step_list[i + 1]);
+                            f = std::move(next_f);
+                        }
+                    }
+                    return proof;
+                }
+
                 template<typename FRI, typename PolynomialType>
                 static typename FRI::initial_proofs_batch_type query_phase_initial_proofs(
                     const std::map<std::size_t, typename FRI::precommitment_type> &precommitments,
@@ -1043,23 +1232,15 @@ namespace nil {
                     std::map<std::size_t, std::vector<math::polynomial<typename FRI::field_type::value_type>>> g_coeffs =
                         convert_polynomials_to_coefficients<FRI, PolynomialType>(fri_params, g);
 
-                    parallel_for(0, fri_params.lambda,
-                        [&proof, &fri_params, &precommitments, &g_coeffs, &g, &challenges](std::size_t query_id) {
-
-                        std::size_t domain_size = fri_params.D[0]->size();
-                        typename FRI::field_type::value_type x = challenges[query_id];
-                        x = x.pow((FRI::field_type::modulus - 1) / domain_size);
-
-                        std::uint64_t x_index = 0;
+                    std::vector<std::uint64_t> x_indices = get_query_indices<FRI>(fri_params, challenges);
 
-                        while (fri_params.D[0]->get_domain_element(x_index) != x) {
-                            ++x_index;
-                        }
+                    parallel_for(0, fri_params.lambda,
+                        [&proof, &fri_params, &precommitments, &g_coeffs, &g, &x_indices](std::size_t query_id) {
 
                         std::map<std::size_t, typename FRI::initial_proof_type>
                             initial_proof = build_initial_proof<FRI, PolynomialType>(
                                     precommitments,
-                                    fri_params, g, g_coeffs, x_index);
+                                    fri_params, g, g_coeffs, x_indices[query_id]);
                         proof.initial_proofs[query_id] = std::move(initial_proof);
                     }, ThreadPool::PoolLevel::HIGH);
 
@@ -1075,13 +1256,19 @@ namespace nil {
                     const std::map<std::size_t, std::vector<PolynomialType>> &g,
                     const std::vector<typename FRI::precommitment_type> &fri_trees,
                     const std::vector<PolynomialType> &fs,
-                    const math::polynomial<typename FRI::field_type::value_type> &final_polynomial)
+                    const math::polynomial<typename FRI::field_type::value_type> &final_polynomial,
+                    const PolynomialType &combined_Q,
+                    const std::vector<typename FRI::field_type::value_type> &alphas,
+                    std::vector<typename FRI::merkle_multiproof_type> *round_multiproofs)
                 {
                     typename FRI::initial_proofs_batch_type initial_proofs =
                         query_phase_initial_proofs<FRI, PolynomialType>(
                             precommitments, fri_params, g, challenges);
 
-                    typename FRI::round_proofs_batch_type round_proofs =
+                    typename FRI::round_proofs_batch_type round_proofs = fri_params.recompute_fri_rounds ?
+                        query_phase_recomputed_round_proofs<FRI, PolynomialType>(
+                            fri_params, fri_trees.front(), combined_Q, alphas, final_polynomial, challenges,
+                            round_multiproofs) :
                         query_phase_round_proofs<FRI, PolynomialType>(
                             fri_params, fri_trees, fs, final_polynomial, challenges);
 
@@ -1104,14 +1291,54 @@ namespace nil {
                     const std::map<std::size_t, std::vector<PolynomialType>> &g,
                     const std::vector<typename FRI::precommitment_type> &fri_trees,
                     const std::vector<PolynomialType> &fs,
-                    const math::polynomial<typename FRI::field_type::value_type> &final_polynomial)
+                    const math::polynomial<typename FRI::field_type::value_type> &final_polynomial,
+                    const PolynomialType &combined_Q,
+                    const std::vector<typename FRI::field_type::value_type> &alphas,
+                    std::vector<typename FRI::merkle_multiproof_type> *round_multiproofs = nullptr)
                 {
                     PROFILE_SCOPE("Basic FRI query phase");
                     std::vector<typename FRI::field_type::value_type> challenges =
                         transcript.template challenges<typename FRI::field_type>(fri_params.lambda);
 
                     return query_phase_with_challenges<FRI, PolynomialType>(
-                        precommitments, fri_params, challenges, g, fri_trees, fs, final_polynomial);
+                        precommitments, fri_params, challenges, g, fri_trees, fs, final_polynomial,
+                        combined_Q, alphas, round_multiproofs);
+                }
+
+                /// Replaces the Merkle paths of the queries by one multiproof per tree, see FRI::proof_type. The round
+                /// multiproofs already in the proof are kept, they are made by the query phase when it recomputes
+                /// the rounds, and fri_trees holds only the tree of combined_Q then.
+                template<typename FRI>
+                static void make_merkle_multiproofs(
+                    typename FRI::proof_type &proof,
+                    const std::map<std::size_t, typename FRI::precommitment_type> &precommitments,
+                    const std::vector<typename FRI::precommitment_type> &fri_trees)
+                {
+                    PROFILE_SCOPE("Basic FRI merkle multiproofs");
+                    std::map<std::size_t, std::vector<std::size_t>> initial_leaf_indices;
+                    std::vector<std::vector<std::size_t>> round_leaf_indices(
+                        proof.query_proofs.empty() ? 0 : proof.query_proofs.front().round_proofs.size());
+                    for (auto &query_proof : proof.query_proofs) {
+                        for (auto &[k, initial_proof] : query_proof.initial_proof) {
+                            initial_leaf_indices[k].push_back(initial_proof.p.leaf_index());
+                            initial_proof.p = typename FRI::merkle_proof_type();
+                        }
+                        for (std::size_t i = 0; i < query_proof.round_proofs.size(); i++) {
+                            round_leaf_indices[i].push_back(query_proof.round_proofs[i].p.leaf_index());
+                            query_proof.round_proofs[i].p = typename FRI::merkle_proof_type();
+                        }
+                    }
+
+                    for (const auto &[k, leaf_indices] : initial_leaf_indices) {
+                        proof.initial_multiproofs.emplace(
+                            k, typename FRI::merkle_multiproof_type(precommitments.at(k), leaf_indices));
+                    }
+                    if (proof.round_multiproofs.empty()) {
+                        for (std::size_t i = 0; i < fri_trees.size(); i++) {
+                            proof.round_multiproofs.emplace_back(fri_trees[i], round_leaf_indices[i]);
+                        }
+                    }
+                    proof.use_merkle_multiproofs = true;
                 }
 
                 template<typename FRI,
@@ -1147,7 +1374,7 @@ namespace nil {
                     const std::map<std::size_t, std::vector<PolynomialType>> &g,
                     const PolynomialType& combined_Q,
                     const std::map<std::size_t, typename FRI::precommitment_type> &precommitments,
-                    const typename FRI::precommitment_type &combined_Q_precommitment,
+                    typename FRI::precommitment_type combined_Q_precommitment,
                     const typename FRI::params_type &fri_params,
                     typename FRI::transcript_type &transcript
                 ) {
@@ -1162,6 +1389,7 @@ namespace nil {
 
                     std::vector<typename FRI::precommitment_type> fri_trees;
                     std::vector<PolynomialType> fs;
+                    std::vector<typename FRI::field_type::value_type> alphas;
 
                     // Contains fri_roots and final_polynomial.
                     typename FRI::commitments_part_of_proof commitments_proof;
@@ -1169,8 +1397,8 @@ namespace nil {
                     std::tie(fs, fri_trees, commitments_proof) =
                         commit_phase<FRI, PolynomialType>(
                             combined_Q,
-                            combined_Q_precommitment,
-                            fri_params, transcript);
+                            std::move(combined_Q_precommitment),
+                            fri_params, transcript, &alphas);
 
                     // Grinding
                     proof.proof_of_work = run_grinding<FRI>(fri_params, transcript);
@@ -1178,7 +1406,12 @@ namespace nil {
                     // Query phase
                     proof.query_proofs = query_phase<FRI, PolynomialType>(
                         precommitments, fri_params, transcript,
-                        g, fri_trees, fs, commitments_proof.final_polynomial);
+                        g, fri_trees, fs, commitments_proof.final_polynomial, combined_Q, alphas,
+                        fri_params.use_merkle_multiproofs ? &proof.round_multiproofs : nullptr);
+
+                    if (fri_params.use_merkle_multiproofs) {
+                        make_merkle_multiproofs<FRI>(proof, precommitments, fri_trees);
+                    }
 
                     proof.fri_roots = std::move(commitments_proof.fri_roots);
                     proof.final_polynomial = std::move(commitments_proof.final_polynomial);
@@ -1222,6 +1455,14 @@ namespace nil {
                             transcript, proof.proof_of_work, fri_params.grinding_parameter)){
                         return false;
                     }
+
+                    // With multiproofs the leaves of all the queries are collected first and checked at the end.
+                    std::map<std::size_t, std::vector<std::size_t>> initial_leaf_indices;
+                    std::map<std::size_t, std::vector<detail::fri_field_element_consumer<FRI>>> initial_leaves;
+                    std::vector<std::vector<std::size_t>> round_leaf_indices(fri_params.step_list.size());
+                    std::vector<std::vector<detail::fri_field_element_consumer<FRI>>> round_leaves(
+                        fri_params.step_list.size());
+
                     for (std::size_t query_id = 0; query_id < fri_params.lambda; query_id++) {
                         const typename FRI::query_proof_type &query_proof = proof.query_proofs[query_id];
 
@@ -1229,12 +1470,7 @@ namespace nil {
                         std::size_t coset_size = 1 << fri_params.step_list[0];
                         typename FRI::field_type::value_type x_challenge = transcript.template challenge<typename FRI::field_type>();
                         typename FRI::field_type::value_type x = x_challenge.pow((FRI::field_type::modulus - 1)/domain_size);
-                        std::uint64_t x_index = 0;
-                        for( x_index = 0; x_index < domain_size; x_index++ ){
-                            if( fri_params.D[0]->get_domain_element(x_index) == x ){
-                                break;
-                            }
-                        }
+                        std::uint64_t x_index = get_domain_element_index<FRI>(x, fri_params.D[0]);
 
                         std::vector<std::array<typename FRI::field_type::value_type, FRI::m>> s;
                         std::vector<std::array<std::size_t, FRI::m>> s_indices;
@@ -1243,9 +1479,12 @@ namespace nil {
                                                                         s_indices);
 
                         // Check initial proof.
+                        std::size_t initial_leaf_index = get_leaf_index<FRI>(
+                            x_index, domain_size, fri_params.step_list[0]);
                         for( auto const &it: query_proof.initial_proof ){
                             auto k = it.first;
-                            if (query_proof.initial_proof.at(k).p.root() != commitments.at(k) ) {
+                            if (!proof.use_merkle_multiproofs &&
+                                    query_proof.initial_proof.at(k).p.root() != commitments.at(k) ) {
                                 return false;
                             }
 
@@ -1258,7 +1497,10 @@ namespace nil {
                                     leaf_data.consume(query_proof.initial_proof.at(k).values[i][idx][1]);
                                 }
                             }
-                            if (!query_proof.initial_proof.at(k).p.validate(leaf_data)) {
+                            if (proof.use_merkle_multiproofs) {
+                                initial_leaf_indices[k].push_back(initial_leaf_index);
+                                initial_leaves[k].emplace_back(std::move(leaf_data));
+                            } else if (!query_proof.initial_proof.at(k).p.validate(leaf_data)) {
                                 BOOST_LOG_TRIVIAL(info) << "Wrong initial proof";
                                 return false;
                             }
@@ -1300,7 +1542,8 @@ namespace nil {
                         typename FRI::polynomial_values_type y_next;
                         for (std::size_t i = 0; i < fri_params.step_list.size(); i++) {
                             coset_size = 1 << fri_params.step_list[i];
-                            if (query_proof.round_proofs[i].p.root() != proof.fri_roots[i])
+                            if (!proof.use_merkle_multiproofs &&
+                                    query_proof.round_proofs[i].p.root() != proof.fri_roots[i])
                                 return false;
 
                             std::tie(s, s_indices) = calculate_s<FRI>(x_index, fri_params.step_list[i],
@@ -1312,7 +1555,11 @@ namespace nil {
                                 leaf_data.consume(y[idx][0]);
                                 leaf_data.consume(y[idx][1]);
                             }
-                            if (!query_proof.round_proofs[i].p.validate(leaf_data)) {
+                            if (proof.use_merkle_multiproofs) {
+                                round_leaf_indices[i].push_back(
+                                    get_leaf_index<FRI>(x_index, domain_size, fri_params.step_list[i]));
+                                round_leaves[i].emplace_back(std::move(leaf_data));
+                            } else if (!query_proof.round_proofs[i].p.validate(leaf_data)) {
                                 BOOST_LOG_TRIVIAL(info) << "Wrong round merkle proof on " << i << "-th round";
                                 return false;
                             }
@@ -1415,6 +1662,34 @@ namespace nil {
                         }
                     }
 
+                    if (proof.use_merkle_multiproofs) {
+                        // The leaf count of a multiproof decides the shape of the tree it is checked against, so it
+                        // must be the one of the committed tree: a leaf per coset of the domain of the tree.
+                        const std::size_t initial_leaves_number =
+                            fri_params.D[0]->size() >> fri_params.step_list[0];
+                        for (const auto &[k, leaves] : initial_leaves) {
+                            auto multiproof = proof.initial_multiproofs.find(k);
+                            if (multiproof == proof.initial_multiproofs.end() ||
+                                    multiproof->second.leaves() != initial_leaves_number ||
+                                    multiproof->second.root() != commitments.at(k) ||
+                                    !multiproof->second.validate(initial_leaf_indices.at(k), leaves)) {
+                                BOOST_LOG_TRIVIAL(info) << "Wrong initial multiproof";
+                                return false;
+                            }
+                        }
+                        if (proof.round_multiproofs.size() != fri_params.step_list.size()) {
+                            return false;
+                        }
+                        for (std::size_t i = 0, t = 0; i < fri_params.step_list.size(); t += fri_params.step_list[i], i++) {
+                            if (proof.round_multiproofs[i].leaves() != (fri_params.D[t]->size() >> fri_params.step_list[i]) ||
+                                    proof.round_multiproofs[i].root() != proof.fri_roots[i] ||
+                                    !proof.round_multiproofs[i].validate(round_leaf_indices[i], round_leaves[i])) {
+                                BOOST_LOG_TRIVIAL(info) << "Wrong round merkle multiproof on " << i << "-th round";
+                                return false;
+                            }
+                        }
+                    }
+
                     return true;
                 }
             }    // namespace algorithms
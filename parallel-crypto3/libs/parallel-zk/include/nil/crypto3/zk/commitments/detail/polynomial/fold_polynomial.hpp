@@ -52,18 +52,18 @@ namespace nil {
 
                     template<typename FieldType>
                     math::polynomial<typename FieldType::value_type>
-                    fold_polynomial(math::polynomial<typename FieldType::value_type> &f,
+                    fold_polynomial(const math::polynomial<typename FieldType::value_type> &f,
                                     typename FieldType::value_type alpha) {
 
+                        // For an even degree the missing odd coefficient is zero.
                         std::size_t d = f.degree();
-                        if (d % 2 == 0) {
-                            f.push_back(FieldType::value_type::zero());
-                            d++;
-                        }
                         math::polynomial<typename FieldType::value_type> f_folded(d / 2 + 1);
 
                         for (std::size_t index = 0; index <= f_folded.degree(); index++) {
-                            f_folded[index] = f[2 * index] + alpha * f[2 * index + 1];
+                            f_folded[index] = f[2 * index];
+                            if (2 * index + 1 <= d) {
+                                f_folded[index] += alpha * f[2 * index + 1];
+                            }
                         }
 
                         return f_folded;
@@ -71,7 +71,7 @@ namespace nil {
 
                     template<typename FieldType>
                     math::polynomial_dfs<typename FieldType::value_type>
-                    fold_polynomial(math::polynomial_dfs<typename FieldType::value_type> &f,
+                    fold_polynomial(const math::polynomial_dfs<typename FieldType::value_type> &f,
                                     const typename FieldType::value_type &alpha,
                                     std::shared_ptr<math::evaluation_domain<FieldType>>
                                     domain) {
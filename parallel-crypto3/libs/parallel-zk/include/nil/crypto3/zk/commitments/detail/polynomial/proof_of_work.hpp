@@ -32,10 +32,16 @@
 
 #include <boost/property_tree/ptree.hpp>
 
+#include <atomic>
 #include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
 
 #include <nil/crypto3/random/algebraic_engine.hpp>
 #include <nil/crypto3/marshalling/algebra/types/field_element.hpp>
+#include <nil/crypto3/hash/type_traits.hpp>
+#include <nil/crypto3/hash/detail/keccak/keccak_multi_buffer_impl.hpp>
 #include <nil/crypto3/zk/transcript/fiat_shamir.hpp>
 
 #include <nil/actor/core/thread_pool.hpp>
@@ -45,6 +51,43 @@ namespace nil {
     namespace crypto3 {
         namespace zk {
             namespace commitments {
+                namespace detail {
+                    /*!
+                     * @brief Returns the smallest nonce for which 'search' finds a solution.
+                     *
+                     * Nonces are checked in rounds of ThreadPool::min_chunk_size() nonces per worker, so the result
+                     * does not depend on the number of threads. search(begin, end, best) is called concurrently, it
+                     * returns the first good nonce in [begin, end) or 'end' if there is none, and may give up once
+                     * it's past 'best', the smallest nonce found in the round so far.
+                     */
+                    template<typename SearchFunction>
+                    std::size_t find_smallest_nonce(SearchFunction search) {
+                        const std::size_t per_round =
+                            ThreadPool::get_instance(ThreadPool::PoolLevel::LOW).get_pool_size() *
+                            ThreadPool::min_chunk_size();
+                        constexpr std::size_t not_found = std::numeric_limits<std::size_t>::max();
+
+                        for (std::size_t round_start = 0;; round_start += per_round) {
+                            std::atomic<std::size_t> best = not_found;
+                            wait_for_all(parallel_run_in_chunks<void>(
+                                per_round,
+                                [round_start, &search, &best](std::size_t begin, std::size_t end) {
+                                    std::size_t found = search(round_start + begin, round_start + end, best);
+                                    if (found == round_start + end) {
+                                        return;
+                                    }
+                                    std::size_t current = best;
+                                    while (found < current && !best.compare_exchange_weak(current, found)) {
+                                    }
+                                }, ThreadPool::PoolLevel::LOW));
+
+                            if (best != not_found) {
+                                return best;
+                            }
+                        }
+                    }
+                }    // namespace detail
+
                 template<typename TranscriptHashType, typename OutType = std::uint32_t>
                 class proof_of_work {
                 public:
@@ -62,49 +105,24 @@ namespace nil {
                             return bytes;
                         }
 
+                    // Returns the smallest nonce that passes, so the proof is the same for the same transcript.
                     static inline OutType generate(transcript_type &transcript, std::size_t grinding_bits = 16) {
                         BOOST_ASSERT_MSG(grinding_bits < 64, "Grinding parameter should be bits, not mask");
                         output_type mask = grinding_bits > 0 ? ( 1ULL << grinding_bits ) - 1 : 0;
-                        output_type pow_seed = std::rand();
 
-                        /* Enough work for ~ two minutes on 48 cores, keccak<512> */
-                        std::size_t per_block = 1 << 30;
+                        output_type pow_value = detail::find_smallest_nonce(
+                            [&transcript, mask](std::size_t begin, std::size_t end,
+                                                const std::atomic<std::size_t> &best) {
+                                if constexpr (hashes::is_keccak_1600<transcript_hash_type>::value) {
+                                    return search_keccak(transcript.get_state(), mask, begin, end, best);
+                                } else {
+                                    return search(transcript, mask, begin, end, best);
+                                }
+                            });
 
-                        std::atomic<bool> challenge_found = false;
-                        std::atomic<std::size_t> pow_value_offset;
-
-                        while( true ) {
-                            wait_for_all(parallel_run_in_chunks<void>(
-                                per_block,
-                                [&transcript, &pow_seed, &challenge_found, &pow_value_offset, &mask](std::size_t pow_start, std::size_t pow_finish) {
-                                    std::size_t i = pow_start;
-                                    while ( i < pow_finish ) {
-                                        if (challenge_found) {
-                                            break;
-                                        }
-                                        transcript_type tmp_transcript = transcript;
-                                        tmp_transcript(to_byte_array(pow_seed + i));
-                                        OutType pow_result = tmp_transcript.template int_challenge<OutType>();
-                                        if ( ((pow_result & mask) == 0) && !challenge_found ) {
-                                            bool expected = false;
-                                            if (challenge_found.compare_exchange_strong(expected, true)) {
-                                                pow_value_offset = i;
-                                            }
-                                            break;
-                                        }
-                                        ++i;
-                                    }
-                                }, ThreadPool::PoolLevel::LOW));
-
-                            if (challenge_found) {
-                                break;
-                            }
-                            pow_seed += per_block;
-                        }
-
-                        transcript(to_byte_array(pow_seed + (std::size_t)pow_value_offset));
-                        transcript.template int_challenge<OutType>();
-                        return pow_seed + (std::size_t)pow_value_offset;
+                        transcript(to_byte_array(pow_value));
+                        BOOST_VERIFY((transcript.template int_challenge<OutType>() & mask) == 0);
+                        return pow_value;
                     }
 
                     static inline bool verify(transcript_type &transcript, output_type proof_of_work, std::size_t grinding_bits = 16) {
@@ -114,6 +132,66 @@ namespace nil {
                         output_type mask = grinding_bits > 0 ? ( 1ULL << grinding_bits ) - 1 : 0;
                         return ((result & mask) == 0);
                     }
+
+                private:
+                    static std::size_t search(const transcript_type &transcript, output_type mask, std::size_t begin,
+                                              std::size_t end, const std::atomic<std::size_t> &best) {
+                        for (std::size_t i = begin; i < end && i < best.load(std::memory_order_relaxed); ++i) {
+                            transcript_type tmp_transcript = transcript;
+                            tmp_transcript(to_byte_array(i));
+                            if ((tmp_transcript.template int_challenge<OutType>() & mask) == 0) {
+                                return i;
+                            }
+                        }
+                        return end;
+                    }
+
+                    // Computes both hashes of a nonce, 'state || nonce' and then its digest, for a batch of nonces
+                    // at a time with the multi-buffer Keccak.
+                    static std::size_t search_keccak(const typename transcript_hash_type::digest_type &state,
+                                                     output_type mask, std::size_t begin, std::size_t end,
+                                                     const std::atomic<std::size_t> &best) {
+                        typedef hashes::detail::keccak_1600_multi_buffer_hasher<transcript_hash_type::digest_bits>
+                            hasher_type;
+                        typedef typename hasher_type::digest_type digest_type;
+                        constexpr std::size_t batch_size = 64;
+                        constexpr std::size_t message_size = hasher_type::digest_bytes + sizeof(OutType);
+                        static_assert(sizeof(digest_type) == hasher_type::digest_bytes,
+                                      "Digests must be stored as plain bytes");
+
+                        std::vector<std::uint8_t> messages(batch_size * message_size);
+                        std::vector<const std::uint8_t *> message_pointers(batch_size);
+                        std::vector<digest_type> digests(batch_size), challenge_digests(batch_size);
+                        for (std::size_t k = 0; k < batch_size; ++k) {
+                            std::memcpy(&messages[k * message_size], state.data(), hasher_type::digest_bytes);
+                        }
+
+                        for (std::size_t i = begin; i < end && i < best.load(std::memory_order_relaxed);
+                             i += batch_size) {
+                            const std::size_t count = std::min(batch_size, end - i);
+                            for (std::size_t k = 0; k < count; ++k) {
+                                auto nonce = to_byte_array(i + k);
+                                std::copy(nonce.begin(), nonce.end(),
+                                          &messages[k * message_size + hasher_type::digest_bytes]);
+                                message_pointers[k] = &messages[k * message_size];
+                            }
+                            hasher_type::hash(message_pointers.data(), message_size, count, digests.data());
+
+                            for (std::size_t k = 0; k < count; ++k) {
+                                message_pointers[k] = reinterpret_cast<const std::uint8_t *>(&digests[k]);
+                            }
+                            hasher_type::hash(message_pointers.data(), hasher_type::digest_bytes, count,
+                                              challenge_digests.data());
+
+                            for (std::size_t k = 0; k < count; ++k) {
+                                if ((transcript_type::template int_challenge_of_state<OutType>(challenge_digests[k]) &
+                                     mask) == 0) {
+                                    return i + k;
+                                }
+                            }
+                        }
+                        return end;
+                    }
                 };
 
                 // Note that the interface here is slightly different from the one above:
@@ -128,54 +206,38 @@ namespace nil {
                     using value_type = typename FieldType::value_type;
                     using integral_type = typename FieldType::integral_type;
 
+                    // Returns pow_seed + i for the smallest passing i, pow_seed comes from the system random device.
                     static inline value_type generate(transcript_type &transcript, std::size_t GrindingBits=16) {
                         static boost::random::random_device dev;
                         static nil::crypto3::random::algebraic_engine<FieldType> random_engine(dev);
-                        value_type pow_seed = random_engine();
+                        const value_type pow_seed = random_engine();
 
                         integral_type mask =
                             (GrindingBits > 0 ?
                                 ((integral_type(1) << GrindingBits) - 1) << (FieldType::modulus_bits - GrindingBits)
                                 : 0);
 
-                        /* Enough work for ~ two minutes on 48 cores, poseidon<pallas> */
-                        std::size_t per_block = 1 << 23;
-
-                        std::atomic<bool> challenge_found = false;
-                        std::atomic<std::size_t> pow_value_offset;
-
-                        while( true ) {
-                            wait_for_all(parallel_run_in_chunks<void>(
-                                per_block,
-                                [&transcript, &pow_seed, &challenge_found, &pow_value_offset, &mask](std::size_t pow_start, std::size_t pow_finish) {
-                                    std::size_t i = pow_start;
-                                    while ( i < pow_finish ) {
-                                        if (challenge_found) {
-                                            break;
-                                        }
-                                        transcript_type tmp_transcript = transcript;
-                                        tmp_transcript(pow_seed + i);
-                                        integral_type pow_result = integral_type(tmp_transcript.template challenge<FieldType>().data);
-                                        if ( ((pow_result & mask) == 0) && !challenge_found ) {
-                                            bool expected = false;
-                                            if (challenge_found.compare_exchange_strong(expected, true)) {
-                                                pow_value_offset = i;
-                                            }
-                                            break;
-                                        }
-                                        ++i;
+                        std::size_t pow_value_offset = detail::find_smallest_nonce(
+                            [&transcript, &pow_seed, &mask](std::size_t begin, std::size_t end,
+                                                            const std::atomic<std::size_t> &best) {
+                                // Transcript copies are cheap for Poseidon, the sponge is a few field elements.
+                                value_type pow_value = pow_seed + begin;
+                                for (std::size_t i = begin; i < end && i < best.load(std::memory_order_relaxed);
+                                     ++i, pow_value += value_type::one()) {
+                                    transcript_type tmp_transcript = transcript;
+                                    tmp_transcript(pow_value);
+                                    integral_type pow_result =
+                                        integral_type(tmp_transcript.template challenge<FieldType>().data);
+                                    if ((pow_result & mask) == 0) {
+                                        return i;
                                     }
-                                }, ThreadPool::PoolLevel::LOW));
-
-                            if (challenge_found) {
-                                break;
-                            }
-                            pow_seed += per_block;
-                        }
+                                }
+                                return end;
+                            });
 
-                        transcript(pow_seed + (std::size_t)pow_value_offset);
+                        transcript(pow_seed + pow_value_offset);
                         transcript.template challenge<FieldType>();
-                        return pow_seed + (std::size_t)pow_value_offset;
+                        return pow_seed + pow_value_offset;
                     }
 
                     static inline bool verify(transcript_type &transcript, value_type proof_of_work, std::size_t GrindingBits = 16) {
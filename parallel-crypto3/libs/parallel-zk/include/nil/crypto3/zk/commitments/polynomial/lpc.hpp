@@ -98,6 +98,12 @@ namespace nil {
                     // We must set it in verifier, taking this value from common data.
                     void set_fixed_polys_values(const preprocessed_data_type& value) {_fixed_polys_values = value;}
 
+                    // The FRI options only the prover looks at, they are not part of the marshalled params.
+                    void set_fri_prover_options(bool use_merkle_multiproofs, bool recompute_fri_rounds) {
+                        _fri_params.use_merkle_multiproofs = use_merkle_multiproofs;
+                        _fri_params.recompute_fri_rounds = recompute_fri_rounds;
+                    }
+
                     // This constructor is normally used from marshalling, to recover the LPC state from a file.
                     // Maybe we want the move variant of this constructor.
                     lpc_commitment_scheme(
@@ -221,6 +227,7 @@ namespace nil {
 
                         std::vector<typename fri_type::precommitment_type> fri_trees;
                         std::vector<polynomial_type> fs;
+                        std::vector<typename fri_type::field_type::value_type> alphas;
 
                         // Contains fri_roots and final_polynomial.
                         typename fri_type::commitments_part_of_proof commitments_proof;
@@ -229,21 +236,32 @@ namespace nil {
                         std::tie(fs, fri_trees, commitments_proof) =
                             nil::crypto3::zk::algorithms::commit_phase<fri_type, polynomial_type>(
                                 sum_poly,
-                                sum_poly_precommitment,
-                                _fri_params, transcript);
+                                std::move(sum_poly_precommitment),
+                                _fri_params, transcript, &alphas);
 
                         std::vector<typename fri_type::field_type::value_type> challenges =
                             transcript.template challenges<typename fri_type::field_type>(this->_fri_params.lambda);
 
                         fri_proof_type fri_proof;
 
-                        fri_proof.fri_round_proof = nil::crypto3::zk::algorithms::query_phase_round_proofs<
-                                fri_type, polynomial_type>(
-                            _fri_params,
-                            fri_trees,
-                            fs,
-                            commitments_proof.final_polynomial,
-                            challenges);
+                        if (_fri_params.recompute_fri_rounds) {
+                            fri_proof.fri_round_proof = nil::crypto3::zk::algorithms::query_phase_recomputed_round_proofs<
+                                    fri_type, polynomial_type>(
+                                _fri_params,
+                                fri_trees.front(),
+                                sum_poly,
+                                alphas,
+                                commitments_proof.final_polynomial,
+                                challenges);
+                        } else {
+                            fri_proof.fri_round_proof = nil::crypto3::zk::algorithms::query_phase_round_proofs<
+                                    fri_type, polynomial_type>(
+                                _fri_params,
+                                fri_trees,
+                                fs,
+                                commitments_proof.final_polynomial,
+                                challenges);
+                        }
 
                         fri_proof.fri_commitments_proof_part = std::move(commitments_proof);
 
@@ -264,7 +282,7 @@ namespace nil {
                             this->_polys,
                             combined_Q,
                             this->_trees,
-                            combined_Q_precommitment,
+                            std::move(combined_Q_precommitment),
                             this->_fri_params,
                             transcript
                         );
@@ -327,19 +345,21 @@ namespace nil {
                         std::map<std::size_t, std::vector<math::polynomial<value_type>>>* polys_coefficients_ptr;
 
                         if constexpr(std::is_same<math::polynomial_dfs<value_type>, PolynomialType>::value ) {
-                            // Convert this->_polys to coefficients form.
+                            // Convert this->_polys to coefficients form, polynomials of equal size are converted together.
                             std::vector<std::pair<std::size_t, std::size_t>> indices;
+                            std::vector<const math::polynomial_dfs<value_type> *> polys;
                             for (const auto& [i, V]: this->_polys) {
                                 polys_coefficients[i].resize(V.size());
                                 for (std::size_t j = 0; j < V.size(); ++j) {
                                     indices.push_back({i, j});
+                                    polys.push_back(&V[j]);
                                 }
                             }
 
-                            parallel_for(0, indices.size(), [this, &indices, &polys_coefficients](std::size_t i) {
-                                polys_coefficients[indices[i].first][indices[i].second] =
-                                    this->_polys[indices[i].first][indices[i].second].coefficients();
-                            }, ThreadPool::PoolLevel::HIGH);
+                            auto coefficients = math::polynomials_coefficients<field_type>(polys);
+                            for (std::size_t i = 0; i < indices.size(); ++i) {
+                                polys_coefficients[indices[i].first][indices[i].second] = std::move(coefficients[i]);
+                            }
 
                             polys_coefficients_ptr = &polys_coefficients;
                         } else {
@@ -0,0 +1,509 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef PARALLEL_CRYPTO3_ZK_MATH_EXPRESSION_COMPILER_HPP
+#define PARALLEL_CRYPTO3_ZK_MATH_EXPRESSION_COMPILER_HPP
+
+#ifdef CRYPTO3_ZK_MATH_EXPRESSION_COMPILER_HPP
+#error "You're mixing parallel and non-parallel crypto3 versions"
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/variant/static_visitor.hpp>
+#include <boost/variant/apply_visitor.hpp>
+
+#include <nil/crypto3/math/detail/limb_major_montgomery.hpp>
+#include <nil/crypto3/zk/math/expression.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace math {
+
+            enum class bytecode_opcode : std::uint8_t {
+                ADD,
+                SUB,
+                MULT,
+                POW
+            };
+
+            // An argument of an instruction: a constant, a variable column or a register.
+            struct bytecode_operand {
+                enum class kind_type : std::uint8_t {
+                    CONSTANT,
+                    VARIABLE,
+                    REGISTER
+                };
+
+                kind_type kind;
+                std::uint32_t index;
+
+                bool operator==(const bytecode_operand& other) const {
+                    return kind == other.kind && index == other.index;
+                }
+
+                bool operator<(const bytecode_operand& other) const {
+                    return std::tie(kind, index) < std::tie(other.kind, other.index);
+                }
+            };
+
+            // Writes 'left op right' into register 'dst'. For POW the result is left^power, and 'right' is the same as 'left'.
+            struct bytecode_instruction {
+                bytecode_opcode op;
+                std::uint32_t dst;
+                bytecode_operand left;
+                bytecode_operand right;
+                std::uint32_t power;
+            };
+
+            /**
+             * An expression lowered into a linear program by expression_compiler. Variables are numbered in order of
+             * appearance, the caller passes their values as an array of column pointers in the same order. The
+             * program is run over blocks of rows, each register holds the values of one block, so every instruction
+             * is a straight loop over contiguous arrays. For prime fields in Montgomery form the blocks are stored
+             * limb-major and every instruction works on several rows at once with vector instructions, see
+             * limb_major_montgomery.
+             */
+            template<typename VariableType>
+            class compiled_expression {
+            public:
+                using ValueType = typename VariableType::assignment_type;
+
+                // Number of rows evaluated at once. Registers take registers_count() * BLOCK_SIZE values.
+                static constexpr std::size_t BLOCK_SIZE = 64;
+
+                const std::vector<VariableType>& variables() const {
+                    return _variables;
+                }
+
+                const std::vector<ValueType>& constants() const {
+                    return _constants;
+                }
+
+                const std::vector<bytecode_instruction>& instructions() const {
+                    return _instructions;
+                }
+
+                std::size_t registers_count() const {
+                    return _registers_count;
+                }
+
+                /*
+                 * Evaluates the expression on rows [begin, end).
+                 * @param variable_values - variable_values[i] points to the values of variables()[i] at all rows.
+                 * @param result - receives the value at row j in result[j - begin].
+                 */
+                void evaluate(const std::vector<const ValueType*>& variable_values,
+                              std::size_t begin, std::size_t end, ValueType* result) const {
+                    evaluate(variable_values, begin, end, result, default_backend());
+                }
+
+                // The same with the given backend, limb_major_backend::scalar evaluates values one by one.
+                void evaluate(const std::vector<const ValueType*>& variable_values,
+                              std::size_t begin, std::size_t end, ValueType* result,
+                              limb_major_backend backend) const {
+                    if (variable_values.size() != _variables.size()) {
+                        throw std::invalid_argument("compiled_expression: wrong number of variable columns");
+                    }
+                    if constexpr (is_limb_major_field_element<ValueType>::value) {
+                        if (backend != limb_major_backend::scalar) {
+                            evaluate_limb_major(variable_values, begin, end, result, backend);
+                            return;
+                        }
+                    }
+
+                    std::vector<ValueType> registers(_registers_count * BLOCK_SIZE);
+                    for (std::size_t block_begin = begin; block_begin < end; block_begin += BLOCK_SIZE) {
+                        const std::size_t rows = std::min(end - block_begin, BLOCK_SIZE);
+
+                        // Constants are not replicated over the block, they are read with step 0.
+                        auto values = [this, &registers, &variable_values, block_begin](
+                                const bytecode_operand& operand) -> std::pair<const ValueType*, std::size_t> {
+                            switch (operand.kind) {
+                                case bytecode_operand::kind_type::CONSTANT:
+                                    return {&_constants[operand.index], 0};
+                                case bytecode_operand::kind_type::VARIABLE:
+                                    return {variable_values[operand.index] + block_begin, 1};
+                                default:
+                                    return {registers.data() + operand.index * BLOCK_SIZE, 1};
+                            }
+                        };
+
+                        for (const bytecode_instruction& instruction : _instructions) {
+                            ValueType* dst = registers.data() + instruction.dst * BLOCK_SIZE;
+                            // 'dst' may be the register of an argument, so each value is computed before it's stored.
+                            const auto [left, left_step] = values(instruction.left);
+                            if (instruction.op == bytecode_opcode::POW) {
+                                for (std::size_t r = 0; r < rows; ++r) {
+                                    dst[r] = left[r * left_step].pow(instruction.power);
+                                }
+                                continue;
+                            }
+                            const auto [right, right_step] = values(instruction.right);
+                            switch (instruction.op) {
+                                case bytecode_opcode::ADD:
+                                    for (std::size_t r = 0; r < rows; ++r) {
+                                        dst[r] = left[r * left_step] + right[r * right_step];
+                                    }
+                                    break;
+                                case bytecode_opcode::SUB:
+                                    for (std::size_t r = 0; r < rows; ++r) {
+                                        dst[r] = left[r * left_step] - right[r * right_step];
+                                    }
+                                    break;
+                                case bytecode_opcode::MULT:
+                                    for (std::size_t r = 0; r < rows; ++r) {
+                                        dst[r] = left[r * left_step] * right[r * right_step];
+                                    }
+                                    break;
+                                default:
+                                    throw std::invalid_argument("compiled_expression: unknown opcode");
+                            }
+                        }
+
+                        const auto [res, res_step] = values(_result);
+                        for (std::size_t r = 0; r < rows; ++r) {
+                            result[block_begin - begin + r] = res[r * res_step];
+                        }
+                    }
+                }
+
+                // The fastest backend for ValueType on this CPU.
+                static limb_major_backend default_backend() {
+                    if constexpr (is_limb_major_field_element<ValueType>::value) {
+                        return limb_major_montgomery<ValueType, BLOCK_SIZE>::best_backend();
+                    } else {
+                        return limb_major_backend::scalar;
+                    }
+                }
+
+            private:
+                template<typename>
+                friend class expression_compiler;
+
+                // evaluate() on limb-major blocks. Constants are broadcast to blocks once, variables are loaded
+                // block by block.
+                void evaluate_limb_major(const std::vector<const ValueType*>& variable_values,
+                                         std::size_t begin, std::size_t end, ValueType* result,
+                                         limb_major_backend backend) const {
+                    const limb_major_montgomery<ValueType, BLOCK_SIZE> limb_major(backend);
+                    const std::size_t block_words = limb_major.words() * BLOCK_SIZE;
+
+                    std::vector<std::uint64_t> constants(_constants.size() * block_words);
+                    for (std::size_t i = 0; i < _constants.size(); ++i) {
+                        limb_major.load(&_constants[i], 0, BLOCK_SIZE, constants.data() + i * block_words);
+                    }
+                    std::vector<std::uint64_t> variables(_variables.size() * block_words);
+                    std::vector<std::uint64_t> registers(_registers_count * block_words);
+                    std::vector<std::uint64_t> base(block_words);
+
+                    for (std::size_t block_begin = begin; block_begin < end; block_begin += BLOCK_SIZE) {
+                        const std::size_t rows = std::min(end - block_begin, BLOCK_SIZE);
+                        for (std::size_t i = 0; i < _variables.size(); ++i) {
+                            limb_major.load(variable_values[i] + block_begin, 1, rows,
+                                            variables.data() + i * block_words);
+                        }
+
+                        auto block = [&constants, &variables, &registers, block_words](
+                                const bytecode_operand& operand) -> std::uint64_t* {
+                            switch (operand.kind) {
+                                case bytecode_operand::kind_type::CONSTANT:
+                                    return constants.data() + operand.index * block_words;
+                                case bytecode_operand::kind_type::VARIABLE:
+                                    return variables.data() + operand.index * block_words;
+                                default:
+                                    return registers.data() + operand.index * block_words;
+                            }
+                        };
+
+                        for (const bytecode_instruction& instruction : _instructions) {
+                            std::uint64_t* dst = block({bytecode_operand::kind_type::REGISTER, instruction.dst});
+                            const std::uint64_t* left = block(instruction.left);
+                            switch (instruction.op) {
+                                case bytecode_opcode::ADD:
+                                    limb_major.add(left, block(instruction.right), dst);
+                                    break;
+                                case bytecode_opcode::SUB:
+                                    limb_major.sub(left, block(instruction.right), dst);
+                                    break;
+                                case bytecode_opcode::MULT:
+                                    limb_major.mul(left, block(instruction.right), dst);
+                                    break;
+                                case bytecode_opcode::POW: {
+                                    // Square and multiply from the top bit, 'dst' may be the register of 'left'.
+                                    if (instruction.power == 0) {
+                                        limb_major.load(&ValueType::one(), 0, BLOCK_SIZE, dst);
+                                        break;
+                                    }
+                                    std::copy(left, left + block_words, base.begin());
+                                    std::copy(base.begin(), base.end(), dst);
+                                    std::size_t bit = 31;
+                                    while (!((instruction.power >> bit) & 1)) {
+                                        --bit;
+                                    }
+                                    while (bit-- > 0) {
+                                        limb_major.mul(dst, dst, dst);
+                                        if ((instruction.power >> bit) & 1) {
+                                            limb_major.mul(dst, base.data(), dst);
+                                        }
+                                    }
+                                    break;
+                                }
+                                default:
+                                    throw std::invalid_argument("compiled_expression: unknown opcode");
+                            }
+                        }
+
+                        // store() overwrites the block it reads.
+                        std::copy(block(_result), block(_result) + block_words, base.begin());
+                        limb_major.store(base.data(), rows, result + block_begin - begin);
+                    }
+                }
+
+                std::vector<VariableType> _variables;
+                std::vector<ValueType> _constants;
+                std::vector<bytecode_instruction> _instructions;
+                std::size_t _registers_count = 0;
+                bytecode_operand _result;
+            };
+
+            /**
+             * Lowers an expression tree into a compiled_expression. Constant subexpressions are folded, trivial
+             * operations like multiplication by one are dropped, and equal operations on equal arguments are
+             * computed once. Registers are reused as soon as their value is not needed any more.
+             */
+            template<typename VariableType>
+            class expression_compiler : public boost::static_visitor<bytecode_operand> {
+            public:
+                using ValueType = typename VariableType::assignment_type;
+
+                expression_compiler() {}
+
+                compiled_expression<VariableType> compile(const math::expression<VariableType>& expr) {
+                    _result = compiled_expression<VariableType>();
+                    _variable_slots.clear();
+                    _constant_slots.clear();
+                    _values.clear();
+                    _operations.clear();
+
+                    bytecode_operand result = boost::apply_visitor(*this, expr.get_expr());
+                    allocate_registers(result);
+                    return std::move(_result);
+                }
+
+                bytecode_operand operator()(const math::term<VariableType>& term) {
+                    bytecode_operand coeff = constant(term.get_coeff());
+                    if (term.get_vars().empty()) {
+                        return coeff;
+                    }
+                    bytecode_operand result = variable(term.get_vars()[0]);
+                    for (std::size_t i = 1; i < term.get_vars().size(); ++i) {
+                        result = emit(bytecode_opcode::MULT, result, variable(term.get_vars()[i]));
+                    }
+                    return emit(bytecode_opcode::MULT, coeff, result);
+                }
+
+                bytecode_operand operator()(const math::pow_operation<VariableType>& pow) {
+                    bytecode_operand base = boost::apply_visitor(*this, pow.get_expr().get_expr());
+                    return emit(bytecode_opcode::POW, base, base, pow.get_power());
+                }
+
+                bytecode_operand operator()(const math::binary_arithmetic_operation<VariableType>& op) {
+                    bytecode_operand left = boost::apply_visitor(*this, op.get_expr_left().get_expr());
+                    bytecode_operand right = boost::apply_visitor(*this, op.get_expr_right().get_expr());
+                    switch (op.get_op()) {
+                        case ArithmeticOperator::ADD:
+                            return emit(bytecode_opcode::ADD, left, right);
+                        case ArithmeticOperator::SUB:
+                            return emit(bytecode_opcode::SUB, left, right);
+                        case ArithmeticOperator::MULT:
+                            return emit(bytecode_opcode::MULT, left, right);
+                        default:
+                            throw std::invalid_argument("ArithmeticOperator not found");
+                    }
+                }
+
+            private:
+                bytecode_operand constant(const ValueType& value) {
+                    auto iter = _constant_slots.find(value);
+                    if (iter == _constant_slots.end()) {
+                        iter = _constant_slots.emplace(value, _result._constants.size()).first;
+                        _result._constants.push_back(value);
+                    }
+                    return {bytecode_operand::kind_type::CONSTANT, iter->second};
+                }
+
+                bytecode_operand variable(const VariableType& var) {
+                    auto iter = _variable_slots.find(var);
+                    if (iter == _variable_slots.end()) {
+                        iter = _variable_slots.emplace(var, _result._variables.size()).first;
+                        _result._variables.push_back(var);
+                    }
+                    return {bytecode_operand::kind_type::VARIABLE, iter->second};
+                }
+
+                bool is_constant(const bytecode_operand& operand, const ValueType& value) const {
+                    return operand.kind == bytecode_operand::kind_type::CONSTANT &&
+                           _result._constants[operand.index] == value;
+                }
+
+                // Returns the operand holding 'left op right', adding an instruction only if there is no such one yet.
+                // Register operands refer to the values computed so far, real registers are assigned later.
+                bytecode_operand emit(bytecode_opcode op, bytecode_operand left, bytecode_operand right,
+                                      std::uint32_t power = 0) {
+                    const ValueType zero = ValueType::zero();
+                    const ValueType one = ValueType::one();
+                    const bool left_constant = left.kind == bytecode_operand::kind_type::CONSTANT;
+                    const bool right_constant = right.kind == bytecode_operand::kind_type::CONSTANT;
+
+                    switch (op) {
+                        case bytecode_opcode::ADD:
+                            if (left_constant && right_constant)
+                                return constant(_result._constants[left.index] + _result._constants[right.index]);
+                            if (is_constant(left, zero))
+                                return right;
+                            if (is_constant(right, zero))
+                                return left;
+                            break;
+                        case bytecode_opcode::SUB:
+                            if (left_constant && right_constant)
+                                return constant(_result._constants[left.index] - _result._constants[right.index]);
+                            if (is_constant(right, zero))
+                                return left;
+                            if (left == right)
+                                return constant(zero);
+                            break;
+                        case bytecode_opcode::MULT:
+                            if (left_constant && right_constant)
+                                return constant(_result._constants[left.index] * _result._constants[right.index]);
+                            if (is_constant(left, zero) || is_constant(right, zero))
+                                return constant(zero);
+                            if (is_constant(left, one))
+                                return right;
+                            if (is_constant(right, one))
+                                return left;
+                            break;
+                        case bytecode_opcode::POW:
+                            if (power == 0)
+                                return constant(one);
+                            if (power == 1)
+                                return left;
+                            if (left_constant)
+                                return constant(_result._constants[left.index].pow(power));
+                            break;
+                    }
+
+                    if ((op == bytecode_opcode::ADD || op == bytecode_opcode::MULT) && right < left) {
+                        std::swap(left, right);
+                    }
+                    auto key = std::make_tuple(op, left, right, power);
+                    auto iter = _operations.find(key);
+                    if (iter != _operations.end()) {
+                        return iter->second;
+                    }
+
+                    bytecode_operand result = {bytecode_operand::kind_type::REGISTER,
+                                               static_cast<std::uint32_t>(_values.size())};
+                    _values.push_back({op, result.index, left, right, power});
+                    _operations.emplace(key, result);
+                    return result;
+                }
+
+                // Drops the values that are not needed for the result, then maps the values to registers,
+                // a register is given to a new value once the last instruction reading its previous value is done.
+                void allocate_registers(const bytecode_operand& result) {
+                    auto is_register = [](const bytecode_operand& operand) {
+                        return operand.kind == bytecode_operand::kind_type::REGISTER;
+                    };
+
+                    const std::size_t no_use = std::numeric_limits<std::size_t>::max();
+                    std::vector<std::size_t> last_use(_values.size(), no_use);
+                    if (is_register(result)) {
+                        last_use[result.index] = _values.size();
+                    }
+                    for (std::size_t i = _values.size(); i-- > 0;) {
+                        if (last_use[i] == no_use)
+                            continue;
+                        for (const bytecode_operand* operand : {&_values[i].left, &_values[i].right}) {
+                            if (is_register(*operand) && last_use[operand->index] == no_use) {
+                                last_use[operand->index] = i;
+                            }
+                        }
+                    }
+
+                    std::vector<std::uint32_t> value_register(_values.size());
+                    std::vector<std::uint32_t> free_registers;
+                    for (std::size_t i = 0; i < _values.size(); ++i) {
+                        if (last_use[i] == no_use)
+                            continue;
+                        const bytecode_operand left = _values[i].left;
+                        const bytecode_operand right = _values[i].right;
+                        bytecode_instruction instruction = _values[i];
+                        if (is_register(left)) {
+                            instruction.left.index = value_register[left.index];
+                            if (last_use[left.index] == i)
+                                free_registers.push_back(value_register[left.index]);
+                        }
+                        // The register is released only once if both arguments are the same value.
+                        if (is_register(right)) {
+                            instruction.right.index = value_register[right.index];
+                            if (last_use[right.index] == i && !(right == left))
+                                free_registers.push_back(value_register[right.index]);
+                        }
+                        if (free_registers.empty()) {
+                            value_register[i] = _result._registers_count++;
+                        } else {
+                            value_register[i] = free_registers.back();
+                            free_registers.pop_back();
+                        }
+                        instruction.dst = value_register[i];
+                        _result._instructions.push_back(instruction);
+                    }
+
+                    _result._result = result;
+                    if (is_register(result)) {
+                        _result._result.index = value_register[result.index];
+                    }
+                }
+
+                compiled_expression<VariableType> _result;
+                std::unordered_map<VariableType, std::uint32_t> _variable_slots;
+                std::unordered_map<ValueType, std::uint32_t> _constant_slots;
+
+                // Instructions in SSA form, value number i is computed by _values[i].
+                std::vector<bytecode_instruction> _values;
+                std::map<std::tuple<bytecode_opcode, bytecode_operand, bytecode_operand, std::uint32_t>,
+                         bytecode_operand> _operations;
+            };
+        }    // namespace math
+    }    // namespace crypto3
+}    // namespace nil
+
+#endif    // PARALLEL_CRYPTO3_ZK_MATH_EXPRESSION_COMPILER_HPP
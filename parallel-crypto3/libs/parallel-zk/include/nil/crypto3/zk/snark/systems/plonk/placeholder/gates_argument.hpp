@@ -53,6 +53,7 @@
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_policy.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/constraint.hpp>
 #include <nil/crypto3/zk/math/expression.hpp>
+#include <nil/crypto3/zk/math/expression_compiler.hpp>
 #include <nil/crypto3/zk/math/expression_evaluator.hpp>
 #include <nil/crypto3/zk/math/expression_visitors.hpp>
 
@@ -147,6 +148,7 @@ namespace nil {
                         transcript_type& transcript
                     ) {
                         PROFILE_SCOPE("gate_argument_time");
+                        ThreadPool::concurrency_limit_guard stage_limit(ThreadPool::Stage::GATES);
 
                         // max_gates_degree that comes from the outside does not take into account multiplication
                         // by selector.
@@ -217,22 +219,19 @@ namespace nil {
                                 mask_polynomial, lagrange_0
                             );
 
+                            // The expression is compiled once, then each thread runs it over blocks of its rows.
+                            math::expression_compiler<variable_type> compiler;
+                            const math::compiled_expression<variable_type> program = compiler.compile(expressions[i]);
+                            std::vector<const typename FieldType::value_type*> variable_columns;
+                            for (const variable_type& var : program.variables()) {
+                                variable_columns.push_back(variable_values.at(var).data());
+                            }
+
                             polynomial_dfs_type result(extended_domain_sizes[i] - 1, extended_domain_sizes[i]);
                             wait_for_all(parallel_run_in_chunks<void>(
                                 extended_domain_sizes[i],
-                                [&variable_values, &extended_domain_sizes, &result, &expressions, i]
-                                (std::size_t begin, std::size_t end) {
-                                    for (std::size_t j = begin; j < end; ++j) {
-                                        // Don't use cache here. In practice it's slower to maintain the cache
-                                        // than to re-compute the subexpression value when value type is field element.
-                                        math::expression_evaluator<variable_type> evaluator(
-                                            expressions[i],
-                                            [&assignments=variable_values, j]
-                                                (const variable_type &var) -> const typename FieldType::value_type& {
-                                                    return assignments[var][j];
-                                            });
-                                        result[j] = evaluator.evaluate();
-                                    }
+                                [&program, &variable_columns, &result](std::size_t begin, std::size_t end) {
+                                    program.evaluate(variable_columns, begin, end, result.data() + begin);
                             }, ThreadPool::PoolLevel::HIGH));
 
                             F[0] += result;
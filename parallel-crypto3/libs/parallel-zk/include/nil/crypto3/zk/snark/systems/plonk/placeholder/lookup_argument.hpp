@@ -42,6 +42,7 @@
 #include <nil/crypto3/math/polynomial/shift.hpp>
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
 #include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
+#include <nil/crypto3/math/algorithms/batch_inversion.hpp>
 
 #include <nil/crypto3/hash/sha2.hpp>
 
@@ -52,6 +53,8 @@
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/params.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/detail/placeholder_policy.hpp>
 #include <nil/crypto3/zk/snark/systems/plonk/placeholder/preprocessor.hpp>
+#include <nil/crypto3/zk/math/expression_compiler.hpp>
+#include <nil/crypto3/zk/math/expression_visitors.hpp>
 
 #include <nil/crypto3/bench/scoped_profiler.hpp>
 
@@ -275,11 +278,8 @@ namespace nil {
 
                             // Inverse the values of reduced-hs in-place.
                             parallel_for(0, lookup_alphas.size(), [&reduced_hs, this](std::size_t i) {
-                                parallel_for(0, this->preprocessed_data.common_data.desc.usable_rows_amount,
-                                    [&reduced_hs, i](std::size_t j) {
-                                        reduced_hs[i][j] = reduced_hs[i][j].inversed();
-                                    },
-                                    ThreadPool::PoolLevel::LOW);
+                                math::batch_inversion(reduced_hs[i].begin(),
+                                    reduced_hs[i].begin() + this->preprocessed_data.common_data.desc.usable_rows_amount);
                                 },
                                 ThreadPool::PoolLevel::HIGH);
 
@@ -443,8 +443,10 @@ namespace nil {
                         V_L[0] = FieldType::value_type::one();
                         auto one = FieldType::value_type::one();
 
+                        std::vector<typename FieldType::value_type> h_tmps(
+                            preprocessed_data.common_data.desc.usable_rows_amount + 1, FieldType::value_type::one());
                         parallel_for(1, preprocessed_data.common_data.desc.usable_rows_amount + 1,
-                                [&one, &beta, &V_L, &reduced_input, &reduced_value, &sorted, &gamma](std::size_t k) {
+                                [&one, &beta, &V_L, &h_tmps, &reduced_input, &reduced_value, &sorted, &gamma](std::size_t k) {
                             typename FieldType::value_type g_tmp = (one + beta).pow(reduced_input.size());
                             for (std::size_t i = 0; i < reduced_input.size(); i++) {
                                 g_tmp *= gamma + reduced_input[i][k-1];
@@ -461,13 +463,16 @@ namespace nil {
                             for (std::size_t i = 0; i < sorted.size(); i++) {
                                 h_tmp *= part1 + sorted[i][k-1] + beta * sorted[i][k];
                             }
-                            V_L[k] *= h_tmp.inversed();
+                            h_tmps[k] = h_tmp;
                         }, ThreadPool::PoolLevel::HIGH);
 
-                        // TODO(martun): we can parallize the lower loop as well, but it's fast enough to ignore for now.
-                        for (std::size_t k = 1; k <= preprocessed_data.common_data.desc.usable_rows_amount; k++) {
-                            V_L[k] *= V_L[k-1];
-                        }
+                        math::batch_inversion(h_tmps.begin() + 1, h_tmps.end());
+                        parallel_for(1, preprocessed_data.common_data.desc.usable_rows_amount + 1,
+                            [&V_L, &h_tmps](std::size_t k) {
+                                V_L[k] *= h_tmps[k];
+                            }, ThreadPool::PoolLevel::LOW);
+
+                        parallel_prefix_product(V_L.begin(), V_L.begin() + preprocessed_data.common_data.desc.usable_rows_amount + 1);
 
                         return V_L;
                     }
@@ -533,45 +538,14 @@ namespace nil {
                             std::size_t lookup_inputs_used = lookup_input_ptr->size();
                             lookup_input_ptr->resize(lookup_inputs_used + gate.constraints.size());
 
-                            // Do NOT capture converter by reference.
                             parallel_for(0, gate.constraints.size(),
                                 [&lookup_input_ptr, this, &gate, &lookup_selector, lookup_inputs_used](std::size_t index) {
-                                    // Create the converter.
-                                    auto value_type_to_polynomial_dfs = [](const typename VariableType::assignment_type& coeff) {
-                                        return polynomial_dfs_type(0, 1, coeff);
-                                    };
-                                    math::expression_variable_type_converter<VariableType, DfsVariableType> converter(value_type_to_polynomial_dfs);
-
                                     const auto& constraint = gate.constraints[index];
                                     polynomial_dfs_type l = lookup_selector * (typename FieldType::value_type(constraint.table_id));
 
                                     typename FieldType::value_type theta_acc = this->theta;
                                     for(std::size_t k = 0; k < constraint.lookup_input.size(); k++){
-                                        math::expression<DfsVariableType> expr = converter.convert(constraint.lookup_input[k]);
-
-                                        // For each variable with a rotation pre-compute its value.
-                                        std::unordered_map<polynomial_dfs_variable_type, polynomial_dfs_type> rotated_variable_values;
-
-                                        math::expression_for_each_variable_visitor<polynomial_dfs_variable_type> visitor(
-                                            [&rotated_variable_values, &assignments=plonk_columns, &domain=basic_domain]
-                                            (const polynomial_dfs_variable_type& var) {
-                                                if (var.rotation == 0)
-                                                    return;
-                                                rotated_variable_values[var] = assignments.get_variable_value(var, domain);
-                                        });
-                                        visitor.visit(expr);
-
-                                        math::cached_expression_evaluator<DfsVariableType> evaluator(expr,
-                                            [&domain=basic_domain, &assignments=plonk_columns, &rotated_variable_values]
-                                            (const polynomial_dfs_variable_type &var) -> const polynomial_dfs_type& {
-                                                if (var.rotation == 0) {
-                                                    return assignments.get_variable_value_without_rotation(var);
-                                                }
-                                                return rotated_variable_values[var];
-                                            }
-                                        );
-
-                                        l += theta_acc * lookup_selector * evaluator.evaluate();
+                                        l += theta_acc * lookup_selector * evaluate_lookup_input(constraint.lookup_input[k]);
                                         theta_acc *= this->theta;
                                     }
                                     (*lookup_input_ptr)[lookup_inputs_used + index] = l;
@@ -583,6 +557,52 @@ namespace nil {
 
                 private:
 
+                    /**
+                     * Computes lookup input expression 'expr' as a polynomial. Its variables are extended to a domain
+                     * large enough for the degree of the expression, then the compiled expression is evaluated on the
+                     * rows of that domain block by block. Uses the LOW level thread pool.
+                     */
+                    polynomial_dfs_type evaluate_lookup_input(const math::expression<VariableType>& expr) {
+                        math::expression_compiler<VariableType> compiler;
+                        const math::compiled_expression<VariableType> program = compiler.compile(expr);
+
+                        std::vector<polynomial_dfs_type> columns;
+                        std::size_t max_column_degree = 0;
+                        for (const VariableType& var : program.variables()) {
+                            DfsVariableType var_dfs(var.index, var.rotation, var.relative,
+                                static_cast<typename DfsVariableType::column_type>(static_cast<std::uint8_t>(var.type)));
+                            if (var.rotation == 0) {
+                                columns.push_back(plonk_columns.get_variable_value_without_rotation(var_dfs));
+                            } else {
+                                columns.push_back(plonk_columns.get_variable_value(var_dfs, basic_domain));
+                            }
+                            max_column_degree = std::max(max_column_degree, columns.back().degree());
+                        }
+
+                        math::expression_max_degree_visitor<VariableType> degree_visitor;
+                        const std::size_t degree = degree_visitor.compute_max_degree(expr) * max_column_degree;
+                        const std::size_t extended_size = std::max(
+                            basic_domain->m, math::detail::power_of_two(degree + 1));
+
+                        std::vector<const typename FieldType::value_type*> column_values;
+                        if (!columns.empty()) {
+                            std::shared_ptr<math::evaluation_domain<FieldType>> extended_domain =
+                                math::make_evaluation_domain<FieldType>(extended_size);
+                            for (auto& column : columns) {
+                                column.resize(extended_size, basic_domain, extended_domain);
+                                column_values.push_back(column.data());
+                            }
+                        }
+
+                        polynomial_dfs_type result(degree, extended_size);
+                        wait_for_all(parallel_run_in_chunks<void>(
+                            extended_size,
+                            [&program, &column_values, &result](std::size_t begin, std::size_t end) {
+                                program.evaluate(column_values, begin, end, result.data() + begin);
+                            }, ThreadPool::PoolLevel::LOW));
+                        return result;
+                    }
+
                     polynomial_dfs_type reduce_dfs_polynomial_domain(
                         const polynomial_dfs_type &polynomial,
                         const std::size_t &new_domain_size
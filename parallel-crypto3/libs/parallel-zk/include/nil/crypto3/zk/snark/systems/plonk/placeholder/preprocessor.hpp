@@ -32,11 +32,14 @@
 #error "You're mixing parallel and non-parallel crypto3 versions"
 #endif
 
+#include <algorithm>
 #include <set>
 #include <iostream>
 #include <sstream>
 #include <string>
 #include <map>
+#include <numeric>
+#include <limits>
 #include <vector>
 
 #include <nil/crypto3/math/algorithms/unity_root.hpp>
@@ -58,6 +61,8 @@
 
 #include <nil/crypto3/bench/scoped_profiler.hpp>
 
+#include <nil/actor/core/parallelization_utils.hpp>
+
 namespace nil {
     namespace crypto3 {
         namespace zk {
@@ -325,83 +330,116 @@ namespace nil {
                         return f;
                     }
 
+                public:
+                    // Cycles of the copy-constraint permutation over the table cells. Only the columns which occur in
+                    // copy constraints are materialised, the cells of all the other columns are fixed points.
+                    // Cells are addressed densely as 'slot * rows_amount + row', where 'slot' is the position of the
+                    // column among the materialised ones. Public for the tests only.
                     struct cycle_representation {
                         // Using std::uint32_t reduces RAM usage a bit. Our table size (rows_amount * width) will never be > 2^32 elements.
                         typedef std::pair<std::uint32_t, std::uint32_t> key_type;
 
-                        std::map<key_type, key_type> _mapping;
-                        std::map<key_type, key_type> _aux;
-                        std::map<key_type, std::uint32_t> _sizes;
+                        static constexpr std::uint32_t NOT_MATERIALISED = std::numeric_limits<std::uint32_t>::max();
+
+                        std::uint32_t _rows_amount;
+                        // Global column index -> slot, or NOT_MATERIALISED.
+                        std::vector<std::uint32_t> _column_slots;
+                        // Slot -> global column index.
+                        std::vector<std::uint32_t> _columns;
+
+                        // Cell -> the next cell of its cycle.
+                        std::vector<std::uint32_t> _mapping;
+                        // Union-find forest over the cells, each tree is one cycle.
+                        std::vector<std::uint32_t> _parents;
+                        std::vector<std::uint32_t> _sizes;
 
                         cycle_representation(
                             const plonk_constraint_system<FieldType>  &constraint_system,
                             const plonk_table_description<FieldType> &table_description
-                        ) {
-                            for (std::size_t i = 0;
-                                 i < table_description.table_width() - table_description.selector_columns;
-                                 i++) {
-                                for (std::size_t j = 0; j < table_description.rows_amount; j++) {
-                                    key_type key(i, j);
-                                    this->_mapping[key] = key;
-                                    this->_aux[key] = key;
-                                    this->_sizes[key] = 1;
-                                }
-                            }
+                        ) : _rows_amount(table_description.rows_amount),
+                            _column_slots(table_description.table_width(), NOT_MATERIALISED) {
 
                             std::vector<plonk_copy_constraint<FieldType>> copy_constraints =
                                 constraint_system.copy_constraints();
-                            for (std::size_t i = 0; i < copy_constraints.size(); i++) {
-                                std::size_t x_idx = table_description.global_index(copy_constraints[i].first);
-                                key_type x = key_type(x_idx, copy_constraints[i].first.rotation);
 
-                                std::size_t y_idx = table_description.global_index(copy_constraints[i].second);
-                                key_type y = key_type(y_idx, copy_constraints[i].second.rotation);
+                            for (const auto &constraint : copy_constraints) {
+                                _column_slots[table_description.global_index(constraint.first)] = 0;
+                                _column_slots[table_description.global_index(constraint.second)] = 0;
+                            }
+                            for (std::size_t i = 0; i < _column_slots.size(); i++) {
+                                if (_column_slots[i] != NOT_MATERIALISED) {
+                                    _column_slots[i] = _columns.size();
+                                    _columns.push_back(i);
+                                }
+                            }
+
+                            std::size_t cells_amount = _columns.size() * _rows_amount;
+                            BOOST_ASSERT(cells_amount < NOT_MATERIALISED);
+                            _mapping.resize(cells_amount);
+                            _parents.resize(cells_amount);
+                            _sizes.resize(cells_amount);
+
+                            wait_for_all(parallel_run_in_chunks<void>(
+                                cells_amount,
+                                [this](std::size_t begin, std::size_t end) {
+                                    std::iota(_mapping.begin() + begin, _mapping.begin() + end, begin);
+                                    std::iota(_parents.begin() + begin, _parents.begin() + end, begin);
+                                    std::fill(_sizes.begin() + begin, _sizes.begin() + end, 1);
+                                }, ThreadPool::PoolLevel::LOW));
+
+                            for (const auto &constraint : copy_constraints) {
+                                std::uint32_t x = cell(table_description.global_index(constraint.first),
+                                                       constraint.first.rotation);
+                                std::uint32_t y = cell(table_description.global_index(constraint.second),
+                                                       constraint.second.rotation);
                                 this->apply_copy_constraint(x, y);
                             }
                         }
 
-                        void apply_copy_constraint(key_type x, key_type y) {
+                        std::uint32_t cell(std::size_t column, std::size_t row) const {
+                            BOOST_ASSERT(_column_slots[column] != NOT_MATERIALISED);
+                            BOOST_ASSERT(row < _rows_amount);
+                            return _column_slots[column] * _rows_amount + row;
+                        }
 
-                            if (!_mapping.count(x)) {
-                                _mapping[x] = x;
-                                _aux[x] = x;
-                                _sizes[x] = 1;
+                        std::uint32_t find(std::uint32_t x) {
+                            // Path halving.
+                            while (_parents[x] != x) {
+                                _parents[x] = _parents[_parents[x]];
+                                x = _parents[x];
                             }
+                            return x;
+                        }
 
-                            if (!_mapping.count(y)) {
-                                _mapping[y] = y;
-                                _aux[y] = y;
-                                _sizes[y] = 1;
+                        // Merges the cycles of x and y, by swapping their successors.
+                        void apply_copy_constraint(std::uint32_t x, std::uint32_t y) {
+                            std::uint32_t x_root = find(x);
+                            std::uint32_t y_root = find(y);
+                            if (x_root == y_root) {
+                                return;
                             }
 
-                            if (_aux[x] != _aux[y]) {
-                                key_type &left = x;
-                                key_type &right = y;
-                                if (_sizes[_aux[left]] < _sizes[_aux[right]]) {
-                                    std::swap(left, right);
-                                }
-
-                                _sizes[_aux[left]] = _sizes[_aux[left]] + _sizes[_aux[right]];
-
-                                key_type z = _aux[right];
-                                key_type exit_condition = _aux[right];
-
-                                do {
-                                    _aux[z] = _aux[left];
-                                    z = _mapping[z];
-                                } while (z != exit_condition);
-
-                                key_type tmp = _mapping[left];
-                                _mapping[left] = _mapping[right];
-                                _mapping[right] = tmp;
+                            if (_sizes[x_root] < _sizes[y_root]) {
+                                std::swap(x_root, y_root);
                             }
+                            _parents[y_root] = x_root;
+                            _sizes[x_root] += _sizes[y_root];
+
+                            std::swap(_mapping[x], _mapping[y]);
                         }
 
-                        key_type &operator[](key_type key) {
-                            return _mapping[key];
+                        // Returns the (column, row) the given cell is mapped to. Safe to call concurrently.
+                        key_type operator[](key_type key) const {
+                            if (key.first >= _column_slots.size() || _column_slots[key.first] == NOT_MATERIALISED) {
+                                return key;
+                            }
+                            std::uint32_t mapped = _mapping[cell(key.first, key.second)];
+                            return key_type(_columns[mapped / _rows_amount], mapped % _rows_amount);
                         }
                     };
 
+                private:
+
                     static inline std::shared_ptr<plonk_public_polynomial_dfs_table<FieldType>> convert_public_table(
                         std::shared_ptr<public_assignment_type> public_assignment,
                         std::shared_ptr<math::evaluation_domain<FieldType>> basic_domain
@@ -495,9 +533,8 @@ namespace nil {
                                 domain->size() - 1, domain->size(), FieldType::value_type::zero());
 
                             S_id[i][0] = delta.pow(i);
-                            for (std::size_t j = 1; j < domain->size(); j++) {
-                                S_id[i][j] = S_id[i][j-1] * omega;
-                             }
+                            std::fill(S_id[i].begin() + 1, S_id[i].end(), omega);
+                            parallel_prefix_product(S_id[i].begin(), S_id[i].end());
                         }
 
                         return S_id;
@@ -511,21 +548,41 @@ namespace nil {
                         const plonk_table_description<FieldType>& table_description,
                         std::shared_ptr<math::evaluation_domain<FieldType>> domain
                     ) {
-                        // TODO: add std::vector<std::size_t> columns_with_copy_constraints;
                         cycle_representation permutation(constraint_system, table_description);
 
-                        std::vector<polynomial_dfs_type> S_perm(global_indices.size());
+                        // Position of every global column in 'global_indices', columns outside of it get
+                        // global_indices.size().
+                        std::vector<std::size_t> permuted_indices(table_description.table_width(), global_indices.size());
                         for (std::size_t i = 0; i < global_indices.size(); i++) {
-                            S_perm[i] = polynomial_dfs_type(
-                                domain->size() - 1, domain->size(), FieldType::value_type::zero());
-
-                            for (std::size_t j = 0; j < domain->size(); j++) {
-                                auto key = std::make_pair(global_indices[i], j);
-                                auto permuted_index = find(global_indices.begin(), global_indices.end(), permutation[key].first) - global_indices.begin();
-                                S_perm[i][j] = delta.pow(permuted_index) * omega.pow(permutation[key].second);
-                            }
+                            permuted_indices[global_indices[i]] = i;
                         }
 
+                        // delta^i for every position i in 'global_indices', plus delta^global_indices.size() for a
+                        // cell mapped to a column outside of it. That happens if a copy constraint refers to such a
+                        // column, the position search used to give global_indices.size() for it too.
+                        std::vector<typename FieldType::value_type> delta_powers(global_indices.size() + 1, delta);
+                        delta_powers[0] = FieldType::value_type::one();
+                        parallel_prefix_product(delta_powers.begin(), delta_powers.end());
+
+                        std::vector<typename FieldType::value_type> omega_powers(domain->size(), omega);
+                        omega_powers[0] = FieldType::value_type::one();
+                        parallel_prefix_product(omega_powers.begin(), omega_powers.end());
+
+                        std::vector<polynomial_dfs_type> S_perm(global_indices.size());
+                        parallel_for(0, global_indices.size(),
+                            [&S_perm, &global_indices, &permutation, &permuted_indices, &delta_powers, &omega_powers,
+                                    &domain](std::size_t i) {
+                                S_perm[i] = polynomial_dfs_type(
+                                    domain->size() - 1, domain->size(), FieldType::value_type::zero());
+
+                                parallel_for(0, domain->size(),
+                                    [&S_perm, &global_indices, &permutation, &permuted_indices, &delta_powers,
+                                            &omega_powers, i](std::size_t j) {
+                                        auto key = permutation[typename cycle_representation::key_type(global_indices[i], j)];
+                                        S_perm[i][j] = delta_powers[permuted_indices[key.first]] * omega_powers[key.second];
+                                    }, ThreadPool::PoolLevel::LOW);
+                            }, ThreadPool::PoolLevel::HIGH);
+
                         return S_perm;
                     }
 
@@ -52,6 +52,9 @@
 
 #include <nil/crypto3/bench/scoped_profiler.hpp>
 
+#include <nil/actor/core/thread_pool.hpp>
+#include <nil/actor/core/parallelization_utils.hpp>
+
 namespace nil {
     namespace crypto3 {
         namespace zk {
@@ -72,6 +75,48 @@ namespace nil {
                         }
                         return f_splitted;
                     }
+
+                    // Divides f by the vanishing polynomial X^n - 1 and returns the quotient split into chunks of n
+                    // coefficients, same as split_polynomial(f / Z, n - 1) would. Chunk 'j' of the quotient is
+                    // the sum of all the chunks of f above 'j + 1', so it is computed with one pass over the
+                    // coefficients which is parallel over the offset inside the chunk. The remainder is dropped.
+                    template<typename FieldType>
+                    static inline std::vector<math::polynomial<typename FieldType::value_type>>
+                        split_quotient_by_vanishing_polynomial(const math::polynomial<typename FieldType::value_type> &f,
+                                                               std::size_t n) {
+                        PROFILE_SCOPE("split_quotient_by_vanishing_polynomial_time");
+
+                        typedef math::polynomial<typename FieldType::value_type> polynomial_type;
+
+                        // Degree of f is less than n, the quotient is zero.
+                        if (f.size() <= n) {
+                            return {polynomial_type(f.size())};
+                        }
+
+                        std::size_t quotient_size = f.size() - n;
+                        std::size_t chunks_count = (quotient_size + n - 1) / n;
+                        std::vector<polynomial_type> f_splitted(chunks_count);
+                        for (std::size_t j = 0; j < chunks_count; j++) {
+                            f_splitted[j] = polynomial_type(std::min(n, quotient_size - j * n));
+                        }
+
+                        wait_for_all(parallel_run_in_chunks<void>(
+                            n,
+                            [&f, &f_splitted, n, chunks_count](std::size_t begin, std::size_t end) {
+                                for (std::size_t j = chunks_count; j-- > 0;) {
+                                    polynomial_type &chunk = f_splitted[j];
+                                    std::size_t chunk_end = std::min(end, chunk.size());
+                                    for (std::size_t i = begin; i < chunk_end; i++) {
+                                        chunk[i] = f[(j + 1) * n + i];
+                                        if (j + 1 < chunks_count && i < f_splitted[j + 1].size()) {
+                                            chunk[i] += f_splitted[j + 1][i];
+                                        }
+                                    }
+                                }
+                            }, ThreadPool::PoolLevel::LOW));
+
+                        return f_splitted;
+                    }
                 }    // namespace detail
 
                 template<typename FieldType, typename ParamsType>
@@ -243,9 +288,8 @@ namespace nil {
                     std::vector<polynomial_dfs_type> quotient_polynomial_split_dfs() {
                         PROFILE_SCOPE("quotient_polynomial_split_dfs");
 
-                        // TODO: pass max_degree parameter placeholder
-                        std::vector<polynomial_type> T_splitted = detail::split_polynomial<FieldType>(
-                            quotient_polynomial(), table_description.rows_amount - 1
+                        std::vector<polynomial_type> T_splitted = detail::split_quotient_by_vanishing_polynomial<FieldType>(
+                            consolidated_polynomial(), table_description.rows_amount
                         );
 
                         std::size_t split_polynomial_size = std::max(
@@ -284,8 +328,9 @@ namespace nil {
                         return T_splitted_dfs;
                     }
 
-                    polynomial_type quotient_polynomial() {
-                        PROFILE_SCOPE("quotient_polynomial_time");
+                    // Returns F_consolidated in coefficients form, the quotient polynomial is F_consolidated / Z.
+                    polynomial_type consolidated_polynomial() {
+                        PROFILE_SCOPE("consolidated_polynomial_time");
 
                         // 7.1. Get $\alpha_0, \dots, \alpha_8 \in \mathbb{F}$ from $hash(\text{transcript})$
                         std::array<typename FieldType::value_type, f_parts> alphas =
@@ -304,12 +349,7 @@ namespace nil {
 
                         polynomial_dfs_type F_consolidated_dfs = polynomial_sum<FieldType>(std::move(F_consolidated_dfs_parts));
 
-                        polynomial_type F_consolidated_normal(F_consolidated_dfs.coefficients());
-
-                        polynomial_type T_consolidated =
-                            F_consolidated_normal / preprocessed_public_data.common_data.Z;
-
-                        return T_consolidated;
+                        return polynomial_type(F_consolidated_dfs.coefficients());
                     }
 
                     typename placeholder_lookup_argument_prover<FieldType, commitment_scheme_type, ParamsType>::prover_lookup_result
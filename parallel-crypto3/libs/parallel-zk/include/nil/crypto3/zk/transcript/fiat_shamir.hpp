@@ -213,14 +213,24 @@ namespace nil {
                     template<typename Integral>
                     Integral int_challenge() {
                         state = hash<hash_type>(state);
+                        return int_challenge_of_state<Integral>(state);
+                    }
+
+                    // The value int_challenge() returns once the state becomes 'new_state'.
+                    template<typename Integral>
+                    static Integral int_challenge_of_state(const typename hash_type::digest_type &new_state) {
                         nil::crypto3::marshalling::status_type status;
-                        big_uint_of_hash_size raw_result = nil::crypto3::marshalling::pack(state, status);
+                        big_uint_of_hash_size raw_result = nil::crypto3::marshalling::pack(new_state, status);
                         // If we remove the next line, raw_result is a much larger number, conversion to 'Integral' will overflow
                         // and in debug mode an assert will fire. In release mode nothing will change.
                         raw_result &= ~Integral(0);
                         return static_cast<Integral>(raw_result);
                     }
 
+                    const typename hash_type::digest_type &get_state() const {
+                        return state;
+                    }
+
                     template<typename Field, std::size_t N>
                     // typename std::enable_if<(Hash::digest_bits >= Field::modulus_bits),
                     //                         std::array<typename Field::value_type, N>>::type
@@ -54,6 +54,10 @@
 #include <nil/crypto3/zk/commitments/type_traits.hpp>
 
 #include <nil/crypto3/random/algebraic_random_device.hpp>
+#include <nil/crypto3/random/algebraic_engine.hpp>
+
+#include <nil/marshalling/endianness.hpp>
+#include <nil/crypto3/marshalling/zk/types/commitments/fri.hpp>
 
 using namespace nil::crypto3;
 
@@ -81,7 +85,7 @@ inline std::vector<std::size_t> generate_random_step_list(const std::size_t r, c
 
 BOOST_AUTO_TEST_SUITE(fri_test_suite)
 
-template<typename FieldType, typename PolynomialType>
+template<typename FieldType, typename PolynomialType, bool UseMerkleMultiproofs = false>
 void fri_basic_test()
 {
     // setup
@@ -115,7 +119,8 @@ void fri_basic_test()
             lambda,
             2, //expand_factor
             true, // use_grinding
-            16 // grinding_parameter
+            16, // grinding_parameter
+            UseMerkleMultiproofs
             );
 
     BOOST_CHECK(D[1]->m == D[0]->m / 2);
@@ -156,6 +161,44 @@ void fri_basic_test()
     typename FieldType::value_type prover_next_challenge = transcript.template challenge<FieldType>();
     BOOST_CHECK(verifier_next_challenge == prover_next_challenge);
 
+    BOOST_CHECK(proof.use_merkle_multiproofs == UseMerkleMultiproofs);
+    if constexpr (UseMerkleMultiproofs) {
+        BOOST_CHECK(proof.round_multiproofs.size() == params.step_list.size());
+
+        // The opened values are only checked against the multiproofs after all the queries.
+        proof_type wrong_proof = proof;
+        wrong_proof.query_proofs[0].initial_proof.begin()->second.values[0][0][0] += 1u;
+        zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript_wrong(init_blob);
+        BOOST_CHECK(!zk::algorithms::verify_eval<fri_type>(wrong_proof, root, params, transcript_wrong));
+
+        // A multiproof for a tree of another shape is rejected even if it is consistent by itself.
+        wrong_proof = proof;
+        const auto &round_multiproof = proof.round_multiproofs[0];
+        wrong_proof.round_multiproofs[0] = typename fri_type::merkle_multiproof_type(
+            2 * round_multiproof.leaves(), round_multiproof.root(), round_multiproof.hashes());
+        zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript_wrong_leaves(init_blob);
+        BOOST_CHECK(!zk::algorithms::verify_eval<fri_type>(wrong_proof, root, params, transcript_wrong_leaves));
+
+        // The multiproofs survive marshalling.
+        using Endianness = nil::crypto3::marshalling::option::big_endian;
+        using TTypeBase = nil::crypto3::marshalling::field_type<Endianness>;
+        nil::crypto3::marshalling::types::batch_info_type batch_info;
+        batch_info[0] = 1;
+        auto filled_proof = nil::crypto3::marshalling::types::fill_fri_proof<Endianness, fri_type>(
+            proof, batch_info, params);
+        std::vector<std::uint8_t> cv(filled_proof.length(), 0x00);
+        auto write_iter = cv.begin();
+        BOOST_CHECK(filled_proof.write(write_iter, cv.size()) == nil::crypto3::marshalling::status_type::success);
+
+        typename nil::crypto3::marshalling::types::fri_proof<TTypeBase, fri_type>::type read_proof;
+        auto read_iter = cv.begin();
+        BOOST_CHECK(read_proof.read(read_iter, cv.size()) == nil::crypto3::marshalling::status_type::success);
+        proof_type constructed_proof = nil::crypto3::marshalling::types::make_fri_proof<Endianness, fri_type>(
+            read_proof, batch_info);
+        BOOST_CHECK(constructed_proof == proof);
+        zk::transcript::fiat_shamir_heuristic_sequential<transcript_hash_type> transcript_read(init_blob);
+        BOOST_CHECK(zk::algorithms::verify_eval<fri_type>(constructed_proof, root, params, transcript_read));
+    }
 }
 
 BOOST_AUTO_TEST_CASE(fri_basic_test_polynomial) {
@@ -176,5 +219,62 @@ BOOST_AUTO_TEST_CASE(fri_basic_test_polynomial_dfs) {
     fri_basic_test<FieldType, PolynomialType>();
 }
 
+BOOST_AUTO_TEST_CASE(fri_basic_test_merkle_multiproofs) {
+
+    using curve_type = algebra::curves::pallas;
+    using FieldType = typename curve_type::base_field_type;
+
+    fri_basic_test<FieldType, math::polynomial<FieldType::value_type>, true>();
+    fri_basic_test<FieldType, math::polynomial_dfs<FieldType::value_type>, true>();
+}
+
+// Recomputing the rounds in the query phase must give the same proof as keeping them.
+template<typename FieldType, typename PolynomialType, bool UseMerkleMultiproofs>
+void fri_recompute_rounds_test() {
+    typedef hashes::sha2<256> hash_type;
+    typedef zk::commitments::fri<FieldType, hash_type, hash_type, 2> fri_type;
+    typedef typename fri_type::params_type params_type;
+
+    constexpr static const std::size_t d = 64;
+    std::size_t degree_log = boost::static_log2<d>::value;
+    std::vector<std::size_t> step_list = {2, 2, 1};
+    params_type params(step_list, degree_log, 20, 2, false, 16, UseMerkleMultiproofs, false);
+    params_type recompute_params(step_list, degree_log, 20, 2, false, 16, UseMerkleMultiproofs, true);
+
+    nil::crypto3::random::algebraic_engine<FieldType> engine(1);
+    std::vector<typename FieldType::value_type> coefficients(d);
+    for (auto &c : coefficients) {
+        c = engine();
+    }
+    PolynomialType f;
+    if constexpr (std::is_same<math::polynomial_dfs<typename FieldType::value_type>, PolynomialType>::value) {
+        f.from_coefficients(coefficients);
+        f.resize(params.D[0]->size(), nullptr, params.D[0]);
+    } else {
+        f = PolynomialType(coefficients);
+    }
+
+    typename fri_type::merkle_tree_type tree = zk::algorithms::precommit<fri_type>(f, params.D[0], step_list[0]);
+    auto root = zk::algorithms::commit<fri_type>(tree);
+
+    std::vector<std::uint8_t> init_blob{0u, 1u, 2u, 3u};
+    zk::transcript::fiat_shamir_heuristic_sequential<hash_type> transcript(init_blob);
+    auto proof = zk::algorithms::proof_eval<fri_type>(f, tree, params, transcript);
+    zk::transcript::fiat_shamir_heuristic_sequential<hash_type> recompute_transcript(init_blob);
+    auto recomputed_proof = zk::algorithms::proof_eval<fri_type>(f, tree, recompute_params, recompute_transcript);
+
+    BOOST_CHECK(proof == recomputed_proof);
+    zk::transcript::fiat_shamir_heuristic_sequential<hash_type> transcript_verifier(init_blob);
+    BOOST_CHECK(zk::algorithms::verify_eval<fri_type>(recomputed_proof, root, params, transcript_verifier));
+}
+
+BOOST_AUTO_TEST_CASE(fri_recompute_rounds) {
+    using FieldType = typename algebra::curves::pallas::base_field_type;
+
+    fri_recompute_rounds_test<FieldType, math::polynomial<FieldType::value_type>, false>();
+    fri_recompute_rounds_test<FieldType, math::polynomial_dfs<FieldType::value_type>, false>();
+    fri_recompute_rounds_test<FieldType, math::polynomial_dfs<FieldType::value_type>, true>();
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
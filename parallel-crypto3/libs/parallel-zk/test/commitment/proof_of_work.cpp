@@ -95,4 +95,28 @@ BOOST_AUTO_TEST_SUITE(proof_of_knowledge_test_suite)
         BOOST_ASSERT(!hard_pow_type::verify(old_transcript_1, result, grinding_bits));
     }
 
+    BOOST_AUTO_TEST_CASE(pow_smallest_nonce_test) {
+        using keccak = nil::crypto3::hashes::keccak_1600<256>;
+        using pow_type = nil::crypto3::zk::commitments::proof_of_work<keccak, std::uint32_t>;
+
+        const std::size_t grinding_bits = 10;
+        const std::uint32_t mask = (1u << grinding_bits) - 1;
+
+        for (std::uint8_t seed = 0; seed < 8; ++seed) {
+            nil::crypto3::zk::transcript::fiat_shamir_heuristic_sequential<keccak> transcript(
+                std::vector<std::uint8_t>{seed});
+            auto old_transcript_1 = transcript, old_transcript_2 = transcript;
+
+            auto result = pow_type::generate(transcript, grinding_bits);
+            BOOST_CHECK_EQUAL(result, pow_type::generate(old_transcript_1, grinding_bits));
+
+            // Every smaller nonce fails.
+            for (std::uint32_t nonce = 0; nonce <= result; ++nonce) {
+                auto tmp_transcript = old_transcript_2;
+                tmp_transcript(pow_type::to_byte_array(nonce));
+                BOOST_CHECK_EQUAL((tmp_transcript.template int_challenge<std::uint32_t>() & mask) == 0, nonce == result);
+            }
+        }
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -35,10 +35,12 @@
 
 #include <nil/crypto3/algebra/curves/pallas.hpp>
 #include <nil/crypto3/algebra/fields/arithmetic_params/pallas.hpp>
+#include <nil/crypto3/algebra/random_element.hpp>
 
 #include <nil/crypto3/zk/math/expression.hpp>
 #include <nil/crypto3/zk/math/expression_visitors.hpp>
 #include <nil/crypto3/zk/math/expression_evaluator.hpp>
+#include <nil/crypto3/zk/math/expression_compiler.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/variable.hpp>
 
 using namespace nil::crypto3;
@@ -158,4 +160,112 @@ BOOST_AUTO_TEST_CASE(expression_for_each_variable_visitor_test) {
         expected_rotations.begin(), expected_rotations.end());
 }
 
+BOOST_AUTO_TEST_CASE(expression_compiler_test) {
+
+    // setup
+    using curve_type = algebra::curves::pallas;
+    using FieldType = typename curve_type::base_field_type;
+    using variable_type = typename nil::crypto3::zk::snark::plonk_variable<typename FieldType::value_type>;
+    using value_type = typename variable_type::assignment_type;
+
+    variable_type w0(0, 0, variable_type::column_type::witness);
+    variable_type w1(3, -1, variable_type::column_type::public_input);
+    variable_type w2(4, 1, variable_type::column_type::public_input);
+    variable_type w3(6, 2, variable_type::column_type::constant);
+
+    using expression_type = expression<variable_type>;
+    expression_type a = expression_type(w0) + w1;
+    expression_type b = expression_type(w2) + w3;
+    expression_type c = (expression_type(w0) * w1 + w2).pow(3);
+
+    // Repeated subexpressions, foldable constants and powers.
+    expression_type expr = a * b * expression_type(value_type(3u)) - a * b * expression_type(value_type(10u)) + c +
+        (expression_type(w3) - w3) * w1 + expression_type(w2) * expression_type(1) + expression_type(w1).pow(1) * c;
+
+    expression_compiler<variable_type> compiler;
+    compiled_expression<variable_type> program = compiler.compile(expr);
+    BOOST_CHECK_EQUAL(program.variables().size(), 4);
+
+    // a, b, a * b and the sum.
+    BOOST_CHECK_EQUAL(compiler.compile(a * b + a * b).instructions().size(), 4);
+    // Folds to w2.
+    BOOST_CHECK_EQUAL(compiler.compile((expression_type(w3) - w3) * w1 + w2).instructions().size(), 0);
+
+    // More rows than a block, and not a multiple of the block size.
+    const std::size_t rows = 2 * compiled_expression<variable_type>::BLOCK_SIZE + 7;
+    std::vector<std::vector<value_type>> columns(program.variables().size(), std::vector<value_type>(rows));
+    std::vector<const value_type*> column_pointers;
+    for (auto& column : columns) {
+        for (auto& value : column) {
+            value = algebra::random_element<FieldType>();
+        }
+        column_pointers.push_back(column.data());
+    }
+
+    const std::size_t begin = 5;
+    std::vector<value_type> result(rows - begin);
+    program.evaluate(column_pointers, begin, rows, result.data());
+
+    for (std::size_t j = begin; j < rows; ++j) {
+        expression_evaluator<variable_type> evaluator(
+            expr,
+            [&program, &columns, j](const variable_type& var) -> const value_type& {
+                const auto& variables = program.variables();
+                return columns[std::find(variables.begin(), variables.end(), var) - variables.begin()][j];
+            }
+        );
+        BOOST_CHECK(result[j - begin] == evaluator.evaluate());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(expression_compiler_backends_test) {
+
+    // setup
+    using curve_type = algebra::curves::pallas;
+    using FieldType = typename curve_type::base_field_type;
+    using variable_type = typename nil::crypto3::zk::snark::plonk_variable<typename FieldType::value_type>;
+    using value_type = typename variable_type::assignment_type;
+    using program_type = compiled_expression<variable_type>;
+
+    variable_type w0(0, 0, variable_type::column_type::witness);
+    variable_type w1(1, 0, variable_type::column_type::witness);
+    variable_type w2(2, 1, variable_type::column_type::witness);
+
+    using expression_type = expression<variable_type>;
+    expression_type expr = (expression_type(w0) * w1 - w2).pow(5) + expression_type(value_type(7u)) * w0 -
+        expression_type(w2).pow(2) * w1 + (expression_type(w1) + w0).pow(3);
+    program_type program = expression_compiler<variable_type>().compile(expr);
+
+    const std::size_t rows = 3 * program_type::BLOCK_SIZE + 11;
+    std::vector<std::vector<value_type>> columns(program.variables().size(), std::vector<value_type>(rows));
+    std::vector<const value_type*> column_pointers;
+    for (auto& column : columns) {
+        for (auto& value : column) {
+            value = algebra::random_element<FieldType>();
+        }
+        column_pointers.push_back(column.data());
+    }
+    columns[0][0] = value_type::zero();
+    columns[1][1] = -value_type::one();
+
+    const std::size_t begin = 3;
+    std::vector<value_type> expected(rows - begin);
+    program.evaluate(column_pointers, begin, rows, expected.data(), limb_major_backend::scalar);
+
+    using limb_major_type = limb_major_montgomery<value_type, program_type::BLOCK_SIZE>;
+    for (limb_major_backend backend :
+         {limb_major_backend::avx2, limb_major_backend::avx512, limb_major_backend::avx512_ifma}) {
+        if (!limb_major_type::is_available(backend)) {
+            continue;
+        }
+        std::vector<value_type> result(rows - begin);
+        program.evaluate(column_pointers, begin, rows, result.data(), backend);
+        BOOST_CHECK(result == expected);
+    }
+
+    std::vector<value_type> result(rows - begin);
+    program.evaluate(column_pointers, begin, rows, result.data());
+    BOOST_CHECK(result == expected);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -32,6 +32,9 @@
 
 #define BOOST_TEST_MODULE placeholder_permutation_test
 
+#include <map>
+#include <numeric>
+
 #include <boost/test/unit_test.hpp>
 #include <boost/test/data/test_case.hpp>
 #include <boost/test/data/monomorphic.hpp>
@@ -69,6 +72,58 @@ using namespace nil::crypto3;
 using namespace nil::crypto3::zk;
 using namespace nil::crypto3::zk::snark;
 
+// The map-based cycle representation the preprocessor used before union-find, kept as the reference.
+// _mapping is the permutation, _aux maps every cell to the representative of its cycle.
+template<typename FieldType>
+struct reference_cycle_representation {
+    typedef std::pair<std::uint32_t, std::uint32_t> key_type;
+
+    std::map<key_type, key_type> _mapping;
+    std::map<key_type, key_type> _aux;
+    std::map<key_type, std::uint32_t> _sizes;
+
+    reference_cycle_representation(
+        const plonk_constraint_system<FieldType> &constraint_system,
+        const plonk_table_description<FieldType> &table_description
+    ) {
+        for (std::size_t i = 0; i < table_description.table_width() - table_description.selector_columns; i++) {
+            for (std::size_t j = 0; j < table_description.rows_amount; j++) {
+                key_type key(i, j);
+                _mapping[key] = key;
+                _aux[key] = key;
+                _sizes[key] = 1;
+            }
+        }
+        for (const auto &constraint : constraint_system.copy_constraints()) {
+            key_type x(table_description.global_index(constraint.first), constraint.first.rotation);
+            key_type y(table_description.global_index(constraint.second), constraint.second.rotation);
+            apply_copy_constraint(x, y);
+        }
+    }
+
+    void apply_copy_constraint(key_type x, key_type y) {
+        if (_aux[x] != _aux[y]) {
+            key_type &left = x;
+            key_type &right = y;
+            if (_sizes[_aux[left]] < _sizes[_aux[right]]) {
+                std::swap(left, right);
+            }
+
+            _sizes[_aux[left]] = _sizes[_aux[left]] + _sizes[_aux[right]];
+
+            key_type z = _aux[right];
+            key_type exit_condition = _aux[right];
+
+            do {
+                _aux[z] = _aux[left];
+                z = _mapping[z];
+            } while (z != exit_condition);
+
+            std::swap(_mapping[left], _mapping[right]);
+        }
+    }
+};
+
 BOOST_AUTO_TEST_SUITE(permutation_argument)
     using curve_type = algebra::curves::bls12<381>;
     using field_type = typename curve_type::scalar_field_type;
@@ -185,6 +240,81 @@ BOOST_AUTO_TEST_SUITE(permutation_argument)
         BOOST_CHECK_MESSAGE(id_res == sigma_res, "Complex check");
     }
 
+    BOOST_FIXTURE_TEST_CASE(cycle_representation_test, test_tools::random_test_initializer<field_type>) {
+        using value_type = typename field_type::value_type;
+        using var = plonk_variable<value_type>;
+        using preprocessor_type = placeholder_public_preprocessor<field_type, lpc_placeholder_params_type>;
+        using cycle_representation = typename preprocessor_type::cycle_representation;
+        using key_type = typename cycle_representation::key_type;
+
+        // The last witness column has no copy constraints, so it is not materialised.
+        const std::size_t rows = 16;
+        plonk_table_description<field_type> desc(4, 2, 1, 1, rows - 3, rows);
+        const std::size_t permuted_columns = desc.table_width() - desc.selector_columns;
+
+        auto random_variable = [this, rows]() {
+            std::size_t kind = generic_random_engine() % 3;
+            std::size_t row = generic_random_engine() % rows;
+            if (kind == 0) {
+                return var(generic_random_engine() % 3, row, false, var::column_type::witness);
+            }
+            if (kind == 1) {
+                return var(generic_random_engine() % 2, row, false, var::column_type::public_input);
+            }
+            return var(0, row, false, var::column_type::constant);
+        };
+
+        // Long chains, cycles closed twice, repeated and trivial constraints.
+        std::vector<plonk_copy_constraint<field_type>> copy_constraints;
+        for (std::size_t i = 0; i < 60; i++) {
+            copy_constraints.emplace_back(random_variable(), random_variable());
+        }
+        for (std::size_t i = 0; i + 1 < rows; i++) {
+            copy_constraints.emplace_back(var(0, i, false, var::column_type::witness),
+                                          var(1, i + 1, false, var::column_type::witness));
+        }
+        copy_constraints.push_back(copy_constraints.front());
+        copy_constraints.emplace_back(var(2, 3, false, var::column_type::witness),
+                                      var(2, 3, false, var::column_type::witness));
+
+        plonk_constraint_system<field_type> constraint_system({}, copy_constraints, {});
+
+        cycle_representation permutation(constraint_system, desc);
+        reference_cycle_representation<field_type> reference(constraint_system, desc);
+
+        for (std::size_t i = 0; i < permuted_columns; i++) {
+            for (std::size_t j = 0; j < rows; j++) {
+                key_type key(i, j);
+                BOOST_CHECK(permutation[key] == reference._mapping[key]);
+                if (permutation._column_slots[i] == cycle_representation::NOT_MATERIALISED) {
+                    BOOST_CHECK(reference._aux[key] == key);
+                    continue;
+                }
+                // Both keep the representative of the larger cycle, and of the first cell on ties.
+                std::uint32_t root = permutation.find(permutation.cell(i, j));
+                key_type representative(permutation._columns[root / rows], root % rows);
+                BOOST_CHECK(representative == reference._aux[key]);
+            }
+        }
+
+        // The sigma polynomials match the ones computed from the reference mapping.
+        std::vector<std::size_t> global_indices(permuted_columns);
+        std::iota(global_indices.begin(), global_indices.end(), 0);
+        auto domain = math::make_evaluation_domain<field_type>(rows);
+        const value_type omega = domain->get_domain_element(1);
+        const value_type delta = algebra::fields::arithmetic_params<field_type>::multiplicative_generator;
+
+        auto sigma = preprocessor_type::permutation_polynomials(
+            global_indices, omega, delta, constraint_system, desc, domain);
+        BOOST_CHECK_EQUAL(sigma.size(), permuted_columns);
+        for (std::size_t i = 0; i < permuted_columns; i++) {
+            for (std::size_t j = 0; j < rows; j++) {
+                key_type mapped = reference._mapping[key_type(i, j)];
+                BOOST_CHECK(sigma[i][j] == delta.pow(mapped.first) * omega.pow(mapped.second));
+            }
+        }
+    }
+
     BOOST_FIXTURE_TEST_CASE(placeholder_split_polynomial_test, test_tools::random_test_initializer<field_type>) {
         math::polynomial<typename field_type::value_type> f = {1, 3, 4, 1, 5, 6, 7, 2, 8, 7, 5, 6, 1, 2, 1, 1};
         std::size_t expected_size = 4;
@@ -206,6 +336,27 @@ BOOST_AUTO_TEST_SUITE(permutation_argument)
         BOOST_CHECK(f_at_y == f_splitted_at_y);
     }
 
+    BOOST_FIXTURE_TEST_CASE(placeholder_split_quotient_test, test_tools::random_test_initializer<field_type>) {
+        std::size_t n = 4;
+        math::polynomial<typename field_type::value_type> Z(n + 1, field_type::value_type::zero());
+        Z[0] = -field_type::value_type::one();
+        Z[n] = field_type::value_type::one();
+
+        for (std::size_t f_size : {3, 5, 8, 14, 16}) {
+            math::polynomial<typename field_type::value_type> f(f_size);
+            for (std::size_t i = 0; i < f_size; i++) {
+                f[i] = alg_random_engines.template get_alg_engine<field_type>()();
+            }
+
+            std::vector<math::polynomial<typename field_type::value_type>> expected =
+                    zk::snark::detail::split_polynomial<field_type>(f / Z, n - 1);
+            std::vector<math::polynomial<typename field_type::value_type>> f_splitted =
+                    zk::snark::detail::split_quotient_by_vanishing_polynomial<field_type>(f, n);
+
+            BOOST_CHECK(f_splitted == expected);
+        }
+    }
+
     BOOST_FIXTURE_TEST_CASE(permutation_argument_test, test_tools::random_test_initializer<field_type>) {
         auto pi0 = alg_random_engines.template get_alg_engine<field_type>()();
         auto circuit = circuit_test_t<field_type>(
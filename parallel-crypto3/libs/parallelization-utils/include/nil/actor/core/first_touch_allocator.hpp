@@ -0,0 +1,92 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_FIRST_TOUCH_ALLOCATOR_HPP
+#define CRYPTO3_FIRST_TOUCH_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <memory>
+
+#include <nil/actor/core/thread_pool.hpp>
+#include <nil/actor/core/parallelization_utils.hpp>
+
+namespace nil {
+    namespace crypto3 {
+
+        // Allocator which, in NUMA mode of the thread pool, makes each chunk of the new buffer resident on the node
+        // of the worker that processes this chunk in parallel_run_in_chunks over the same number of elements.
+        // The kernel places a page on the node of the thread that first writes it, so the pages are touched in
+        // parallel right after the allocation, before the container constructs its elements from the calling thread.
+        // This only works for fresh pages, which is the case for large buffers that malloc takes with mmap.
+        // Outside of NUMA mode it is std::allocator. Usable as polynomial_dfs<T, first_touch_allocator<T>> or as
+        // the column type std::vector<T, first_touch_allocator<T>> of plonk_table.
+        template<typename T>
+        struct first_touch_allocator {
+            using value_type = T;
+
+            static constexpr std::size_t PAGE_SIZE = 4096;
+
+            first_touch_allocator() noexcept = default;
+
+            template<typename U>
+            first_touch_allocator(const first_touch_allocator<U>&) noexcept {
+            }
+
+            T* allocate(std::size_t n) {
+                T* result = std::allocator<T>().allocate(n);
+
+                ThreadPool& pool = ThreadPool::get_instance(ThreadPool::PoolLevel::LOW);
+                if (pool.numa_enabled() && n * sizeof(T) >= PAGE_SIZE) {
+                    char* bytes = reinterpret_cast<char*>(result);
+                    wait_for_all(parallel_run_in_chunks<void>(
+                        n,
+                        [bytes](std::size_t begin, std::size_t end) {
+                            for (std::size_t offset = begin * sizeof(T); offset < end * sizeof(T);
+                                 offset += PAGE_SIZE) {
+                                bytes[offset] = 0;
+                            }
+                        },
+                        ThreadPool::PoolLevel::LOW));
+                }
+                return result;
+            }
+
+            void deallocate(T* p, std::size_t n) noexcept {
+                std::allocator<T>().deallocate(p, n);
+            }
+        };
+
+        template<typename T, typename U>
+        bool operator==(const first_touch_allocator<T>&, const first_touch_allocator<U>&) noexcept {
+            return true;
+        }
+
+        template<typename T, typename U>
+        bool operator!=(const first_touch_allocator<T>&, const first_touch_allocator<U>&) noexcept {
+            return false;
+        }
+
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif // CRYPTO3_FIRST_TOUCH_ALLOCATOR_HPP
@@ -0,0 +1,132 @@
+//---------------------------------------------------------------------------//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+
+#ifndef CRYPTO3_NUMA_TOPOLOGY_HPP
+#define CRYPTO3_NUMA_TOPOLOGY_HPP
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace nil {
+    namespace crypto3 {
+
+        // CPUs of every NUMA node of the machine. On systems where the topology can not be read
+        // it is a single node with all the hardware threads.
+        struct numa_topology {
+            std::vector<std::vector<std::size_t>> node_cpus;
+
+            static numa_topology detect() {
+                numa_topology result;
+#ifdef __linux__
+                for (std::size_t node = 0;; node++) {
+                    std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+                    if (!cpulist) {
+                        break;
+                    }
+                    std::string line;
+                    std::getline(cpulist, line);
+                    std::vector<std::size_t> cpus = parse_cpu_list(line);
+                    if (!cpus.empty()) {
+                        result.node_cpus.push_back(std::move(cpus));
+                    }
+                }
+#endif
+                if (result.node_cpus.empty()) {
+                    std::size_t cpus_count = std::max(1u, std::thread::hardware_concurrency());
+                    result.node_cpus.emplace_back();
+                    for (std::size_t cpu = 0; cpu < cpus_count; cpu++) {
+                        result.node_cpus.back().push_back(cpu);
+                    }
+                }
+                return result;
+            }
+
+            // Parses the kernel cpu list format, I.E. "0-3,8,10-11".
+            static std::vector<std::size_t> parse_cpu_list(const std::string& list) {
+                std::vector<std::size_t> cpus;
+                std::stringstream ss(list);
+                std::string range;
+                while (std::getline(ss, range, ',')) {
+                    if (range.empty() || range.find_first_not_of(" \n") == std::string::npos) {
+                        continue;
+                    }
+                    std::size_t dash = range.find('-');
+                    std::size_t first = std::stoul(range.substr(0, dash));
+                    std::size_t last = (dash == std::string::npos) ? first : std::stoul(range.substr(dash + 1));
+                    for (std::size_t cpu = first; cpu <= last; cpu++) {
+                        cpus.push_back(cpu);
+                    }
+                }
+                return cpus;
+            }
+
+            std::size_t nodes_count() const {
+                return node_cpus.size();
+            }
+
+            // Places 'workers_count' workers node by node, so that consecutive workers share a node.
+            // Returns the pairs (cpu, node) for every worker.
+            std::vector<std::pair<std::size_t, std::size_t>> place_workers(std::size_t workers_count) const {
+                std::vector<std::pair<std::size_t, std::size_t>> all_cpus;
+                for (std::size_t node = 0; node < node_cpus.size(); node++) {
+                    for (std::size_t cpu : node_cpus[node]) {
+                        all_cpus.emplace_back(cpu, node);
+                    }
+                }
+
+                std::vector<std::pair<std::size_t, std::size_t>> placement(workers_count);
+                for (std::size_t i = 0; i < workers_count; i++) {
+                    // With more workers than cpus, the extra ones are spread over the nodes proportionally.
+                    placement[i] = all_cpus[i * all_cpus.size() / workers_count];
+                }
+                return placement;
+            }
+        };
+
+        // Pins the calling thread to one cpu. Returns false where thread affinity is not supported.
+        inline bool pin_current_thread_to_cpu(std::size_t cpu) {
+#ifdef __linux__
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+            return false;
+#endif
+        }
+
+    }        // namespace crypto3
+}    // namespace nil
+
+#endif // CRYPTO3_NUMA_TOPOLOGY_HPP
@@ -26,6 +26,10 @@
 #define CRYPTO3_PARALLELIZATION_UTILS_HPP
 
 #include <future>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
 
 #include <nil/actor/core/thread_pool.hpp>
 
@@ -47,47 +51,87 @@ namespace nil {
             }
         }
 
-        // Divides work into chunks and makes calls to 'func' in parallel.
+        // Results of parallel_run_in_chunks, one per chunk. The chunks are already finished when it's returned,
+        // wait_for_all only unpacks it.
         template<class ReturnType>
-        std::vector<std::future<ReturnType>> parallel_run_in_chunks_with_thread_id(
+        struct chunk_results {
+            std::vector<ReturnType> values;
+        };
+
+        template<>
+        struct chunk_results<void> {
+        };
+
+        template<class ReturnType>
+        std::vector<ReturnType> wait_for_all(chunk_results<ReturnType> results) {
+            return std::move(results.values);
+        }
+
+        inline void wait_for_all(chunk_results<void>) {
+        }
+
+        // Divides work into chunks and makes calls to 'func' in parallel. Returns when all the calls are done,
+        // the calling thread runs the first chunk and helps with queued tasks while waiting for the rest.
+        // In NUMA mode of the pool chunk i always runs on the same worker for the same 'elements_count', so
+        // repeated passes over one buffer access each chunk from the same node.
+        // The same 'func' object is called concurrently for different chunks.
+        template<class ReturnType>
+        chunk_results<ReturnType> parallel_run_in_chunks_with_thread_id(
                 std::size_t elements_count,
                 std::function<ReturnType(std::size_t thread_id, std::size_t begin, std::size_t end)> func, 
                 ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW) {
 
             auto& thread_pool = ThreadPool::get_instance(pool_id);
 
-            std::vector<std::future<ReturnType>> fut;
             std::size_t workers_to_use = std::max((size_t)1, std::min(elements_count, thread_pool.get_pool_size()));
 
-            // For pool #0 we have experimentally found that operations over chunks of <4096 elements
-            // do not load the cores. In case we have smaller chunks, it's better to load less cores.
-            static constexpr std::size_t POOL_0_MIN_CHUNK_SIZE = 1 << 12;
+            // For pool #0 chunks smaller than ThreadPool::min_chunk_size() (4096 by default) do not load the cores.
+            // In case we have smaller chunks, it's better to load less cores.
+            const std::size_t pool_0_min_chunk_size = ThreadPool::min_chunk_size();
 
             // Pool #0 will take care of the lowest level of operations, like polynomial operations.
-            // We want the minimal size of elements_per_worker to be 'POOL_0_MIN_CHUNK_SIZE', otherwise the cores are not loaded.
-            if (pool_id == ThreadPool::PoolLevel::LOW && elements_count / workers_to_use < POOL_0_MIN_CHUNK_SIZE) {
-                workers_to_use = elements_count / POOL_0_MIN_CHUNK_SIZE + ((elements_count % POOL_0_MIN_CHUNK_SIZE) ? 1 : 0);
+            // We want the minimal size of elements_per_worker to be 'pool_0_min_chunk_size', otherwise the cores are not loaded.
+            if (pool_id == ThreadPool::PoolLevel::LOW && elements_count / workers_to_use < pool_0_min_chunk_size) {
+                workers_to_use = elements_count / pool_0_min_chunk_size + ((elements_count % pool_0_min_chunk_size) ? 1 : 0);
                 workers_to_use = std::max((size_t)1, workers_to_use);
             }
+            // Under a concurrency_limit_guard only the chunks with free slots get a thread of their own, the slots
+            // are held until all the chunks are done.
+            ThreadPool::concurrency_slots slots(workers_to_use - 1);
+            workers_to_use = slots.count() + 1;
 
-            std::size_t begin = 0;
+            std::vector<std::size_t> bounds(workers_to_use + 1, 0);
             for (std::size_t i = 0; i < workers_to_use; i++) {
-                auto end = begin + (elements_count - begin) / (workers_to_use - i);
-                fut.emplace_back(thread_pool.post<ReturnType>([i, begin, end, func]() {
-                    return func(i, begin, end);
-                }));
-                begin = end;
+                bounds[i + 1] = bounds[i] + (elements_count - bounds[i]) / (workers_to_use - i);
+            }
+
+            if constexpr (std::is_void<ReturnType>::value) {
+                thread_pool.fork_join(workers_to_use, [&func, &bounds](std::size_t i) {
+                    func(i, bounds[i], bounds[i + 1]);
+                });
+                return {};
+            } else {
+                std::vector<std::optional<ReturnType>> chunk_values(workers_to_use);
+                thread_pool.fork_join(workers_to_use, [&func, &bounds, &chunk_values](std::size_t i) {
+                    chunk_values[i].emplace(func(i, bounds[i], bounds[i + 1]));
+                });
+
+                chunk_results<ReturnType> results;
+                results.values.reserve(workers_to_use);
+                for (auto& value : chunk_values) {
+                    results.values.push_back(std::move(*value));
+                }
+                return results;
             }
-            return fut;
         }
 
         template<class ReturnType>
-        std::vector<std::future<ReturnType>> parallel_run_in_chunks(
+        chunk_results<ReturnType> parallel_run_in_chunks(
                 std::size_t elements_count,
                 std::function<ReturnType(std::size_t begin, std::size_t end)> func, 
                 ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW) {
             return parallel_run_in_chunks_with_thread_id<ReturnType>(elements_count,
-                [func](std::size_t thread_id, std::size_t begin, std::size_t end) -> ReturnType {
+                [&func](std::size_t thread_id, std::size_t begin, std::size_t end) -> ReturnType {
                     return func(begin, end);
                 }, pool_id);
         }
@@ -100,16 +144,16 @@ namespace nil {
 
             wait_for_all(parallel_run_in_chunks<void>(
                 std::distance(first1, last1),
-                // We need the lambda to be mutable, to be able to modify iterators captured by value.
-                [first1, last1, first2, d_first, binary_op](std::size_t begin, std::size_t end) mutable {
-                    std::advance(first1, begin);
-                    std::advance(first2, begin);
-                    std::advance(d_first, begin);
-                    for (std::size_t i = begin; i < end && first1 != last1; i++) {
-                        *d_first = binary_op(*first1, *first2);
-                        ++first1;
-                        ++first2;
-                        ++d_first;
+                // This lambda is called concurrently for all the chunks, so each chunk advances its own copies of the iterators.
+                [first1, last1, first2, d_first, &binary_op](std::size_t begin, std::size_t end) {
+                    InputIt1 it1 = std::next(first1, begin);
+                    InputIt2 it2 = std::next(first2, begin);
+                    OutputIt out = std::next(d_first, begin);
+                    for (std::size_t i = begin; i < end && it1 != last1; i++) {
+                        *out = binary_op(*it1, *it2);
+                        ++it1;
+                        ++it2;
+                        ++out;
                     }
                 }, pool_id));
         }
@@ -122,14 +166,14 @@ namespace nil {
 
             wait_for_all(parallel_run_in_chunks<void>(
                 std::distance(first1, last1),
-                // We need the lambda to be mutable, to be able to modify iterators captured by value.
-                [first1, last1, d_first, unary_op](std::size_t begin, std::size_t end) mutable {
-                    std::advance(first1, begin);
-                    std::advance(d_first, begin);
-                    for (std::size_t i = begin; i < end && first1 != last1; i++) {
-                        *d_first = unary_op(*first1);
-                        ++first1;
-                        ++d_first;
+                // This lambda is called concurrently for all the chunks, so each chunk advances its own copies of the iterators.
+                [first1, last1, d_first, &unary_op](std::size_t begin, std::size_t end) {
+                    InputIt it1 = std::next(first1, begin);
+                    OutputIt out = std::next(d_first, begin);
+                    for (std::size_t i = begin; i < end && it1 != last1; i++) {
+                        *out = unary_op(*it1);
+                        ++it1;
+                        ++out;
                     }
                 }, pool_id));
         }
@@ -143,14 +187,14 @@ namespace nil {
 
             wait_for_all(parallel_run_in_chunks<void>(
                 std::distance(first1, last1),
-                // We need the lambda to be mutable, to be able to modify iterators captured by value.
-                [first1, last1, first2, binary_op](std::size_t begin, std::size_t end) mutable {
-                    std::advance(first1, begin);
-                    std::advance(first2, begin);
-                    for (std::size_t i = begin; i < end && first1 != last1; i++) {
-                        binary_op(*first1, *first2);
-                        ++first1;
-                        ++first2;
+                // This lambda is called concurrently for all the chunks, so each chunk advances its own copies of the iterators.
+                [first1, last1, first2, &binary_op](std::size_t begin, std::size_t end) {
+                    InputIt1 it1 = std::next(first1, begin);
+                    InputIt2 it2 = std::next(first2, begin);
+                    for (std::size_t i = begin; i < end && it1 != last1; i++) {
+                        binary_op(*it1, *it2);
+                        ++it1;
+                        ++it2;
                     }
                 }, pool_id));
         }
@@ -163,12 +207,12 @@ namespace nil {
 
             wait_for_all(parallel_run_in_chunks<void>(
                 std::distance(first1, last1),
-                // We need the lambda to be mutable, to be able to modify iterators captured by value.
-                [first1, last1, unary_op](std::size_t begin, std::size_t end) mutable {
-                    std::advance(first1, begin);
-                    for (std::size_t i = begin; i < end && first1 != last1; i++) {
-                        unary_op(*first1);
-                        ++first1;
+                // This lambda is called concurrently for all the chunks, so each chunk advances its own copies of the iterators.
+                [first1, last1, &unary_op](std::size_t begin, std::size_t end) {
+                    InputIt it1 = std::next(first1, begin);
+                    for (std::size_t i = begin; i < end && it1 != last1; i++) {
+                        unary_op(*it1);
+                        ++it1;
                     }
                 }, pool_id));
         }
@@ -178,13 +222,74 @@ namespace nil {
                                  ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW) {
             wait_for_all(parallel_run_in_chunks<void>(
                 end - start,
-                [start, func](std::size_t range_begin, std::size_t range_end) {
+                [start, &func](std::size_t range_begin, std::size_t range_end) {
                     for (std::size_t i = start + range_begin; i < start + range_end; i++) {
                         func(i);
                     }
                 }, pool_id));
         }
 
+        // In-place inclusive scan, I.E. *(first + i) becomes op(*first, ..., *(first + i)). 'op' must be associative.
+        // The range is scanned in two passes: every chunk is scanned locally, then the carries of the preceding
+        // chunks are applied to it. The operands are combined in the same order as in a sequential loop.
+        // The second pass may get a different number of concurrency slots than the first one, so it reuses the
+        // chunks of the first pass and spreads them over the threads it gets.
+        template<class RandomIt, class BinaryOperation>
+        void parallel_scan(RandomIt first, RandomIt last, BinaryOperation op,
+                           ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW) {
+            typedef typename std::iterator_traits<RandomIt>::value_type value_type;
+
+            std::size_t elements_count = std::distance(first, last);
+            if (elements_count == 0) {
+                return;
+            }
+
+            typedef std::pair<std::size_t, std::size_t> chunk_bounds;
+            std::vector<chunk_bounds> chunks = wait_for_all(parallel_run_in_chunks<chunk_bounds>(
+                elements_count,
+                [first, op](std::size_t begin, std::size_t end) {
+                    for (std::size_t i = begin + 1; i < end; i++) {
+                        first[i] = op(first[i - 1], first[i]);
+                    }
+                    return chunk_bounds(begin, end);
+                }, pool_id));
+
+            if (chunks.size() == 1) {
+                return;
+            }
+
+            // carries[c] is the scan value right before chunk 'c + 1' starts.
+            std::vector<value_type> carries(chunks.size() - 1);
+            carries[0] = first[chunks[0].second - 1];
+            for (std::size_t c = 1; c < carries.size(); c++) {
+                carries[c] = op(carries[c - 1], first[chunks[c].second - 1]);
+            }
+
+            // Thread t applies the carries to a contiguous run of chunks. With as many threads as chunks, chunk c
+            // runs on the same thread index as in the first pass.
+            auto& thread_pool = ThreadPool::get_instance(pool_id);
+            ThreadPool::concurrency_slots slots(std::min(chunks.size(), thread_pool.get_pool_size()) - 1);
+            const std::size_t threads_count = slots.count() + 1;
+            thread_pool.fork_join(threads_count, [first, op, &carries, &chunks, threads_count](std::size_t t) {
+                const std::size_t chunks_begin = t * chunks.size() / threads_count;
+                const std::size_t chunks_end = (t + 1) * chunks.size() / threads_count;
+                for (std::size_t c = std::max<std::size_t>(chunks_begin, 1); c < chunks_end; c++) {
+                    for (std::size_t i = chunks[c].first; i < chunks[c].second; i++) {
+                        first[i] = op(carries[c - 1], first[i]);
+                    }
+                }
+            });
+        }
+
+        // In-place running product, used for grand-product polynomials.
+        template<class RandomIt>
+        void parallel_prefix_product(RandomIt first, RandomIt last,
+                                     ThreadPool::PoolLevel pool_id = ThreadPool::PoolLevel::LOW) {
+            typedef typename std::iterator_traits<RandomIt>::value_type value_type;
+
+            parallel_scan(first, last, [](const value_type &a, const value_type &b) { return a * b; }, pool_id);
+        }
+
     }        // namespace crypto3
 }    // namespace nil
 
@@ -22,80 +22,605 @@
 // SOFTWARE.
 //---------------------------------------------------------------------------//
 
+
 #ifndef CRYPTO3_THREAD_POOL_HPP
 #define CRYPTO3_THREAD_POOL_HPP
 
-#include <boost/asio/thread_pool.hpp>
-#include <boost/asio/post.hpp>
-
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <future>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <limits>
-#include <memory>
 #include <stdexcept>
+#include <vector>
 
+#include <nil/actor/core/numa_topology.hpp>
 
 namespace nil {
     namespace crypto3 {
 
+        /** A single work-stealing scheduler. Every worker owns a deque of tasks: it pushes and pops at the back, idle
+         *  threads steal from the front. Threads which are not workers push to a shared injection queue.
+         *  Tasks are not owned by the scheduler, they live in the frame of whoever forked them, so forking
+         *  does not allocate per task. A thread that waits for its forked tasks keeps executing queued tasks
+         *  in the meantime, which makes nested parallel loops safe and lets them share all the cores.
+         *
+         *  In NUMA mode the workers are pinned to cpus node by node, task i of a fork_join over n tasks is always
+         *  queued to worker i * pool_size / n, and tasks are only stolen within a node. Repeated parallel passes over
+         *  the same buffer then touch every chunk from the same node. NUMA mode is switched on by set_numa_mode(true)
+         *  or by the environment variable CRYPTO3_THREAD_POOL_NUMA=1, before the first use of the pool.
+         *
+         *  The number of workers, the minimal chunk size of parallel_run_in_chunks and the concurrency of the heavy
+         *  prover stages can be configured at runtime, so several provers can share one host.
+         */
         class ThreadPool {
         public:
 
+            /** There used to be a separate thread pool per level, and submitting higher level tasks to a lower level
+             *  pool deadlocked. Now all the levels share one scheduler, and nesting at any depth is fine.
+             *  The level is kept for compatibility. parallel_run_in_chunks still uses it as a granularity hint.
+             */
             enum class PoolLevel {
                 LOW,
                 HIGH,
                 LASTPOOL
             };
 
-            /** Returns a thread pool, based on the pool_id. pool with LOW is normally used for low-level operations, like polynomial
-             *  operations and fft. Any code that uses these operations and needs to be parallel will submit its tasks to pool with HIGH.
-             *  Submission of higher level tasks to low level pool will immediately result in a deadlock.
+            // Prover stages which can have their own concurrency limit.
+            enum class Stage {
+                FFT,
+                MERKLE,
+                GATES,
+                LASTSTAGE
+            };
+
+            struct task {
+                void (*execute)(task *);
+            };
+
+            // Number of threads which may still join the work under a limit. Goes below zero when more threads
+            // entered the limit than it allows, then nothing is forked under it until enough of them leave.
+            struct concurrency_budget {
+                explicit concurrency_budget(std::ptrdiff_t limit) : available(limit) {
+                }
+
+                // Takes up to 'wanted' slots, returns the number taken.
+                std::size_t try_take(std::size_t wanted) {
+                    std::ptrdiff_t current = available.load(std::memory_order_relaxed);
+                    while (current > 0 && wanted != 0) {
+                        std::ptrdiff_t taken = std::min<std::ptrdiff_t>(current, wanted);
+                        if (available.compare_exchange_weak(current, current - taken, std::memory_order_acq_rel)) {
+                            return taken;
+                        }
+                    }
+                    return 0;
+                }
+
+                void release(std::size_t count) {
+                    available.fetch_add(count, std::memory_order_acq_rel);
+                }
+
+                std::atomic<std::ptrdiff_t> available;
+            };
+
+            // The limits a thread runs under, innermost first. Lives in the frame of a concurrency_limit_guard.
+            struct concurrency_scope {
+                concurrency_budget* budget;
+                const concurrency_scope* parent;
+            };
+
+            /** Limits the number of threads which run the work of the current thread at once, including the tasks
+             *  it forks while the guard is alive, and the tasks they fork. The calling thread always counts, and
+             *  parallel_run_in_chunks forks additional chunks only while slots are free. The slots are taken from
+             *  every enclosing limit, so limits nest and the smallest one wins. 0 means no limit.
+             *
+             *  All the guards of a stage share one budget, so the stage limit holds for the whole process: for
+             *  nested loops of one prover as well as for several provers running in it. A thread which holds no
+             *  slot of any limit waits for a free one, helping with queued tasks meanwhile. A thread which already
+             *  holds a slot, e.g. an FFT called under the gates limit, never waits and enters even when the budget
+             *  is exhausted, so the holders always make progress and release their slots.
+             */
+            class concurrency_limit_guard {
+            public:
+                explicit concurrency_limit_guard(std::size_t limit)
+                    : own_budget(limit) {
+                    if (limit != 0) {
+                        enter(&own_budget);
+                    }
+                }
+
+                // Applies the limit configured for the stage.
+                explicit concurrency_limit_guard(Stage stage)
+                    : own_budget(0) {
+                    if (stage_concurrency(stage) != 0) {
+                        enter(&stage_budget(stage));
+                    }
+                }
+
+                ~concurrency_limit_guard() {
+                    if (entered) {
+                        scope.budget->release(1);
+                        current_concurrency_scope() = scope.parent;
+                        held_concurrency_slots()--;
+                    }
+                }
+
+                concurrency_limit_guard(const concurrency_limit_guard&) = delete;
+                concurrency_limit_guard& operator=(const concurrency_limit_guard&) = delete;
+
+            private:
+                void enter(concurrency_budget* budget) {
+                    const concurrency_scope* current = current_concurrency_scope();
+                    // The thread already counts against this budget, e.g. an FFT nested into another FFT.
+                    for (const concurrency_scope* s = current; s != nullptr; s = s->parent) {
+                        if (s->budget == budget) {
+                            return;
+                        }
+                    }
+                    if (held_concurrency_slots() == 0) {
+                        get_instance().help_while([budget]() { return budget->try_take(1) == 0; });
+                    } else {
+                        budget->available.fetch_sub(1, std::memory_order_acq_rel);
+                    }
+                    scope = {budget, current};
+                    current_concurrency_scope() = &scope;
+                    held_concurrency_slots()++;
+                    entered = true;
+                }
+
+                concurrency_budget own_budget;
+                concurrency_scope scope = {nullptr, nullptr};
+                bool entered = false;
+            };
+
+            /** Slots for the additional threads of one parallel call, taken from all the limits of the calling
+             *  thread and given back on destruction. Without limits all the wanted slots are granted.
+             */
+            class concurrency_slots {
+            public:
+                explicit concurrency_slots(std::size_t wanted)
+                    : scope(current_concurrency_scope())
+                    , granted(take(scope, wanted)) {
+                }
+
+                ~concurrency_slots() {
+                    for (const concurrency_scope* s = scope; s != nullptr; s = s->parent) {
+                        s->budget->release(granted);
+                    }
+                }
+
+                std::size_t count() const {
+                    return granted;
+                }
+
+                concurrency_slots(const concurrency_slots&) = delete;
+                concurrency_slots& operator=(const concurrency_slots&) = delete;
+
+            private:
+                // Takes up to 'wanted' slots from the scope and all its parents, the same number from each.
+                static std::size_t take(const concurrency_scope* s, std::size_t wanted) {
+                    if (s == nullptr || wanted == 0) {
+                        return wanted;
+                    }
+                    std::size_t taken = s->budget->try_take(wanted);
+                    std::size_t granted = take(s->parent, taken);
+                    s->budget->release(taken - granted);
+                    return granted;
+                }
+
+                const concurrency_scope* scope;
+                std::size_t granted;
+            };
+
+            /** Returns the scheduler. The pool size is only taken into account on the first call, and
+             *  set_pool_size() takes precedence over it.
              */
-            static ThreadPool& get_instance(PoolLevel pool_id, std::size_t pool_size = std::thread::hardware_concurrency()) {
-                static ThreadPool instance_for_low_level(pool_size);
-                static ThreadPool instance_for_middle_level(pool_size);
-                static ThreadPool instance_for_high_level(pool_size);
-                
-                if (pool_id == PoolLevel::LOW)
-                    return instance_for_low_level;
-                if (pool_id == PoolLevel::HIGH)
-                    return instance_for_middle_level;
-                if (pool_id == PoolLevel::LASTPOOL)
-                    return instance_for_high_level;
+            static ThreadPool& get_instance(PoolLevel pool_id = PoolLevel::LOW,
+                                            std::size_t pool_size = std::thread::hardware_concurrency()) {
+                static ThreadPool instance(configured_pool_size() != 0 ? configured_pool_size() : pool_size);
+                return instance;
+            }
+
+            // Must be called before the pool is first used, has no effect afterwards.
+            static void set_numa_mode(bool enabled) {
+                numa_mode_requested() = enabled;
+            }
+
+            // Must be called before the pool is first used, has no effect afterwards. 0 means one worker per
+            // hardware thread.
+            static void set_pool_size(std::size_t pool_size) {
+                configured_pool_size() = pool_size;
+            }
+
+            // Minimal number of elements per chunk for PoolLevel::LOW in parallel_run_in_chunks.
+            static void set_min_chunk_size(std::size_t min_chunk_size) {
+                configured_min_chunk_size().store(std::max<std::size_t>(1, min_chunk_size), std::memory_order_relaxed);
+            }
+
+            static std::size_t min_chunk_size() {
+                return configured_min_chunk_size().load(std::memory_order_relaxed);
+            }
 
-                throw std::invalid_argument("Invalid instance of thread pool requested.");
+            // Maximal number of threads running the stage at once, 0 means no limit. Must not be called while
+            // the stage runs.
+            static void set_stage_concurrency(Stage stage, std::size_t limit) {
+                stage_limits()[static_cast<std::size_t>(stage)].store(limit, std::memory_order_relaxed);
+                stage_budget(stage).available.store(limit, std::memory_order_relaxed);
+            }
+
+            static std::size_t stage_concurrency(Stage stage) {
+                return stage_limits()[static_cast<std::size_t>(stage)].load(std::memory_order_relaxed);
             }
 
             ThreadPool(const ThreadPool& obj)= delete;
             ThreadPool& operator=(const ThreadPool& obj)= delete;
 
+            ~ThreadPool() {
+                {
+                    std::lock_guard<std::mutex> lock(sleep_mutex);
+                    stop = true;
+                }
+                wake.notify_all();
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+            }
+
+            /** Calls func(i) for every i in [0, tasks_count) in parallel and returns once all the calls have finished.
+             *  func(0) runs on the calling thread. If some of the calls throw, the first exception is rethrown
+             *  after all the calls are done.
+             */
+            template<class Func>
+            void fork_join(std::size_t tasks_count, Func&& func) {
+                if (tasks_count == 0) {
+                    return;
+                }
+                // In NUMA mode every task goes to its fixed worker, including the first one.
+                const std::size_t first_forked = numa ? 0 : 1;
+
+                struct fork_join_task : task {
+                    typename std::remove_reference<Func>::type* func;
+                    std::size_t index;
+                    const concurrency_scope* scope;
+                    std::exception_ptr* error;
+                    std::atomic<std::size_t>* pending;
+
+                    static void run(task* base) {
+                        auto* self = static_cast<fork_join_task*>(base);
+                        std::atomic<std::size_t>* pending = self->pending;
+                        // The task runs under the limits of the thread which forked it.
+                        const concurrency_scope*& scope = current_concurrency_scope();
+                        const concurrency_scope* previous_scope = scope;
+                        scope = self->scope;
+                        // A task forked under a limit runs on a slot taken by the forking thread.
+                        std::size_t& held = held_concurrency_slots();
+                        held += (self->scope != nullptr);
+                        try {
+                            (*self->func)(self->index);
+                        } catch (...) {
+                            *self->error = std::current_exception();
+                        }
+                        held -= (self->scope != nullptr);
+                        scope = previous_scope;
+                        // Must be the last access to the task, the forking thread may free it right after.
+                        pending->fetch_sub(1, std::memory_order_acq_rel);
+                    }
+                };
+
+                std::vector<std::exception_ptr> errors(tasks_count);
+                std::atomic<std::size_t> pending(tasks_count - first_forked);
+                std::vector<fork_join_task> tasks(tasks_count - first_forked);
+                for (std::size_t i = first_forked; i < tasks_count; i++) {
+                    fork_join_task& t = tasks[i - first_forked];
+                    t.execute = &fork_join_task::run;
+                    t.func = &func;
+                    t.index = i;
+                    t.scope = current_concurrency_scope();
+                    t.error = &errors[i];
+                    t.pending = &pending;
+                }
+
+                if (numa) {
+                    for (auto& t : tasks) {
+                        push_to(queues[t.index * pool_size / tasks_count], &t, 1);
+                    }
+                } else {
+                    push(tasks.data(), tasks.size());
+                    try {
+                        func(0);
+                    } catch (...) {
+                        errors[0] = std::current_exception();
+                    }
+                }
+                help_while([&pending]() { return pending.load(std::memory_order_acquire) != 0; });
+
+                for (auto& error : errors) {
+                    if (error) {
+                        std::rethrow_exception(error);
+                    }
+                }
+            }
+
+            /** Runs a detached task. Prefer fork_join, this allocates the task and its future on the heap, and
+             *  waiting on the future blocks without helping.
+             */
             template<class ReturnType>
-            inline std::future<ReturnType> post(std::function<ReturnType()> task) {
-                auto packaged_task = std::make_shared<std::packaged_task<ReturnType()>>(std::move(task));
-                std::future<ReturnType> fut = packaged_task->get_future();
-                boost::asio::post(pool, [packaged_task]() -> void { (*packaged_task)(); });
+            inline std::future<ReturnType> post(std::function<ReturnType()> task_func) {
+                struct posted_task : task {
+                    std::packaged_task<ReturnType()> job;
+                    std::atomic<std::size_t>* unfinished;
+
+                    static void run(task* base) {
+                        auto* self = static_cast<posted_task*>(base);
+                        std::atomic<std::size_t>* unfinished = self->unfinished;
+                        self->job();
+                        delete self;
+                        unfinished->fetch_sub(1, std::memory_order_acq_rel);
+                    }
+                };
+
+                auto* t = new posted_task();
+                t->execute = &posted_task::run;
+                t->job = std::packaged_task<ReturnType()>(std::move(task_func));
+                t->unfinished = &unfinished_posted;
+                std::future<ReturnType> fut = t->job.get_future();
+
+                unfinished_posted.fetch_add(1, std::memory_order_acq_rel);
+                push(t, 1);
                 return fut;
             }
- 
-            // Waits for all the tasks to complete.
+
+            // Waits for all the posted tasks to complete.
             inline void join() {
-                pool.join();
+                help_while([this]() { return unfinished_posted.load(std::memory_order_acquire) != 0; });
             }
 
             std::size_t get_pool_size() const {
                 return pool_size;
             }
 
+            bool numa_enabled() const {
+                return numa;
+            }
+
+            std::size_t nodes_count() const {
+                return nodes;
+            }
+
+            std::size_t worker_node(std::size_t worker) const {
+                return worker_nodes[worker];
+            }
+
+            // NUMA node of the calling worker, 0 for threads outside of the pool or when NUMA mode is off.
+            std::size_t current_node() const {
+                std::size_t index = worker_index();
+                return (index == NOT_A_WORKER) ? 0 : worker_nodes[index];
+            }
+
         private:
+            static constexpr std::size_t NOT_A_WORKER = std::numeric_limits<std::size_t>::max();
+
+            struct alignas(64) task_queue {
+                std::mutex mutex;
+                std::deque<task*> tasks;
+            };
+
             inline ThreadPool(std::size_t pool_size)
-                : pool(pool_size)
-                , pool_size(pool_size)  {
+                : pool_size(std::max<std::size_t>(1, pool_size))
+                , numa(numa_mode_requested())
+                , queues(this->pool_size)
+                , worker_nodes(this->pool_size, 0) {
+                std::vector<std::pair<std::size_t, std::size_t>> placement;
+                if (numa) {
+                    numa_topology topology = numa_topology::detect();
+                    nodes = topology.nodes_count();
+                    placement = topology.place_workers(this->pool_size);
+                    for (std::size_t i = 0; i < this->pool_size; i++) {
+                        worker_nodes[i] = placement[i].second;
+                    }
+                }
+
+                workers.reserve(this->pool_size);
+                for (std::size_t i = 0; i < this->pool_size; i++) {
+                    workers.emplace_back([this, i, placement]() {
+                        if (!placement.empty()) {
+                            pin_current_thread_to_cpu(placement[i].first);
+                        }
+                        worker_loop(i);
+                    });
+                }
+            }
+
+            static bool& numa_mode_requested() {
+                static bool requested = []() {
+                    const char* env = std::getenv("CRYPTO3_THREAD_POOL_NUMA");
+                    return env != nullptr && std::strcmp(env, "1") == 0;
+                }();
+                return requested;
+            }
+
+            static std::size_t& configured_pool_size() {
+                static std::size_t pool_size = 0;
+                return pool_size;
+            }
+
+            static std::atomic<std::size_t>& configured_min_chunk_size() {
+                // Experimentally, operations over chunks of <4096 elements do not load the cores.
+                static std::atomic<std::size_t> min_chunk_size(1 << 12);
+                return min_chunk_size;
+            }
+
+            static std::atomic<std::size_t>* stage_limits() {
+                static std::atomic<std::size_t> limits[static_cast<std::size_t>(Stage::LASTSTAGE)] = {};
+                return limits;
+            }
+
+            static concurrency_budget& stage_budget(Stage stage) {
+                static concurrency_budget budgets[static_cast<std::size_t>(Stage::LASTSTAGE)] = {
+                    concurrency_budget(0), concurrency_budget(0), concurrency_budget(0)};
+                return budgets[static_cast<std::size_t>(stage)];
+            }
+
+            static const concurrency_scope*& current_concurrency_scope() {
+                static thread_local const concurrency_scope* scope = nullptr;
+                return scope;
+            }
+
+            // Number of guards and tasks on the stack of the calling thread which run on a slot of some limit.
+            static std::size_t& held_concurrency_slots() {
+                static thread_local std::size_t held = 0;
+                return held;
+            }
+
+            static std::size_t& worker_index() {
+                static thread_local std::size_t index = NOT_A_WORKER;
+                return index;
+            }
+
+            // Queues 'count' consecutive tasks of some type derived from 'task'.
+            template<class TaskType>
+            void push(TaskType* tasks, std::size_t count) {
+                if (count == 0) {
+                    return;
+                }
+
+                std::size_t index = worker_index();
+                push_to((index == NOT_A_WORKER) ? injection_queue : queues[index], tasks, count);
+            }
+
+            template<class TaskType>
+            void push_to(task_queue& queue, TaskType* tasks, std::size_t count) {
+                {
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    for (std::size_t i = 0; i < count; i++) {
+                        queue.tasks.push_back(static_cast<task*>(&tasks[i]));
+                    }
+                }
+                queued.fetch_add(count, std::memory_order_seq_cst);
+
+                if (sleeping.load(std::memory_order_seq_cst) != 0) {
+                    // Taking the lock makes sure that a worker which is about to sleep either sees the new tasks or
+                    // is already waiting and gets notified.
+                    { std::lock_guard<std::mutex> lock(sleep_mutex); }
+                    // In NUMA mode a task may only be taken by the workers of one node, so any of them has to wake up.
+                    if (count == 1 && !numa) {
+                        wake.notify_one();
+                    } else {
+                        wake.notify_all();
+                    }
+                }
+            }
+
+            task* try_pop_front(task_queue& queue) {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.tasks.empty()) {
+                    return nullptr;
+                }
+                task* t = queue.tasks.front();
+                queue.tasks.pop_front();
+                return t;
+            }
+
+            task* try_pop_back(task_queue& queue) {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.tasks.empty()) {
+                    return nullptr;
+                }
+                task* t = queue.tasks.back();
+                queue.tasks.pop_back();
+                return t;
+            }
+
+            // Own deque first (most recently forked, hottest in cache), then the injection queue, then steals the
+            // oldest task of some other worker.
+            task* find_task() {
+                if (queued.load(std::memory_order_acquire) == 0) {
+                    return nullptr;
+                }
+
+                std::size_t index = worker_index();
+                task* t = nullptr;
+                if (index != NOT_A_WORKER) {
+                    t = try_pop_back(queues[index]);
+                }
+                if (t == nullptr) {
+                    t = try_pop_front(injection_queue);
+                }
+                std::size_t start = (index == NOT_A_WORKER) ? 0 : index + 1;
+                // In NUMA mode tasks stay on their node, threads outside of the pool do not steal at all.
+                bool may_steal = !numa || index != NOT_A_WORKER;
+                for (std::size_t i = 0; may_steal && t == nullptr && i < pool_size; i++) {
+                    std::size_t victim = (start + i) % pool_size;
+                    if (victim != index && (!numa || worker_nodes[victim] == worker_nodes[index])) {
+                        t = try_pop_front(queues[victim]);
+                    }
+                }
+
+                if (t != nullptr) {
+                    queued.fetch_sub(1, std::memory_order_acq_rel);
+                }
+                return t;
+            }
+
+            template<class Condition>
+            void help_while(Condition condition) {
+                while (condition()) {
+                    if (task* t = find_task()) {
+                        t->execute(t);
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            void worker_loop(std::size_t index) {
+                worker_index() = index;
+                while (true) {
+                    if (task* t = find_task()) {
+                        t->execute(t);
+                        continue;
+                    }
+
+                    std::unique_lock<std::mutex> lock(sleep_mutex);
+                    sleeping.fetch_add(1, std::memory_order_seq_cst);
+                    if (numa && !stop && queued.load(std::memory_order_seq_cst) != 0) {
+                        // Only tasks of other nodes are queued, wait for new ones without spinning.
+                        wake.wait_for(lock, std::chrono::microseconds(100));
+                    } else {
+                        wake.wait(lock, [this]() { return stop || queued.load(std::memory_order_seq_cst) != 0; });
+                    }
+                    sleeping.fetch_sub(1, std::memory_order_seq_cst);
+                    if (stop && queued.load(std::memory_order_seq_cst) == 0) {
+                        return;
+                    }
+                }
             }
 
-            boost::asio::thread_pool pool;
             const std::size_t pool_size;
+            const bool numa;
+            std::size_t nodes = 1;
+
+            std::vector<task_queue> queues;
+            std::vector<std::size_t> worker_nodes;
+            task_queue injection_queue;
+            std::vector<std::thread> workers;
+
+            std::atomic<std::size_t> queued{0};
+            std::atomic<std::size_t> unfinished_posted{0};
 
+            std::atomic<std::size_t> sleeping{0};
+            std::mutex sleep_mutex;
+            std::condition_variable wake;
+            bool stop = false;
         };
 
     }        // namespace crypto3
@@ -25,6 +25,10 @@
 
 #define BOOST_TEST_MODULE thread_pool_test
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <vector>
 #include <cstdint>
 
@@ -34,6 +38,8 @@
 
 #include <nil/actor/core/thread_pool.hpp>
 #include <nil/actor/core/parallelization_utils.hpp>
+#include <nil/actor/core/numa_topology.hpp>
+#include <nil/actor/core/first_touch_allocator.hpp>
 
 
 BOOST_AUTO_TEST_SUITE(thread_pool_test_suite)
@@ -61,4 +67,227 @@ BOOST_AUTO_TEST_CASE(vector_multiplication_test) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(nested_parallel_for_test) {
+    // Used to deadlock when the inner loop ran on the same pool level as the outer one.
+    std::size_t outer = 64;
+    std::size_t inner = 1 << 14;
+    std::vector<std::vector<std::size_t>> v(outer, std::vector<std::size_t>(inner, 0));
+
+    nil::crypto3::parallel_for(0, outer, [&v, inner](std::size_t i) {
+        nil::crypto3::parallel_for(0, inner, [&v, i](std::size_t j) {
+            v[i][j] = i * j;
+        }, nil::crypto3::ThreadPool::PoolLevel::LOW);
+    }, nil::crypto3::ThreadPool::PoolLevel::LOW);
+
+    for (std::size_t i = 0; i < outer; ++i) {
+        for (std::size_t j = 0; j < inner; ++j) {
+            BOOST_CHECK_EQUAL(v[i][j], i * j);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(exception_propagation_test) {
+    BOOST_CHECK_THROW(
+        nil::crypto3::parallel_for(0, 1024, [](std::size_t i) {
+            if (i == 777) {
+                throw std::invalid_argument("chunk failed");
+            }
+        }, nil::crypto3::ThreadPool::PoolLevel::HIGH),
+        std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(post_test) {
+    auto& pool = nil::crypto3::ThreadPool::get_instance(nil::crypto3::ThreadPool::PoolLevel::HIGH);
+    std::vector<std::future<std::size_t>> futures;
+    for (std::size_t i = 0; i < 100; ++i) {
+        futures.push_back(pool.post<std::size_t>([i]() { return i * i; }));
+    }
+    std::vector<std::size_t> results = nil::crypto3::wait_for_all(std::move(futures));
+    for (std::size_t i = 0; i < 100; ++i) {
+        BOOST_CHECK_EQUAL(results[i], i * i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(parallel_scan_test) {
+    for (std::size_t size : {0, 1, 5, 4096, 131073}) {
+        std::vector<std::uint64_t> v(size);
+        std::vector<std::uint64_t> expected(size);
+
+        for (std::size_t i = 0; i < size; ++i) {
+            v[i] = i * 7 + 3;
+            expected[i] = (i == 0) ? v[i] : expected[i - 1] + v[i];
+        }
+
+        nil::crypto3::parallel_scan(v.begin(), v.end(), std::plus<std::uint64_t>());
+        BOOST_CHECK(v == expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(parallel_prefix_product_test) {
+    size_t size = 131072;
+
+    std::vector<std::uint64_t> v(size);
+    std::vector<std::uint64_t> expected(size);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        v[i] = i | 1;
+        expected[i] = (i == 0) ? v[i] : expected[i - 1] * v[i];
+    }
+
+    nil::crypto3::parallel_prefix_product(v.begin(), v.end(), nil::crypto3::ThreadPool::PoolLevel::HIGH);
+    BOOST_CHECK(v == expected);
+}
+
+BOOST_AUTO_TEST_CASE(concurrency_limit_test) {
+    using nil::crypto3::ThreadPool;
+
+    auto chunks_count = []() {
+        std::atomic<std::size_t> chunks(0);
+        nil::crypto3::wait_for_all(nil::crypto3::parallel_run_in_chunks<void>(
+            1000, [&chunks](std::size_t begin, std::size_t end) { chunks++; }, ThreadPool::PoolLevel::HIGH));
+        return chunks.load();
+    };
+
+    std::size_t unlimited = chunks_count();
+    {
+        ThreadPool::concurrency_limit_guard limit(1);
+        BOOST_CHECK_EQUAL(chunks_count(), 1);
+
+        // The limit applies to the tasks forked under it, as well.
+        std::vector<std::size_t> nested(4);
+        nil::crypto3::parallel_for(0, nested.size(), [&nested, &chunks_count](std::size_t i) {
+            nested[i] = chunks_count();
+        }, ThreadPool::PoolLevel::HIGH);
+        for (std::size_t count : nested) {
+            BOOST_CHECK_EQUAL(count, 1);
+        }
+    }
+    BOOST_CHECK_EQUAL(chunks_count(), unlimited);
+}
+
+BOOST_AUTO_TEST_CASE(concurrency_limit_nested_test) {
+    using nil::crypto3::ThreadPool;
+
+    std::atomic<std::size_t> running(0);
+    std::atomic<std::size_t> peak(0);
+    auto work = [&running, &peak]() {
+        std::size_t now = ++running;
+        std::size_t seen = peak.load();
+        while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        --running;
+    };
+    auto nested_loops = [&work]() {
+        nil::crypto3::parallel_for(0, 8, [&work](std::size_t i) {
+            nil::crypto3::parallel_for(0, 8, [&work](std::size_t j) {
+                work();
+            }, ThreadPool::PoolLevel::HIGH);
+        }, ThreadPool::PoolLevel::HIGH);
+    };
+
+    // Nested loops do not multiply the limit.
+    {
+        ThreadPool::concurrency_limit_guard limit(2);
+        nested_loops();
+    }
+    BOOST_CHECK_LE(peak.load(), 2);
+
+    // The stage limit is shared by all the threads entering the stage.
+    peak = 0;
+    ThreadPool::set_stage_concurrency(ThreadPool::Stage::FFT, 3);
+    std::vector<std::thread> callers;
+    for (std::size_t i = 0; i < 2; ++i) {
+        callers.emplace_back([&nested_loops]() {
+            ThreadPool::concurrency_limit_guard limit(ThreadPool::Stage::FFT);
+            nested_loops();
+        });
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+    ThreadPool::set_stage_concurrency(ThreadPool::Stage::FFT, 0);
+    BOOST_CHECK_LE(peak.load(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_scan_concurrency_limit_test) {
+    using nil::crypto3::ThreadPool;
+
+    // A sibling holds all but two slots of the stage while the first pass runs and gives them back before the
+    // second one, so the second pass gets more slots than the first.
+    const std::size_t pool_size = ThreadPool::get_instance(ThreadPool::PoolLevel::HIGH).get_pool_size();
+    const std::size_t limit = std::max<std::size_t>(pool_size, 4);
+    ThreadPool::set_stage_concurrency(ThreadPool::Stage::FFT, limit);
+
+    std::atomic<bool> sibling_holds(false);
+    std::atomic<bool> release(false);
+    std::atomic<bool> released(false);
+    std::thread sibling([&]() {
+        {
+            ThreadPool::concurrency_limit_guard stage(ThreadPool::Stage::FFT);
+            ThreadPool::concurrency_slots slots(limit - 3);
+            sibling_holds = true;
+            while (!release) {
+                std::this_thread::yield();
+            }
+        }
+        released = true;
+    });
+    while (!sibling_holds) {
+        std::this_thread::yield();
+    }
+
+    std::size_t size = 1 << 16;
+    std::vector<std::uint64_t> v(size);
+    std::vector<std::uint64_t> expected(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        v[i] = i * 7 + 3;
+        expected[i] = (i == 0) ? v[i] : expected[i - 1] + v[i];
+    }
+    {
+        ThreadPool::concurrency_limit_guard stage(ThreadPool::Stage::FFT);
+        const std::thread::id caller = std::this_thread::get_id();
+        nil::crypto3::parallel_scan(v.begin(), v.end(), [&](std::uint64_t a, std::uint64_t b) {
+            // The caller runs the first chunk of the first pass.
+            if (std::this_thread::get_id() == caller && !release.exchange(true)) {
+                while (!released) {
+                    std::this_thread::yield();
+                }
+            }
+            return a + b;
+        }, ThreadPool::PoolLevel::HIGH);
+    }
+    release = true;
+    sibling.join();
+    ThreadPool::set_stage_concurrency(ThreadPool::Stage::FFT, 0);
+
+    BOOST_CHECK(v == expected);
+}
+
+BOOST_AUTO_TEST_CASE(numa_topology_test) {
+    std::vector<std::size_t> expected = {0, 1, 2, 3, 8, 10, 11};
+    BOOST_CHECK(nil::crypto3::numa_topology::parse_cpu_list("0-3,8,10-11\n") == expected);
+
+    nil::crypto3::numa_topology topology;
+    topology.node_cpus = {{0, 1}, {2, 3}};
+    auto placement = topology.place_workers(6);
+    BOOST_CHECK_EQUAL(placement.size(), 6);
+    for (std::size_t i = 0; i < placement.size(); ++i) {
+        BOOST_CHECK_EQUAL(placement[i].second, placement[i].first / 2);
+    }
+    // Consecutive workers share a node.
+    BOOST_CHECK_EQUAL(placement[0].second, 0);
+    BOOST_CHECK_EQUAL(placement[5].second, 1);
+}
+
+BOOST_AUTO_TEST_CASE(first_touch_allocator_test) {
+    size_t size = 131072;
+
+    std::vector<std::uint64_t, nil::crypto3::first_touch_allocator<std::uint64_t>> v(size, 7);
+    nil::crypto3::parallel_foreach(v.begin(), v.end(), [](std::uint64_t& x) { x *= 3; });
+    for (std::size_t i = 0; i < size; ++i) {
+        BOOST_CHECK_EQUAL(v[i], 21);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
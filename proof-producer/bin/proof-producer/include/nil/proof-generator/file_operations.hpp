@@ -99,7 +99,7 @@ namespace nil {
             return file;
         }
 
-        std::optional<std::vector<std::uint8_t>> read_file_to_vector(const std::string& path) {
+        inline std::optional<std::vector<std::uint8_t>> read_file_to_vector(const std::string& path) {
 
             auto file = open_file<std::ifstream>(path, std::ios_base::in | std::ios::binary | std::ios::ate);
             if (!file.has_value()) {
@@ -121,7 +121,7 @@ namespace nil {
             return v;
         }
 
-        bool write_vector_to_file(const std::vector<std::uint8_t>& vector, const std::string& path) {
+        inline bool write_vector_to_file(const std::vector<std::uint8_t>& vector, const std::string& path) {
 
             auto file = open_file<std::ofstream>(path, std::ios_base::out | std::ios_base::binary);
             if (!file.has_value()) {
@@ -139,45 +139,98 @@ namespace nil {
             return true;
         }
 
-        // HEX data format is not efficient, we will remove it later
-        std::optional<std::vector<std::uint8_t>> read_hex_file_to_vector(const std::string& path) {
-            auto file = open_file<std::ifstream>(path, std::ios_base::in);
-            if (!file.has_value()) {
-                return std::nullopt;
+        namespace detail {
+            // Value of a hex digit, or -1.
+            inline int hex_digit_value(std::uint8_t c) {
+                if (c >= '0' && c <= '9') {
+                    return c - '0';
+                }
+                if (c >= 'a' && c <= 'f') {
+                    return c - 'a' + 10;
+                }
+                if (c >= 'A' && c <= 'F') {
+                    return c - 'A' + 10;
+                }
+                return -1;
             }
 
-            std::ifstream& stream = file.value();
-            std::vector<uint8_t> result;
-            std::string line;
-            while (std::getline(stream, line)) {
-                if (line.rfind("0x", 0) == 0 && line.length() >= 3) {
-                    for (size_t i = 2; i < line.length(); i += 2) {
-                        std::string hex_string = line.substr(i, 2);
-                        uint8_t byte = static_cast<uint8_t>(std::stoul(hex_string, nullptr, 16));
-                        result.push_back(byte);
+            /**
+             * @brief Decode lines of "0x" followed by an even amount of hex digits, nullopt on anything else.
+             */
+            inline std::optional<std::vector<std::uint8_t>> decode_hex(const std::vector<std::uint8_t>& text) {
+                std::vector<std::uint8_t> result;
+                result.reserve(text.size() / 2);
+
+                std::size_t i = 0;
+                while (i < text.size()) {
+                    if (text.size() - i < 2 || text[i] != '0' || text[i + 1] != 'x') {
+                        return std::nullopt;
+                    }
+                    i += 2;
+                    for (; i < text.size() && text[i] != '\n'; i += 2) {
+                        if (i + 1 == text.size()) {
+                            return std::nullopt;
+                        }
+                        const int high = hex_digit_value(text[i]);
+                        const int low = hex_digit_value(text[i + 1]);
+                        if (high < 0 || low < 0) {
+                            return std::nullopt;
+                        }
+                        result.push_back(static_cast<std::uint8_t>((high << 4) | low));
                     }
-                } else {
-                    BOOST_LOG_TRIVIAL(error) << "File contains non-hex string";
-                    return std::nullopt;
+                    // Skip the line break.
+                    i++;
                 }
+                return result;
+            }
+        } // namespace detail
+
+        // HEX data format is not efficient, we keep it for the EVM tooling only
+        inline std::optional<std::vector<std::uint8_t>> read_hex_file_to_vector(const std::string& path) {
+            auto text = read_file_to_vector(path);
+            if (!text.has_value()) {
+                return std::nullopt;
             }
 
+            auto result = detail::decode_hex(text.value());
+            if (!result.has_value()) {
+                BOOST_LOG_TRIVIAL(error) << "File contains non-hex string";
+            }
             return result;
         }
 
-        bool write_vector_to_hex_file(const std::vector<std::uint8_t>& vector, const std::string& path) {
+        /**
+         * @brief Read a file written either with write_vector_to_file or write_vector_to_hex_file.
+         *
+         * Hex files start with "0x" and contain nothing but hex digits, binary marshalled data is not expected to.
+         */
+        inline std::optional<std::vector<std::uint8_t>> read_binary_or_hex_file_to_vector(const std::string& path) {
+            auto data = read_file_to_vector(path);
+            if (!data.has_value() || data->size() < 2 || (*data)[0] != '0' || (*data)[1] != 'x') {
+                return data;
+            }
+
+            auto decoded = detail::decode_hex(data.value());
+            return decoded.has_value() ? decoded : data;
+        }
+
+        inline bool write_vector_to_hex_file(const std::vector<std::uint8_t>& vector, const std::string& path) {
+            static constexpr char digits[] = "0123456789abcdef";
+
             auto file = open_file<std::ofstream>(path, std::ios_base::out);
             if (!file.has_value()) {
                 return false;
             }
 
-            std::ofstream& stream = file.value();
-
-            stream << "0x" << std::hex;
-            for (auto it = vector.cbegin(); it != vector.cend(); ++it) {
-                stream << std::setfill('0') << std::setw(2) << std::right << int(*it);
+            std::string text(2 + 2 * vector.size(), '0');
+            text[1] = 'x';
+            for (std::size_t i = 0; i < vector.size(); i++) {
+                text[2 + 2 * i] = digits[vector[i] >> 4];
+                text[3 + 2 * i] = digits[vector[i] & 0xF];
             }
-            stream << std::dec;
+
+            std::ofstream& stream = file.value();
+            stream.write(text.data(), text.size());
 
             if (stream.fail()) {
                 BOOST_LOG_TRIVIAL(error) << "Error occurred during writing to file " << path;
@@ -62,8 +62,10 @@
 #include <nil/proof-generator/preset/preset.hpp>
 #include <nil/proof-generator/assigner/assigner.hpp>
 #include <nil/proof-generator/arithmetization_params.hpp>
+#include <nil/proof-generator/output_artifacts/assignment_table_reader.hpp>
 #include <nil/proof-generator/output_artifacts/assignment_table_writer.hpp>
 #include <nil/proof-generator/output_artifacts/circuit_writer.hpp>
+#include <nil/proof-generator/output_artifacts/native_assignment_table.hpp>
 #include <nil/proof-generator/output_artifacts/output_artifacts.hpp>
 #include <nil/proof-generator/file_operations.hpp>
 
@@ -72,12 +74,12 @@
 namespace nil {
     namespace proof_generator {
         namespace detail {
+            // Both binary and hex files are accepted.
             template<typename MarshallingType>
             std::optional<MarshallingType> decode_marshalling_from_file(
-                const boost::filesystem::path& path,
-                bool hex = false
+                const boost::filesystem::path& path
             ) {
-                const auto v = hex ? read_hex_file_to_vector(path.c_str()) : read_file_to_vector(path.c_str());
+                const auto v = read_binary_or_hex_file_to_vector(path.c_str());
                 if (!v.has_value()) {
                     return std::nullopt;
                 }
@@ -124,7 +126,8 @@ namespace nil {
                 COMPUTE_COMBINED_Q = 9,
                 GENERATE_AGGREGATED_FRI_PROOF = 10,
                 GENERATE_CONSISTENCY_CHECKS_PROOF = 11,
-                MERGE_PROOFS = 12
+                MERGE_PROOFS = 12,
+                CONVERT_TABLE = 13
             };
 
             ProverStage prover_stage_from_string(const std::string& stage) {
@@ -141,7 +144,8 @@ namespace nil {
                     {"compute-combined-Q", ProverStage::COMPUTE_COMBINED_Q},
                     {"merge-proofs", ProverStage::MERGE_PROOFS},
                     {"aggregated-FRI", ProverStage::GENERATE_AGGREGATED_FRI_PROOF},
-                    {"consistency-checks", ProverStage::GENERATE_CONSISTENCY_CHECKS_PROOF}
+                    {"consistency-checks", ProverStage::GENERATE_CONSISTENCY_CHECKS_PROOF},
+                    {"convert-table", ProverStage::CONVERT_TABLE}
                 };
                 auto it = stage_map.find(stage);
                 if (it == stage_map.end()) {
@@ -150,6 +154,29 @@ namespace nil {
                 return it->second;
             }
 
+            // Format of the written assignment tables, both formats are recognized when reading.
+            enum class TableFormat {
+                // Canonical big endian values, see assignment_table_writer.
+                MARSHALLED = 0,
+                // Little endian limbs, see native_assignment_table.
+                NATIVE = 1,
+                // Little endian limbs in Montgomery form.
+                NATIVE_MONTGOMERY = 2
+            };
+
+            TableFormat table_format_from_string(const std::string& format) {
+                static std::unordered_map<std::string, TableFormat> format_map = {
+                    {"marshalled", TableFormat::MARSHALLED},
+                    {"native", TableFormat::NATIVE},
+                    {"native-montgomery", TableFormat::NATIVE_MONTGOMERY}
+                };
+                auto it = format_map.find(format);
+                if (it == format_map.end()) {
+                    throw std::invalid_argument("Invalid table format: " + format);
+                }
+                return it->second;
+            }
+
         } // namespace detail
 
 
@@ -185,12 +212,16 @@ namespace nil {
                 std::size_t expand_factor,
                 std::size_t max_q_chunks,
                 std::size_t grind,
-                std::string circuit_name
+                std::string circuit_name,
+                bool use_merkle_multiproofs = false,
+                bool recompute_fri_rounds = false
             ) : expand_factor_(expand_factor),
                 max_quotient_chunks_(max_q_chunks),
                 lambda_(lambda),
                 grind_(grind),
-                circuit_name_(circuit_name){
+                circuit_name_(circuit_name),
+                use_merkle_multiproofs_(use_merkle_multiproofs),
+                recompute_fri_rounds_(recompute_fri_rounds){
             }
 
             bool print_evm_verifier(
@@ -237,7 +268,8 @@ namespace nil {
             bool generate_to_file(
                     boost::filesystem::path proof_file_,
                     boost::filesystem::path json_file_,
-                    bool skip_verification) {
+                    bool skip_verification,
+                    bool hex_proof) {
                 if (!can_write_to_file(proof_file_.string())) {
                     BOOST_LOG_TRIVIAL(error) << "Can't write to file " << proof_file_;
                     return false;
@@ -281,7 +313,7 @@ namespace nil {
                 bool res = detail::encode_marshalling_to_file(
                     proof_file_,
                     filled_placeholder_proof,
-                    true
+                    hex_proof
                 );
                 if (res) {
                     BOOST_LOG_TRIVIAL(info) << "Proof written.";
@@ -310,7 +342,8 @@ namespace nil {
             bool generate_partial_proof_to_file(
                     boost::filesystem::path proof_file_,
                     std::optional<boost::filesystem::path> challenge_file_,
-                    std::optional<boost::filesystem::path> theta_power_file) {
+                    std::optional<boost::filesystem::path> theta_power_file,
+                    bool hex_proof) {
                 if (!can_write_to_file(proof_file_.string())) {
                     BOOST_LOG_TRIVIAL(error) << "Can't write to file " << proof_file_;
                     return false;
@@ -344,7 +377,7 @@ namespace nil {
                 bool res = detail::encode_marshalling_to_file(
                     proof_file_,
                     filled_placeholder_proof,
-                    true
+                    hex_proof
                 );
                 if (res) {
                     BOOST_LOG_TRIVIAL(info) << "Proof written.";
@@ -403,7 +436,7 @@ namespace nil {
                     placeholder_proof<nil::crypto3::marshalling::field_type<Endianness>, Proof>;
 
                 BOOST_LOG_TRIVIAL(info) << "Reading proof from file";
-                auto marshalled_proof = detail::decode_marshalling_from_file<ProofMarshalling>(proof_file_, true);
+                auto marshalled_proof = detail::decode_marshalling_from_file<ProofMarshalling>(proof_file_);
                 if (!marshalled_proof) {
                     return false;
                 }
@@ -528,6 +561,7 @@ namespace nil {
                 }
 
                 lpc_scheme_.emplace(std::move(commitment_scheme.value()));
+                lpc_scheme_->set_fri_prover_options(use_merkle_multiproofs_, recompute_fri_rounds_);
                 return true;
             }
 
@@ -597,18 +631,19 @@ namespace nil {
             }
 
             bool read_assignment_table(const boost::filesystem::path& assignment_table_file_path) {
+                using reader = assignment_table_reader<Endianness, BlueprintField>;
+                using native_table = native_assignment_table<BlueprintField>;
+
                 BOOST_LOG_TRIVIAL(info) << "Read assignment table from " << assignment_table_file_path;
 
-                auto marshalled_table =
-                    detail::decode_marshalling_from_file<TableMarshalling>(assignment_table_file_path);
-                if (!marshalled_table) {
+                auto table = native_table::is_native_table(assignment_table_file_path.string())
+                    ? native_table::read_native_assignment(assignment_table_file_path.string())
+                    : reader::read_binary_assignment(assignment_table_file_path.string());
+                if (!table) {
                     return false;
                 }
 
-                auto [table_description, assignment_table] =
-                    nil::crypto3::marshalling::types::make_assignment_table<Endianness, AssignmentTable>(
-                        *marshalled_table
-                    );
+                auto& [table_description, assignment_table] = *table;
                 table_description_.emplace(table_description);
                 assignment_table_.emplace(std::move(assignment_table));
                 public_inputs_.emplace(assignment_table_->public_inputs());
@@ -630,7 +665,9 @@ namespace nil {
                 return true;
             }
 
-            bool save_binary_assignment_table_to_file(const boost::filesystem::path& output_filename) {
+            bool save_binary_assignment_table_to_file(
+                    const boost::filesystem::path& output_filename,
+                    detail::TableFormat table_format = detail::TableFormat::MARSHALLED) {
                 using writer = assignment_table_writer<Endianness, BlueprintField>;
 
                 BOOST_LOG_TRIVIAL(info) << "Writing binary assignment table to " << output_filename;
@@ -640,6 +677,12 @@ namespace nil {
                     return false;
                 }
 
+                if (table_format != detail::TableFormat::MARSHALLED) {
+                    return native_assignment_table<BlueprintField>::write_native_assignment(
+                        output_filename.string(), assignment_table_.value(), table_description_.value(),
+                        table_format == detail::TableFormat::NATIVE_MONTGOMERY);
+                }
+
                 std::ofstream out(output_filename.string(), std::ios::binary | std::ios::out);
                 if (!out.is_open()) {
                     BOOST_LOG_TRIVIAL(error) << "Failed to open file " << output_filename;
@@ -772,29 +815,20 @@ namespace nil {
                 // Lambdas and grinding bits should be passed through preprocessor directives
                 std::size_t table_rows_log = std::ceil(std::log2(table_description_->rows_amount));
 
-                lpc_scheme_.emplace(FriParams(1, table_rows_log, lambda_, expand_factor_, grind_!=0, grind_));
+                lpc_scheme_.emplace(FriParams(1, table_rows_log, lambda_, expand_factor_, grind_!=0, grind_,
+                                              use_merkle_multiproofs_, recompute_fri_rounds_));
             }
 
             bool preprocess_public_data() {
-                public_inputs_.emplace(assignment_table_->public_inputs());
-
                 create_lpc_scheme();
+                return preprocess_public_data_with_current_scheme();
+            }
 
-                BOOST_LOG_TRIVIAL(info) << "Preprocessing public data";
-                auto start = std::chrono::high_resolution_clock::now();
-                public_preprocessed_data_.emplace(
-                    nil::crypto3::zk::snark::placeholder_public_preprocessor<BlueprintField, PlaceholderParams>::
-                        process(
-                            *constraint_system_,
-                            assignment_table_->move_public_table(),
-                            *table_description_,
-                            *lpc_scheme_,
-                            max_quotient_chunks_
-                        )
-                );
-                auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
-                std::cout << "PREPROCESS: " << duration.count() << "\n";
-                return true;
+            // Preprocesses with a copy of a scheme which has not committed to anything yet, e.g. the one of a previous
+            // table of the same circuit, instead of computing the FRI params and domains again.
+            bool preprocess_public_data(const LpcScheme& fresh_commitment_scheme) {
+                set_commitment_scheme(fresh_commitment_scheme);
+                return preprocess_public_data_with_current_scheme();
             }
 
             bool preprocess_private_data() {
@@ -899,7 +933,8 @@ namespace nil {
                 const std::vector<boost::filesystem::path> &partial_proof_files,
                 const std::vector<boost::filesystem::path> &initial_proof_files,
                 const boost::filesystem::path &aggregated_FRI_file,
-                const boost::filesystem::path &merged_proof_file)
+                const boost::filesystem::path &merged_proof_file,
+                bool hex_proof)
             {
                 /* ZK types */
                 using placeholder_aggregated_proof_type = nil::crypto3::zk::snark::
@@ -932,7 +967,7 @@ namespace nil {
 
                 for(auto const& partial_proof_file: partial_proof_files) {
                     BOOST_LOG_TRIVIAL(info) << "Reading partial proof from file \"" << partial_proof_file << "\"";
-                    auto marshalled_partial_proof = detail::decode_marshalling_from_file<partial_proof_marshalled_type>(partial_proof_file, true);
+                    auto marshalled_partial_proof = detail::decode_marshalling_from_file<partial_proof_marshalled_type>(partial_proof_file);
                     if (!marshalled_partial_proof) {
                         BOOST_LOG_TRIVIAL(error) << "Error reading partial_proof from from \"" << partial_proof_file << "\"";
                         return false;
@@ -975,7 +1010,8 @@ namespace nil {
                     <Endianness, placeholder_aggregated_proof_type, partial_proof_type>
                     (merged_proof, lpc_scheme_->get_fri_params());
 
-                return detail::encode_marshalling_to_file<merged_proof_marshalling_type>(merged_proof_file, marshalled_proof);
+                return detail::encode_marshalling_to_file<merged_proof_marshalling_type>(
+                    merged_proof_file, marshalled_proof, hex_proof);
             }
 
             bool save_fri_proof_to_file(
@@ -1141,6 +1177,23 @@ namespace nil {
                 return assignment_table_.value();
             }
 
+            const TableDescription& get_table_description() const {
+                BOOST_ASSERT(table_description_);
+                return table_description_.value();
+            }
+
+            // The prover appends evaluation points to the scheme, so it must be reset before the next proof.
+            const LpcScheme& get_commitment_scheme() const {
+                BOOST_ASSERT(lpc_scheme_);
+                return lpc_scheme_.value();
+            }
+
+            bool set_commitment_scheme(const LpcScheme& commitment_scheme) {
+                lpc_scheme_.emplace(commitment_scheme);
+                lpc_scheme_->set_fri_prover_options(use_merkle_multiproofs_, recompute_fri_rounds_);
+                return true;
+            }
+
             bool fill_assignment_table(const boost::filesystem::path& trace_base_path) {
                 if (!constraint_system_.has_value()) {
                     BOOST_LOG_TRIVIAL(error) << "Circuit is not initialized";
@@ -1155,15 +1208,38 @@ namespace nil {
                     BOOST_LOG_TRIVIAL(error) << "Can't fill assignment table from trace " << trace_base_path << ": " << err.value();
                     return false;
                 }
+                public_inputs_.emplace(assignment_table_->public_inputs());
                 return true;
             }
 
         private:
+            bool preprocess_public_data_with_current_scheme() {
+                public_inputs_.emplace(assignment_table_->public_inputs());
+
+                BOOST_LOG_TRIVIAL(info) << "Preprocessing public data";
+                auto start = std::chrono::high_resolution_clock::now();
+                public_preprocessed_data_.emplace(
+                    nil::crypto3::zk::snark::placeholder_public_preprocessor<BlueprintField, PlaceholderParams>::
+                        process(
+                            *constraint_system_,
+                            assignment_table_->move_public_table(),
+                            *table_description_,
+                            *lpc_scheme_,
+                            max_quotient_chunks_
+                        )
+                );
+                auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
+                std::cout << "PREPROCESS: " << duration.count() << "\n";
+                return true;
+            }
+
             const std::size_t expand_factor_;
             const std::size_t max_quotient_chunks_;
             const std::size_t lambda_;
             const std::size_t grind_;
             const std::string circuit_name_;
+            const bool use_merkle_multiproofs_;
+            const bool recompute_fri_rounds_;
 
             std::optional<PublicPreprocessedData> public_preprocessed_data_;
 
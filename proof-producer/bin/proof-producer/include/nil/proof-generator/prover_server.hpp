@@ -0,0 +1,525 @@
+//---------------------------------------------------------------------------//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//---------------------------------------------------------------------------//
+
+#ifndef PROOF_GENERATOR_PROVER_SERVER_HPP
+#define PROOF_GENERATOR_PROVER_SERVER_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/log/trivial.hpp>
+
+#include <nil/proof-generator/file_operations.hpp>
+#include <nil/proof-generator/prover.hpp>
+
+namespace nil {
+    namespace proof_generator {
+
+        namespace detail {
+            /**
+             * @brief Map holding at most capacity values, inserting into a full one drops the least recently used.
+             */
+            template<typename Key, typename Value>
+            class lru_cache {
+            public:
+                explicit lru_cache(std::size_t capacity) : capacity_(std::max<std::size_t>(capacity, 1)) {
+                }
+
+                // Marks the value as used.
+                Value* find(const Key& key) {
+                    auto it = entries_.find(key);
+                    if (it == entries_.end()) {
+                        return nullptr;
+                    }
+                    it->second.last_used = ++uses_;
+                    return &it->second.value;
+                }
+
+                Value* insert(const Key& key, Value&& value) {
+                    entries_.erase(key);
+                    if (entries_.size() >= capacity_) {
+                        auto oldest = std::min_element(entries_.begin(), entries_.end(), [](const auto& a, const auto& b) {
+                            return a.second.last_used < b.second.last_used;
+                        });
+                        BOOST_LOG_TRIVIAL(info) << "Dropping cached circuit data " << oldest->first;
+                        entries_.erase(oldest);
+                    }
+                    return &entries_.try_emplace(key, Entry{std::move(value), ++uses_}).first->second.value;
+                }
+
+                void erase(const Key& key) {
+                    entries_.erase(key);
+                }
+
+                bool contains(const Key& key) const {
+                    return entries_.count(key) != 0;
+                }
+
+                std::size_t size() const {
+                    return entries_.size();
+                }
+
+            private:
+                struct Entry {
+                    Value value;
+                    std::size_t last_used;
+                };
+
+                const std::size_t capacity_;
+                std::map<Key, Entry> entries_;
+                std::size_t uses_ = 0;
+            };
+
+            // Tells whether a file was replaced or modified since it was loaded, without reading it.
+            struct file_identity {
+                dev_t device;
+                ino_t inode;
+                off_t size;
+                std::int64_t modified_seconds;
+                std::int64_t modified_nanoseconds;
+
+                bool operator==(const file_identity&) const = default;
+
+                static std::optional<file_identity> of(const std::string& path) {
+                    struct stat file_stat;
+                    if (::stat(path.c_str(), &file_stat) != 0 || !S_ISREG(file_stat.st_mode)) {
+                        return std::nullopt;
+                    }
+                    return file_identity{file_stat.st_dev, file_stat.st_ino, file_stat.st_size,
+                                         file_stat.st_mtim.tv_sec, file_stat.st_mtim.tv_nsec};
+                }
+            };
+        } // namespace detail
+
+        /**
+         * @brief Long-running prover listening on a unix socket.
+         *
+         * Every client sends one request and gets one response on its own connection. A request is a list of
+         * "key value" lines, ended by an empty line or by closing the writing side of the connection:
+         *
+         *     circuit <path>                  Assignment table mode, the same files as the "prove" stage.
+         *     preprocessed-data <path>
+         *     commitment-state-file <path>
+         *     assignment-table <path>
+         *
+         *     trace <path>                    Trace mode, fills the preset table from the trace like the
+         *                                     "fast-generate-partial-proof" stage, but writes a full proof like
+         *                                     the "all" stage.
+         *     circuit-name <name>             Optional, the circuit name the server was started with by default.
+         *
+         *     proof <path>                    Output proof file, required in both modes.
+         *     json <path>                     Optional, the proof file with the json extension by default.
+         *     hex-proof                       Optional, write the proof as hex text.
+         *
+         *     shutdown                        Stop the server, any other keys are ignored.
+         *
+         * The response is a single line, "ok" or "error <message>". Paths are absolute, since the server and its
+         * clients may run in different directories. Only the user running the server may connect to it, and a
+         * client has request_timeout_seconds to send its request.
+         *
+         * In the assignment table mode the circuit, the public preprocessed data and the commitment scheme with the
+         * fixed values trees are loaded on the first request for a circuit and kept for the next ones. The circuit
+         * is identified by the paths of these files, and they are loaded again once any of them changes on disk.
+         * In the trace mode the circuit is identified by its name, and its constraint system, preset table and FRI
+         * params are kept. The public inputs of every trace differ, so its public data is preprocessed again.
+         */
+        template<typename CurveType, typename HashType>
+        class ProverServer {
+        public:
+            using ProverType = Prover<CurveType, HashType>;
+            using LpcScheme = typename ProverType::LpcScheme;
+            using AssignmentTable = typename ProverType::AssignmentTable;
+
+            ProverServer(
+                std::size_t lambda,
+                std::size_t expand_factor,
+                std::size_t max_q_chunks,
+                std::size_t grind,
+                std::string circuit_name,
+                std::size_t cache_size,
+                bool use_merkle_multiproofs = false,
+                bool recompute_fri_rounds = false
+            ) : expand_factor_(expand_factor),
+                max_quotient_chunks_(max_q_chunks),
+                lambda_(lambda),
+                grind_(grind),
+                circuit_name_(circuit_name),
+                use_merkle_multiproofs_(use_merkle_multiproofs),
+                recompute_fri_rounds_(recompute_fri_rounds),
+                cache_(cache_size) {
+            }
+
+            bool run(const boost::filesystem::path& socket_path) {
+                const std::string path = socket_path.string();
+                sockaddr_un address{};
+                if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+                    BOOST_LOG_TRIVIAL(error) << "Invalid socket path " << socket_path;
+                    return false;
+                }
+
+                // A socket left by a previous server is replaced, any other file is not.
+                struct stat file_stat;
+                if (::lstat(path.c_str(), &file_stat) == 0) {
+                    if (!S_ISSOCK(file_stat.st_mode)) {
+                        BOOST_LOG_TRIVIAL(error) << socket_path << " exists and is not a socket";
+                        return false;
+                    }
+                    ::unlink(path.c_str());
+                }
+
+                int server_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+                if (server_fd < 0) {
+                    BOOST_LOG_TRIVIAL(error) << "Can't create socket: " << std::strerror(errno);
+                    return false;
+                }
+                address.sun_family = AF_UNIX;
+                std::memcpy(address.sun_path, path.c_str(), path.size());
+                // The socket is created accessible to its owner only, there is no moment other users could connect.
+                const mode_t old_umask = ::umask(S_IRWXG | S_IRWXO);
+                const bool bound = ::bind(server_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+                ::umask(old_umask);
+                if (!bound || ::listen(server_fd, listen_backlog) != 0) {
+                    BOOST_LOG_TRIVIAL(error) << "Can't listen on " << socket_path << ": " << std::strerror(errno);
+                    ::close(server_fd);
+                    return false;
+                }
+
+                BOOST_LOG_TRIVIAL(info) << "Serving proof requests on " << socket_path;
+                bool stop = false;
+                while (!stop) {
+                    int client_fd = ::accept(server_fd, nullptr, nullptr);
+                    if (client_fd < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+                        BOOST_LOG_TRIVIAL(error) << "Can't accept connection: " << std::strerror(errno);
+                        break;
+                    }
+
+                    if (!is_same_user(client_fd)) {
+                        BOOST_LOG_TRIVIAL(warning) << "Rejected connection of another user";
+                        ::close(client_fd);
+                        continue;
+                    }
+                    const timeval timeout{request_timeout_seconds, 0};
+                    ::setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+                    ::setsockopt(client_fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+                    std::string response;
+                    auto request = read_request(client_fd);
+                    if (!request) {
+                        response = "error malformed request";
+                    } else if (request->count("shutdown")) {
+                        BOOST_LOG_TRIVIAL(info) << "Shutdown requested";
+                        response = "ok";
+                        stop = true;
+                    } else {
+                        response = handle_request(*request);
+                    }
+                    write_response(client_fd, response + "\n");
+                    ::close(client_fd);
+                }
+
+                ::close(server_fd);
+                ::unlink(path.c_str());
+                return stop;
+            }
+
+        private:
+            using Request = std::map<std::string, std::string>;
+
+            // Warm state of a single circuit.
+            struct CircuitState {
+                std::unique_ptr<ProverType> prover;
+                // In the assignment table mode the scheme right after preprocessing, the prover appends the points
+                // of every proof to it. In the trace mode the scheme before preprocessing, with the FRI params only.
+                std::optional<LpcScheme> commitment_scheme;
+                // Trace mode only, the preset table before it is filled from a trace, and the rows amount of the
+                // table the commitment scheme was created for.
+                std::optional<AssignmentTable> assignment_table;
+                std::size_t usable_rows_amount = 0;
+                std::size_t rows_amount = 0;
+                // Assignment table mode only, the circuit files as they were loaded.
+                std::vector<detail::file_identity> files;
+            };
+
+            static constexpr int listen_backlog = 16;
+            static constexpr std::size_t max_request_size = 1 << 20;
+            static constexpr time_t request_timeout_seconds = 30;
+
+            static bool is_same_user(int client_fd) {
+                ucred credentials{};
+                socklen_t length = sizeof(credentials);
+                return ::getsockopt(client_fd, SOL_SOCKET, SO_PEERCRED, &credentials, &length) == 0 &&
+                       credentials.uid == ::getuid();
+            }
+
+            static std::optional<Request> read_request(int client_fd) {
+                std::string text;
+                char buffer[4096];
+                while (text.find("\n\n") == std::string::npos) {
+                    ssize_t received = ::recv(client_fd, buffer, sizeof(buffer), 0);
+                    if (received < 0 && errno == EINTR) {
+                        continue;
+                    }
+                    if (received < 0) {
+                        BOOST_LOG_TRIVIAL(warning) << "Can't receive request: " << std::strerror(errno);
+                        return std::nullopt;
+                    }
+                    if (received == 0) {
+                        break;
+                    }
+                    text.append(buffer, received);
+                    if (text.size() > max_request_size) {
+                        return std::nullopt;
+                    }
+                }
+
+                Request request;
+                std::istringstream lines(text.substr(0, text.find("\n\n")));
+                std::string line;
+                while (std::getline(lines, line)) {
+                    if (!line.empty() && line.back() == '\r') {
+                        line.pop_back();
+                    }
+                    if (line.empty()) {
+                        continue;
+                    }
+                    const auto separator = line.find(' ');
+                    if (separator == std::string::npos) {
+                        request[line] = "";
+                    } else {
+                        request[line.substr(0, separator)] = line.substr(separator + 1);
+                    }
+                }
+                if (request.empty()) {
+                    return std::nullopt;
+                }
+                return request;
+            }
+
+            static void write_response(int client_fd, const std::string& response) {
+                std::size_t sent = 0;
+                while (sent < response.size()) {
+                    ssize_t written = ::send(client_fd, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+                    if (written < 0 && errno == EINTR) {
+                        continue;
+                    }
+                    if (written <= 0) {
+                        BOOST_LOG_TRIVIAL(warning) << "Client disconnected before the response was sent";
+                        return;
+                    }
+                    sent += written;
+                }
+            }
+
+            static std::optional<std::string> get(const Request& request, const std::string& key) {
+                auto it = request.find(key);
+                if (it == request.end() || it->second.empty()) {
+                    return std::nullopt;
+                }
+                return it->second;
+            }
+
+            // Absolute and not too long.
+            static bool is_valid_request_path(const std::string& path) {
+                return boost::filesystem::path(path).is_absolute() && is_valid_path(path);
+            }
+
+            // A file that is created or overwritten, in an existing directory.
+            static bool is_valid_output_path(const std::string& path) {
+                const boost::filesystem::path output(path);
+                boost::system::error_code error;
+                return boost::filesystem::is_directory(output.parent_path(), error) &&
+                       (!boost::filesystem::exists(output, error) || boost::filesystem::is_regular_file(output, error));
+            }
+
+            std::string handle_request(const Request& request) {
+                for (const char* key : {"circuit", "preprocessed-data", "commitment-state-file", "assignment-table",
+                                        "trace", "proof", "json"}) {
+                    auto path = get(request, key);
+                    if (path && !is_valid_request_path(*path)) {
+                        return std::string("error invalid ") + key + " path " + *path;
+                    }
+                }
+
+                auto proof_file = get(request, "proof");
+                if (!proof_file) {
+                    return "error no proof file";
+                }
+                boost::filesystem::path json_file = get(request, "json").value_or(
+                    boost::filesystem::path(*proof_file).replace_extension(".json").string());
+                if (!is_valid_output_path(*proof_file) || !is_valid_output_path(json_file.string())) {
+                    return "error can't write proof to " + *proof_file;
+                }
+                const bool hex_proof = request.count("hex-proof") != 0;
+
+                try {
+                    std::optional<std::string> error;
+                    ProverType* prover = nullptr;
+                    if (auto trace = get(request, "trace")) {
+                        std::tie(prover, error) = prepare_trace(*trace, get(request, "circuit-name").value_or(circuit_name_));
+                    } else {
+                        std::tie(prover, error) = prepare_table(request);
+                    }
+                    if (error) {
+                        return "error " + *error;
+                    }
+
+                    if (!prover->preprocess_private_data() ||
+                            !prover->generate_to_file(*proof_file, json_file, true/*skip verification*/, hex_proof)) {
+                        return "error failed to generate proof";
+                    }
+                } catch (const std::exception& e) {
+                    BOOST_LOG_TRIVIAL(error) << e.what();
+                    return std::string("error ") + e.what();
+                }
+                return "ok";
+            }
+
+            using Prepared = std::pair<ProverType*, std::optional<std::string>>;
+
+            Prepared prepare_table(const Request& request) {
+                auto circuit_file = get(request, "circuit");
+                auto preprocessed_data_file = get(request, "preprocessed-data");
+                auto commitment_state_file = get(request, "commitment-state-file");
+                auto assignment_table_file = get(request, "assignment-table");
+                if (!circuit_file || !preprocessed_data_file || !commitment_state_file || !assignment_table_file) {
+                    return {nullptr, "circuit, preprocessed-data, commitment-state-file and assignment-table "
+                                     "or trace are required"};
+                }
+
+                std::vector<detail::file_identity> files;
+                for (const std::string& file : {*circuit_file, *preprocessed_data_file, *commitment_state_file}) {
+                    auto identity = detail::file_identity::of(file);
+                    if (!identity) {
+                        return {nullptr, "can't read " + file};
+                    }
+                    files.push_back(*identity);
+                }
+                // Request lines hold no line breaks, so the key tells the paths apart.
+                const std::string key = "table:" + *circuit_file + "\n" + *preprocessed_data_file + "\n" +
+                                        *commitment_state_file;
+
+                CircuitState* state = find(key);
+                if (state && state->files != files) {
+                    BOOST_LOG_TRIVIAL(info) << "Circuit data changed on disk, loading it again";
+                    cache_.erase(key);
+                    state = nullptr;
+                }
+                if (!state) {
+                    CircuitState warm;
+                    warm.files = std::move(files);
+                    warm.prover = make_prover(circuit_name_);
+                    if (!warm.prover->read_circuit(*circuit_file) ||
+                            !warm.prover->read_public_preprocessed_data_from_file(*preprocessed_data_file) ||
+                            !warm.prover->read_commitment_scheme_from_file(*commitment_state_file)) {
+                        return {nullptr, "failed to load circuit data"};
+                    }
+                    warm.commitment_scheme.emplace(warm.prover->get_commitment_scheme());
+                    state = insert(key, std::move(warm));
+                } else {
+                    state->prover->set_commitment_scheme(*state->commitment_scheme);
+                }
+
+                if (!state->prover->read_assignment_table(*assignment_table_file)) {
+                    return {nullptr, "can't read assignment table " + *assignment_table_file};
+                }
+                return {state->prover.get(), std::nullopt};
+            }
+
+            Prepared prepare_trace(const std::string& trace, const std::string& circuit_name) {
+                const std::string key = "trace:" + circuit_name;
+
+                CircuitState* state = find(key);
+                if (!state) {
+                    CircuitState warm;
+                    warm.prover = make_prover(circuit_name);
+                    if (!warm.prover->setup_prover()) {
+                        return {nullptr, "can't initialize circuit " + circuit_name};
+                    }
+                    warm.assignment_table.emplace(warm.prover->get_assignment_table());
+                    warm.usable_rows_amount = warm.prover->get_table_description().usable_rows_amount;
+                    state = insert(key, std::move(warm));
+                }
+
+                ProverType& prover = *state->prover;
+                if (!prover.set_assignment_table(*state->assignment_table, state->usable_rows_amount) ||
+                        !prover.fill_assignment_table(trace)) {
+                    return {nullptr, "failed to fill assignment table from trace " + trace};
+                }
+                // The FRI params depend on the padded rows amount of the trace only. The public columns come from
+                // the trace, so the public data is preprocessed for every trace.
+                const std::size_t rows_amount = prover.get_table_description().rows_amount;
+                if (!state->commitment_scheme || state->rows_amount != rows_amount) {
+                    prover.create_lpc_scheme();
+                    state->commitment_scheme.emplace(prover.get_commitment_scheme());
+                    state->rows_amount = rows_amount;
+                }
+                if (!prover.preprocess_public_data(*state->commitment_scheme)) {
+                    return {nullptr, "failed to preprocess trace " + trace};
+                }
+                return {state->prover.get(), std::nullopt};
+            }
+
+            std::unique_ptr<ProverType> make_prover(const std::string& circuit_name) const {
+                return std::make_unique<ProverType>(lambda_, expand_factor_, max_quotient_chunks_, grind_, circuit_name,
+                                                    use_merkle_multiproofs_, recompute_fri_rounds_);
+            }
+
+            CircuitState* find(const std::string& key) {
+                CircuitState* state = cache_.find(key);
+                if (state) {
+                    BOOST_LOG_TRIVIAL(info) << "Using cached circuit data";
+                }
+                return state;
+            }
+
+            CircuitState* insert(const std::string& key, CircuitState&& state) {
+                return cache_.insert(key, std::move(state));
+            }
+
+            const std::size_t expand_factor_;
+            const std::size_t max_quotient_chunks_;
+            const std::size_t lambda_;
+            const std::size_t grind_;
+            const std::string circuit_name_;
+            const bool use_merkle_multiproofs_;
+            const bool recompute_fri_rounds_;
+
+            detail::lru_cache<std::string, CircuitState> cache_;
+        };
+
+    } // namespace proof_generator
+} // namespace nil
+
+#endif // PROOF_GENERATOR_PROVER_SERVER_HPP
@@ -74,9 +74,11 @@ namespace nil {
             // clang-format off
             auto options_appender = config.add_options()
                 ("stage", make_defaulted_option(prover_options.stage),
-                 "Stage of the prover to run, one of (all, preprocess, prove, verify, generate-aggregated-challenge, generate-combined-Q, aggregated-FRI, consistency-checks). Defaults to 'all'.")
+                 "Stage of the prover to run, one of (all, preprocess, prove, verify, generate-aggregated-challenge, generate-combined-Q, aggregated-FRI, consistency-checks, convert-table). Defaults to 'all'.")
                 ("proof,p", make_defaulted_option(prover_options.proof_file_path), "Proof file")
                 ("json,j", make_defaulted_option(prover_options.json_file_path), "JSON proof file")
+                ("hex-proof", po::bool_switch(&prover_options.hex_proof),
+                 "Write proofs as hex text, as expected by the EVM tooling. Proofs are read in either format")
                 ("common-data", make_defaulted_option(prover_options.preprocessed_common_data_path), "Preprocessed common data file")
                 ("preprocessed-data", make_defaulted_option(prover_options.preprocessed_public_data_path), "Preprocessed public data file")
                 ("commitment-state-file", make_defaulted_option(prover_options.commitment_scheme_state_path), "Commitment state data file")
@@ -86,13 +88,32 @@ namespace nil {
                 ("circuit-name", po::value(&prover_options.circuit_name), "Target circuit name")
                 ("assignment-table,t", po::value(&prover_options.assignment_table_file_path), "Assignment table input file")
                 ("assignment-description-file", po::value(&prover_options.assignment_description_file_path), "Assignment description file")
+                ("table-format", make_defaulted_option(prover_options.table_format),
+                 "Format of the written assignment tables, one of (marshalled, native, native-montgomery). Both formats are recognized when reading.")
+                ("converted-assignment-table", po::value(&prover_options.converted_assignment_table_file_path),
+                 "Output file of the 'convert-table' stage, which rewrites the assignment table in the table format")
+                ("serve", po::value(&prover_options.serve_socket_path),
+                 "Keep running and generate proofs for the requests received on this unix socket, instead of running a stage")
+                ("serve-cache-size", make_defaulted_option(prover_options.serve_cache_size),
+                 "Maximal number of circuits kept preprocessed by the server")
                 ("log-level,l", make_defaulted_option(prover_options.log_level), "Log level (trace, debug, info, warning, error, fatal)")
                 ("elliptic-curve-type,e", make_defaulted_option(prover_options.elliptic_curve_type), "Elliptic curve type (pallas)")
                 ("hash-type", make_defaulted_option(prover_options.hash_type), "Hash type (keccak, poseidon, sha256)")
                 ("lambda-param", make_defaulted_option(prover_options.lambda), "Lambda param (9)")
                 ("grind-param", make_defaulted_option(prover_options.grind), "Grind param (0)")
+                ("merkle-multiproofs", po::bool_switch(&prover_options.merkle_multiproofs),
+                 "Put the Merkle paths of all the FRI queries to a tree into one multiproof, for smaller proofs")
+                ("recompute-fri-rounds", po::bool_switch(&prover_options.recompute_fri_rounds),
+                 "Build the trees of the FRI rounds once more in the query phase instead of keeping them, for less memory")
                 ("expand-factor,x", make_defaulted_option(prover_options.expand_factor), "Expand factor")
                 ("max-quotient-chunks,q", make_defaulted_option(prover_options.max_quotient_chunks), "Maximum quotient polynomial parts amount")
+                ("threads", make_defaulted_option(prover_options.threads),
+                 "Number of worker threads of the multi-threaded prover, 0 for one per hardware thread")
+                ("min-chunk-size", make_defaulted_option(prover_options.min_chunk_size),
+                 "Minimal number of elements processed by one thread in low level parallel loops, 0 for the default (4096)")
+                ("fft-threads", make_defaulted_option(prover_options.fft_threads), "Maximal number of threads running FFTs at once, 0 for no limit")
+                ("merkle-threads", make_defaulted_option(prover_options.merkle_threads), "Maximal number of threads building Merkle trees at once, 0 for no limit")
+                ("gate-threads", make_defaulted_option(prover_options.gate_threads), "Maximal number of threads evaluating the gate argument at once, 0 for no limit")
                 ("evm-verifier", make_defaulted_option(prover_options.evm_verifier_path), "Output folder for EVM verifier")
                 ("input-challenge-files,u", po::value<std::vector<boost::filesystem::path>>(&prover_options.input_challenge_files)->multitoken(),
                  "Input challenge files. Used with 'generate-aggregated-challenge' stage.")
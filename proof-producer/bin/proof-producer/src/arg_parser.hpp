@@ -48,6 +48,8 @@ namespace nil {
             boost::filesystem::path circuit_file_path;
             boost::filesystem::path assignment_table_file_path;
             boost::filesystem::path assignment_description_file_path;
+            boost::filesystem::path converted_assignment_table_file_path;
+            std::string table_format = "marshalled";
             boost::filesystem::path challenge_file_path;
             boost::filesystem::path theta_power_file_path;
             boost::filesystem::path evm_verifier_path;
@@ -67,10 +69,27 @@ namespace nil {
             CurvesVariant elliptic_curve_type = type_identity<nil::crypto3::algebra::curves::pallas>{};
             HashesVariant hash_type = type_identity<nil::crypto3::hashes::keccak_1600<256>>{};
 
+            // Proofs are written as hex text for the EVM tooling, binary otherwise.
+            bool hex_proof = false;
+
+            // Unix socket of the long-running prover, empty to run a single stage.
+            boost::filesystem::path serve_socket_path;
+            std::size_t serve_cache_size = 4;
+
             std::size_t lambda = 9;
             std::size_t grind = 0;
+            // FRI options of the prover, the verifier reads them from the proof.
+            bool merkle_multiproofs = false;
+            bool recompute_fri_rounds = false;
             std::size_t expand_factor = 2;
             std::size_t max_quotient_chunks = 0;
+
+            // Parallelism of the multi-threaded prover, 0 means the default.
+            std::size_t threads = 0;
+            std::size_t min_chunk_size = 0;
+            std::size_t fft_threads = 0;
+            std::size_t merkle_threads = 0;
+            std::size_t gate_threads = 0;
         };
 
         std::optional<ProverOptions> parse_args(int argc, char* argv[]);
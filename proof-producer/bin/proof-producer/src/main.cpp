@@ -19,11 +19,17 @@
 
 #include <iostream>
 #include <optional>
+#include <string>
 #include <utility>
 
 #include <arg_parser.hpp>
 #include <nil/proof-generator/file_operations.hpp>
 #include <nil/proof-generator/prover.hpp>
+#include <nil/proof-generator/prover_server.hpp>
+
+#ifdef PROOF_PRODUCER_MULTI_THREADED
+#include <nil/actor/core/thread_pool.hpp>
+#endif
 
 #undef B0
 
@@ -31,16 +37,33 @@ using namespace nil::proof_generator;
 
 template<typename CurveType, typename HashType>
 int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
+    if (!prover_options.serve_socket_path.empty()) {
+        nil::proof_generator::ProverServer<CurveType, HashType> server(
+            prover_options.lambda,
+            prover_options.expand_factor,
+            prover_options.max_quotient_chunks,
+            prover_options.grind,
+            prover_options.circuit_name,
+            prover_options.serve_cache_size,
+            prover_options.merkle_multiproofs,
+            prover_options.recompute_fri_rounds
+        );
+        return server.run(prover_options.serve_socket_path) ? 0 : 1;
+    }
+
     auto prover_task = [&] {
         auto prover = nil::proof_generator::Prover<CurveType, HashType>(
             prover_options.lambda,
             prover_options.expand_factor,
             prover_options.max_quotient_chunks,
             prover_options.grind,
-            prover_options.circuit_name
+            prover_options.circuit_name,
+            prover_options.merkle_multiproofs,
+            prover_options.recompute_fri_rounds
         );
         bool prover_result;
         try {
+            const auto table_format = nil::proof_generator::detail::table_format_from_string(prover_options.table_format);
             switch (nil::proof_generator::detail::prover_stage_from_string(prover_options.stage)) {
                 case nil::proof_generator::detail::ProverStage::ALL:
                     prover_result =
@@ -53,7 +76,8 @@ int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
                         prover.generate_to_file(
                             prover_options.proof_file_path,
                             prover_options.json_file_path,
-                            false/*don't skip verification*/) &&
+                            false/*don't skip verification*/,
+                            prover_options.hex_proof) &&
                         prover.save_preprocessed_common_data_to_file(prover_options.preprocessed_common_data_path) &&
                         prover.save_public_preprocessed_data_to_file(prover_options.preprocessed_public_data_path) &&
                         prover.save_commitment_state_to_file(prover_options.commitment_scheme_state_path) &&
@@ -65,7 +89,7 @@ int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
                         prover_result = prover.save_circuit_to_file(prover_options.circuit_file_path);
                     }
                     if (!prover_options.assignment_table_file_path.empty() && prover_result) {
-                        prover_result = prover.save_binary_assignment_table_to_file(prover_options.assignment_table_file_path);
+                        prover_result = prover.save_binary_assignment_table_to_file(prover_options.assignment_table_file_path, table_format);
                     }
                     if (prover_result) {
                         prover_result = prover.print_debug_assignment_table(prover_options.output_artifacts);
@@ -74,7 +98,7 @@ int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
                 case nil::proof_generator::detail::ProverStage::ASSIGNMENT:
                     prover_result = prover.setup_prover() && prover.fill_assignment_table(prover_options.trace_base_path);
                     if (!prover_options.assignment_table_file_path.empty() && prover_result) {
-                        prover_result = prover.save_binary_assignment_table_to_file(prover_options.assignment_table_file_path);
+                        prover_result = prover.save_binary_assignment_table_to_file(prover_options.assignment_table_file_path, table_format);
                     }
                     if (!prover_options.assignment_description_file_path.empty() && prover_result) {
                         prover_result = prover.save_assignment_description(prover_options.assignment_description_file_path);
@@ -106,7 +130,8 @@ int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
                         prover.generate_to_file(
                             prover_options.proof_file_path,
                             prover_options.json_file_path,
-                            true/*skip verification*/)&&
+                            true/*skip verification*/,
+                            prover_options.hex_proof)&&
                         prover.print_evm_verifier(prover_options.evm_verifier_path);
                     break;
                 case nil::proof_generator::detail::ProverStage::GENERATE_PARTIAL_PROOF:
@@ -122,7 +147,8 @@ int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
                         prover.generate_partial_proof_to_file(
                             prover_options.proof_file_path,
                             prover_options.challenge_file_path,
-                            prover_options.theta_power_file_path) &&
+                            prover_options.theta_power_file_path,
+                            prover_options.hex_proof) &&
                         prover.save_commitment_state_to_file(prover_options.updated_commitment_scheme_state_path);
                     break;
                 case nil::proof_generator::detail::ProverStage::FAST_GENERATE_PARTIAL_PROOF:
@@ -136,7 +162,8 @@ int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
                         prover.generate_partial_proof_to_file(
                             prover_options.proof_file_path,
                             prover_options.challenge_file_path,
-                            prover_options.theta_power_file_path) &&
+                            prover_options.theta_power_file_path,
+                            prover_options.hex_proof) &&
                         prover.save_commitment_state_to_file(prover_options.updated_commitment_scheme_state_path);
                     break;
                 case nil::proof_generator::detail::ProverStage::VERIFY:
@@ -159,7 +186,8 @@ int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
                             prover_options.partial_proof_files,
                             prover_options.initial_proof_files,
                             prover_options.aggregated_FRI_proof_file,
-                            prover_options.proof_file_path);
+                            prover_options.proof_file_path,
+                            prover_options.hex_proof);
                     break;
                 case nil::proof_generator::detail::ProverStage::COMPUTE_COMBINED_Q:
                     prover_result =
@@ -187,6 +215,11 @@ int run_prover(const nil::proof_generator::ProverOptions& prover_options) {
                             prover_options.proof_file_path
                             );
                     break;
+                case nil::proof_generator::detail::ProverStage::CONVERT_TABLE:
+                    prover_result =
+                        prover.read_assignment_table(prover_options.assignment_table_file_path) &&
+                        prover.save_binary_assignment_table_to_file(prover_options.converted_assignment_table_file_path, table_format);
+                    break;
             }
         } catch (const std::exception& e) {
             BOOST_LOG_TRIVIAL(error) << e.what();
@@ -222,7 +255,37 @@ int curve_wrapper(const ProverOptions& prover_options) {
     return ret;
 }
 
+// Must run before anything touches the thread pool, its size is fixed on the first use.
+void configure_parallelism(const ProverOptions& prover_options) {
+#ifdef PROOF_PRODUCER_MULTI_THREADED
+    using nil::crypto3::ThreadPool;
+
+    ThreadPool::set_pool_size(prover_options.threads);
+    if (prover_options.min_chunk_size != 0) {
+        ThreadPool::set_min_chunk_size(prover_options.min_chunk_size);
+    }
+    ThreadPool::set_stage_concurrency(ThreadPool::Stage::FFT, prover_options.fft_threads);
+    ThreadPool::set_stage_concurrency(ThreadPool::Stage::MERKLE, prover_options.merkle_threads);
+    ThreadPool::set_stage_concurrency(ThreadPool::Stage::GATES, prover_options.gate_threads);
+
+    auto limit_to_string = [](std::size_t limit) {
+        return limit == 0 ? std::string("unlimited") : std::to_string(limit);
+    };
+    BOOST_LOG_TRIVIAL(info) << "Parallelism: threads " << ThreadPool::get_instance().get_pool_size()
+                            << ", min chunk size " << ThreadPool::min_chunk_size()
+                            << ", FFT threads " << limit_to_string(prover_options.fft_threads)
+                            << ", Merkle threads " << limit_to_string(prover_options.merkle_threads)
+                            << ", gate threads " << limit_to_string(prover_options.gate_threads);
+#else
+    if (prover_options.threads > 1 || prover_options.fft_threads > 1 || prover_options.merkle_threads > 1 ||
+        prover_options.gate_threads > 1) {
+        BOOST_LOG_TRIVIAL(warning) << "Thread options are ignored by the single-threaded prover";
+    }
+#endif
+}
+
 int initial_wrapper(const ProverOptions& prover_options) {
+    configure_parallelism(prover_options);
     return curve_wrapper(prover_options);
 }
 
@@ -0,0 +1,212 @@
+//---------------------------------------------------------------------------//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//---------------------------------------------------------------------------//
+
+#ifndef PROOF_GENERATOR_ASSIGNMENT_TABLE_READER_HPP
+#define PROOF_GENERATOR_ASSIGNMENT_TABLE_READER_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/log/trivial.hpp>
+
+#include <nil/crypto3/marshalling/algebra/types/field_element.hpp>
+#include <nil/crypto3/zk/snark/arithmetization/plonk/assignment.hpp>
+#include <nil/crypto3/zk/snark/arithmetization/plonk/table_description.hpp>
+#include <nil/marshalling/types/integral.hpp>
+
+#include <nil/proof-generator/output_artifacts/mapped_file.hpp>
+
+#ifdef PROOF_PRODUCER_MULTI_THREADED
+#include <nil/actor/core/parallelization_utils.hpp>
+#endif
+
+namespace nil {
+    namespace proof_generator {
+
+        /**
+         * @brief Reads the binary assignment table written by assignment_table_writer::write_binary_assignment.
+         *
+         * The file is memory-mapped and the field elements are decoded from the mapped bytes straight into the
+         * table columns, so unlike decoding the whole file with the plonk_assignment_table marshalling, only the
+         * table itself is held in memory. Pages of the file are dropped by the kernel as needed.
+         */
+        template <typename Endianness, typename BlueprintField>
+        class assignment_table_reader {
+            public:
+                using Column = nil::crypto3::zk::snark::plonk_column<BlueprintField>;
+
+                using AssignmentTable = nil::crypto3::zk::snark::plonk_table<BlueprintField, Column>;
+                using AssignmentTableDescription = nil::crypto3::zk::snark::plonk_table_description<BlueprintField>;
+
+                // marshalling traits
+                using TTypeBase = nil::crypto3::marshalling::field_type<Endianness>;
+                using BlueprintFieldValueType = typename BlueprintField::value_type;
+                using MarshallingField = nil::crypto3::marshalling::types::field_element<
+                    TTypeBase,
+                    BlueprintFieldValueType
+                >;
+                using MarshallingSize = nil::crypto3::marshalling::types::integral<TTypeBase, std::size_t>;
+
+            private:
+                static constexpr std::size_t size_length = MarshallingSize().length();
+                static constexpr std::size_t field_length = MarshallingField().length();
+
+                // Witnesses, public inputs, constants and selectors, in the order they are written.
+                static constexpr std::size_t column_groups = 4;
+
+                static std::size_t read_size_t(const std::uint8_t* data) {
+                    MarshallingSize integer_container;
+                    auto read_iter = data;
+                    integer_container.read(read_iter, size_length);
+                    return integer_container.value();
+                }
+
+                // a * b, or nullopt on overflow.
+                static std::optional<std::size_t> checked_product(std::size_t a, std::size_t b) {
+                    if (a != 0 && b > std::numeric_limits<std::size_t>::max() / a) {
+                        return std::nullopt;
+                    }
+                    return a * b;
+                }
+
+                /**
+                * @brief Decode columns_amount columns of rows_amount values each, stored one after another at data.
+                */
+                static bool read_columns(const std::uint8_t* data, std::vector<Column>& columns,
+                                         std::size_t columns_amount, std::size_t rows_amount) {
+                    columns.assign(columns_amount, Column(rows_amount));
+
+                    // Ranges of the flattened columns are independent, each one is decoded by a single thread.
+                    auto read_range = [data, &columns, rows_amount](std::size_t begin, std::size_t end) {
+                        bool success = true;
+                        MarshallingField field_container;
+                        for (std::size_t i = begin; i < end; i++) {
+                            auto read_iter = data + i * field_length;
+                            if (field_container.read(read_iter, field_length) !=
+                                    nil::crypto3::marshalling::status_type::success) {
+                                success = false;
+                                break;
+                            }
+                            columns[i / rows_amount][i % rows_amount] = field_container.value();
+                        }
+                        return success;
+                    };
+
+                    std::size_t elements_amount = columns_amount * rows_amount;
+#ifdef PROOF_PRODUCER_MULTI_THREADED
+                    std::vector<bool> chunk_success = nil::crypto3::wait_for_all(
+                        nil::crypto3::parallel_run_in_chunks<bool>(elements_amount, read_range));
+                    for (bool success : chunk_success) {
+                        if (!success) {
+                            return false;
+                        }
+                    }
+                    return true;
+#else
+                    return read_range(0, elements_amount);
+#endif
+                }
+
+            public:
+                assignment_table_reader() = delete;
+
+                static std::optional<std::pair<AssignmentTableDescription, AssignmentTable>>
+                read_binary_assignment(const std::string& path) {
+                    auto file = mapped_file::open(path);
+                    if (!file) {
+                        return std::nullopt;
+                    }
+                    const std::uint8_t* data = file->data();
+                    const std::size_t file_size = file->size();
+
+                    constexpr std::size_t header_size_t_amount = 6;
+                    if (file_size < header_size_t_amount * size_length) {
+                        BOOST_LOG_TRIVIAL(error) << path << ": file is too short for an assignment table header";
+                        return std::nullopt;
+                    }
+
+                    std::array<std::size_t, column_groups> columns_amount;
+                    for (std::size_t group = 0; group < column_groups; group++) {
+                        columns_amount[group] = read_size_t(data + group * size_length);
+                    }
+                    const std::size_t usable_rows_amount = read_size_t(data + 4 * size_length);
+                    const std::size_t rows_amount = read_size_t(data + 5 * size_length);
+
+                    if (usable_rows_amount >= rows_amount) {
+                        BOOST_LOG_TRIVIAL(error) << path << ": rows amount " << rows_amount
+                                                 << " should be greater than usable rows amount " << usable_rows_amount;
+                        return std::nullopt;
+                    }
+
+                    // Check the size of every group against the header before touching any value.
+                    std::array<std::size_t, column_groups> group_offsets;
+                    std::size_t offset = header_size_t_amount * size_length;
+                    for (std::size_t group = 0; group < column_groups; group++) {
+                        auto elements_amount = checked_product(columns_amount[group], rows_amount);
+                        auto group_bytes = elements_amount ? checked_product(*elements_amount, field_length)
+                                                           : std::nullopt;
+                        if (!group_bytes || offset > file_size || file_size - offset < size_length ||
+                                read_size_t(data + offset) != *elements_amount ||
+                                file_size - offset - size_length < *group_bytes) {
+                            BOOST_LOG_TRIVIAL(error) << path << ": column group " << group
+                                                     << " does not match the assignment table header";
+                            return std::nullopt;
+                        }
+                        group_offsets[group] = offset + size_length;
+                        offset = group_offsets[group] + *group_bytes;
+                    }
+                    if (offset != file_size) {
+                        BOOST_LOG_TRIVIAL(error) << path << ": " << file_size - offset
+                                                 << " unexpected bytes after the assignment table";
+                        return std::nullopt;
+                    }
+
+                    std::array<std::vector<Column>, column_groups> columns;
+                    for (std::size_t group = 0; group < column_groups; group++) {
+                        if (!read_columns(data + group_offsets[group], columns[group], columns_amount[group],
+                                          rows_amount)) {
+                            BOOST_LOG_TRIVIAL(error) << path << ": failed to decode column group " << group;
+                            return std::nullopt;
+                        }
+                    }
+
+                    AssignmentTableDescription desc(
+                        columns_amount[0], columns_amount[1], columns_amount[2], columns_amount[3],
+                        usable_rows_amount, rows_amount);
+
+                    using private_table = typename AssignmentTable::private_table_type;
+                    using public_table = typename AssignmentTable::public_table_type;
+
+                    return std::make_pair(desc, AssignmentTable(
+                        std::make_shared<private_table>(std::move(columns[0])),
+                        std::make_shared<public_table>(
+                            std::move(columns[1]),
+                            std::move(columns[2]),
+                            std::move(columns[3])
+                        )
+                    ));
+                }
+        };
+
+    } // namespace proof_generator
+
+} // namespace nil
+
+#endif // PROOF_GENERATOR_ASSIGNMENT_TABLE_READER_HPP
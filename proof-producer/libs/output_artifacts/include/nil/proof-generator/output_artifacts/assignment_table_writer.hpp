@@ -20,7 +20,11 @@
 #include <boost/log/sources/record_ostream.hpp>
 #include <boost/log/trivial.hpp>
 #include <boost/assert.hpp>
+#include <algorithm>
+#include <cstdint>
 #include <ostream>  
+#include <type_traits>
+#include <vector>
 
 #include <nil/crypto3/marshalling/algebra/types/field_element.hpp>
 #include <nil/crypto3/zk/snark/arithmetization/plonk/assignment.hpp>
@@ -29,6 +33,10 @@
 
 #include <nil/proof-generator/output_artifacts/output_artifacts.hpp>
 
+#ifdef PROOF_PRODUCER_MULTI_THREADED
+#include <nil/actor/core/parallelization_utils.hpp>
+#endif
+
 
 namespace nil {
     namespace proof_generator {
@@ -64,45 +72,91 @@ namespace nil {
                     out.write(reinterpret_cast<char*>(char_array.data()), char_array.size());
                 }
 
-                /**
-                * @brief Write zero value serialized via crypto3 marshalling into output
-                * stream.
-                */
-                static void write_zero_field(std::ostream& out) {
-                    using empty_field = std::array<std::uint8_t, MarshallingField().length()>;
-                    
-                    empty_field field{};
-                    out.write(reinterpret_cast<char*>(field.data()), field.size());
-                }
-
-                /**
-                * @brief Write field element into output stream.
-                */
-                static void write_field(std::ostream& out, const BlueprintFieldValueType& input) {
-                    MarshallingField field_container(input);
-                    std::array<std::uint8_t, field_container.length()> char_array{};
-                    auto write_iter = char_array.begin();
-                    auto const status = field_container.write(write_iter, char_array.size());
-                    assert(status == nil::crypto3::marshalling::status_type::success);
-
-                    out.write(reinterpret_cast<char*>(char_array.data()), char_array.size());
-                }
+                static constexpr std::size_t field_length = MarshallingField().length();
 
+                // Upper bound of the buffer serialized at once, at least one column is always taken.
+                static constexpr std::size_t max_buffer_bytes = std::size_t(64) << 20;
 
                 /**
-                * @brief Write table column to output stream padding with zeroes up to fixed number of values.
+                * @brief Serialize field element into field_length bytes at dst, byte-identical to MarshallingField.
+                *
+                * The canonical value is converted straight from its limbs, without building a marshalling object.
                 */
-                // template<typename Endianness, typename ArithmetizationType, typename ColumnType>
-                static void write_vector_value(std::ostream& out, const std::size_t padded_rows_amount, const Column& table_col) {
-                    for (std::size_t i = 0; i < padded_rows_amount; i++) {
-                        if (i < table_col.size()) {
-                            write_field(out,table_col[i]);
+                static void write_field_bytes(std::uint8_t* dst, const BlueprintFieldValueType& input) {
+                    using integral_type = typename BlueprintField::integral_type;
+                    constexpr std::size_t limb_bytes = integral_type::limb_bits / 8;
+                    constexpr bool big_endian = std::is_same_v<typename TTypeBase::endian_type,
+                                                               nil::crypto3::marshalling::endian::big_endian>;
+
+                    const integral_type value(input.data);
+                    const auto* limbs = value.limbs();
+                    // k is the index of the byte counting from the least significant one.
+                    for (std::size_t k = 0; k < field_length; k++) {
+                        const std::size_t limb = k / limb_bytes;
+                        const std::uint8_t byte = limb < integral_type::internal_limb_count
+                            ? static_cast<std::uint8_t>(limbs[limb] >> (8 * (k % limb_bytes)))
+                            : 0;
+                        if constexpr (big_endian) {
+                            dst[field_length - 1 - k] = byte;
                         } else {
-                            write_zero_field(out);
+                            dst[k] = byte;
                         }
                     }
                 }
 
+                /**
+                * @brief Write table columns to output stream padding each with zeroes up to fixed number of values.
+                *
+                * Columns are serialized into a large buffer a few at a time, the buffer is filled in parallel and
+                * submitted to the stream with a single write.
+                */
+                template<typename ColumnGetter>
+                static void write_columns(std::ostream& out, const std::size_t padded_rows_amount,
+                                          const std::size_t columns_amount, ColumnGetter get_column) {
+                    const std::size_t column_bytes = padded_rows_amount * field_length;
+                    if (columns_amount == 0 || column_bytes == 0) {
+                        return;
+                    }
+                    const std::size_t columns_per_buffer =
+                        std::clamp<std::size_t>(max_buffer_bytes / column_bytes, 1, columns_amount);
+
+                    std::vector<std::uint8_t> buffer(columns_per_buffer * column_bytes);
+                    for (std::size_t first = 0; first < columns_amount; first += columns_per_buffer) {
+                        const std::size_t buffer_columns = std::min(columns_per_buffer, columns_amount - first);
+                        const std::size_t elements_amount = buffer_columns * padded_rows_amount;
+
+                        // Ranges of the flattened columns are independent, each one is serialized by a single thread.
+                        auto write_range = [&](std::size_t begin, std::size_t end) {
+                            while (begin < end) {
+                                const std::size_t column = begin / padded_rows_amount;
+                                const std::size_t row = begin % padded_rows_amount;
+                                const std::size_t column_end = std::min(end, (column + 1) * padded_rows_amount);
+                                const Column& table_col = get_column(first + column);
+
+                                const std::size_t values_end =
+                                    column * padded_rows_amount + std::min(table_col.size(), padded_rows_amount);
+                                std::size_t i = begin;
+                                for (; i < std::min(column_end, values_end); i++) {
+                                    write_field_bytes(buffer.data() + i * field_length,
+                                                      table_col[row + i - begin]);
+                                }
+                                if (i < column_end) {
+                                    std::fill(buffer.data() + i * field_length,
+                                              buffer.data() + column_end * field_length, 0);
+                                }
+                                begin = column_end;
+                            }
+                        };
+
+#ifdef PROOF_PRODUCER_MULTI_THREADED
+                        nil::crypto3::wait_for_all(
+                            nil::crypto3::parallel_run_in_chunks<void>(elements_amount, write_range));
+#else
+                        write_range(0, elements_amount);
+#endif
+                        out.write(reinterpret_cast<const char*>(buffer.data()), elements_amount * field_length);
+                    }
+                }
 
             public:
                 assignment_table_writer() = delete;
@@ -130,24 +184,20 @@ namespace nil {
                     write_size_t(out, padded_rows_amount);
 
                     write_size_t(out, witness_size * padded_rows_amount);
-                    for (std::uint32_t i = 0; i < witness_size; i++) {
-                        write_vector_value(out, padded_rows_amount,table.witness(i));
-                    }
+                    write_columns(out, padded_rows_amount, witness_size,
+                                  [&table](std::size_t i) -> const Column& { return table.witness(i); });
 
                     write_size_t(out, public_input_size * padded_rows_amount);
-                    for (std::uint32_t i = 0; i < public_input_size; i++) {
-                        write_vector_value(out, padded_rows_amount, table.public_input(i));
-                    }
+                    write_columns(out, padded_rows_amount, public_input_size,
+                                  [&table](std::size_t i) -> const Column& { return table.public_input(i); });
 
                     write_size_t(out, constant_size * padded_rows_amount);
-                    for (std::uint32_t i = 0; i < constant_size; i++) {
-                        write_vector_value(out, padded_rows_amount,table.constant(i));
-                    }
+                    write_columns(out, padded_rows_amount, constant_size,
+                                  [&table](std::size_t i) -> const Column& { return table.constant(i); });
 
                     write_size_t(out, selector_size * padded_rows_amount);
-                    for (std::uint32_t i = 0; i < selector_size; i++) {
-                        write_vector_value(out, padded_rows_amount, table.selector(i));
-                    }
+                    write_columns(out, padded_rows_amount, selector_size,
+                                  [&table](std::size_t i) -> const Column& { return table.selector(i); });
                 }
 
 
@@ -0,0 +1,96 @@
+//---------------------------------------------------------------------------//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//---------------------------------------------------------------------------//
+
+#ifndef PROOF_GENERATOR_MAPPED_FILE_HPP
+#define PROOF_GENERATOR_MAPPED_FILE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/log/trivial.hpp>
+
+namespace nil {
+    namespace proof_generator {
+
+        /**
+        * @brief Read-only mapping of a whole file, unmapped on destruction.
+        */
+        class mapped_file {
+            public:
+                static std::unique_ptr<mapped_file> open(const std::string& path) {
+                    int fd = ::open(path.c_str(), O_RDONLY);
+                    if (fd < 0) {
+                        BOOST_LOG_TRIVIAL(error) << "Unable to open file: " << path;
+                        return nullptr;
+                    }
+                    struct stat file_stat;
+                    if (::fstat(fd, &file_stat) != 0) {
+                        BOOST_LOG_TRIVIAL(error) << "Unable to stat file: " << path;
+                        ::close(fd);
+                        return nullptr;
+                    }
+                    std::size_t size = static_cast<std::size_t>(file_stat.st_size);
+                    void* data = nullptr;
+                    if (size != 0) {
+                        data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    }
+                    // The mapping stays valid after the descriptor is closed.
+                    ::close(fd);
+                    if (data == MAP_FAILED) {
+                        BOOST_LOG_TRIVIAL(error) << "Unable to map file: " << path;
+                        return nullptr;
+                    }
+                    if (data != nullptr) {
+                        // Tables are read front to back.
+                        ::madvise(data, size, MADV_SEQUENTIAL);
+                    }
+                    return std::unique_ptr<mapped_file>(
+                        new mapped_file(static_cast<const std::uint8_t*>(data), size));
+                }
+
+                mapped_file(const mapped_file&) = delete;
+                mapped_file& operator=(const mapped_file&) = delete;
+
+                ~mapped_file() {
+                    if (data_ != nullptr) {
+                        ::munmap(const_cast<std::uint8_t*>(data_), size_);
+                    }
+                }
+
+                const std::uint8_t* data() const {
+                    return data_;
+                }
+
+                std::size_t size() const {
+                    return size_;
+                }
+
+            private:
+                mapped_file(const std::uint8_t* data, std::size_t size) : data_(data), size_(size) {}
+
+                const std::uint8_t* data_;
+                std::size_t size_;
+        };
+
+    } // namespace proof_generator
+
+} // namespace nil
+
+#endif // PROOF_GENERATOR_MAPPED_FILE_HPP
@@ -0,0 +1,365 @@
+//---------------------------------------------------------------------------//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//---------------------------------------------------------------------------//
+
+#ifndef PROOF_GENERATOR_NATIVE_ASSIGNMENT_TABLE_HPP
+#define PROOF_GENERATOR_NATIVE_ASSIGNMENT_TABLE_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/log/trivial.hpp>
+
+#include <nil/crypto3/zk/snark/arithmetization/plonk/assignment.hpp>
+#include <nil/crypto3/zk/snark/arithmetization/plonk/table_description.hpp>
+
+#include <nil/proof-generator/output_artifacts/mapped_file.hpp>
+
+#ifdef PROOF_PRODUCER_MULTI_THREADED
+#include <nil/actor/core/parallelization_utils.hpp>
+#endif
+
+namespace nil {
+    namespace proof_generator {
+
+        /**
+         * @brief Assignment table stored as the limbs of its field elements, for reloading on the same machine.
+         *
+         * Unlike the marshalled .tbl format, values are neither reordered into big endian bytes nor, optionally,
+         * converted from the Montgomery form the field keeps them in, so saving and loading is a copy of memory.
+         *
+         * Layout, all integers are little endian:
+         *     header_type;
+         *     the field modulus, limbs_per_element limbs;
+         *     directory_entry for every column: witnesses, public inputs, constants, selectors;
+         *     column values, each column starts at an offset aligned to the alignment from the header.
+         * Rows are counted as in the marshalled format and every column is padded with zeroes to the rows amount.
+         */
+        template <typename BlueprintField>
+        class native_assignment_table {
+            public:
+                using Column = nil::crypto3::zk::snark::plonk_column<BlueprintField>;
+
+                using AssignmentTable = nil::crypto3::zk::snark::plonk_table<BlueprintField, Column>;
+                using AssignmentTableDescription = nil::crypto3::zk::snark::plonk_table_description<BlueprintField>;
+
+                using BlueprintFieldValueType = typename BlueprintField::value_type;
+                using IntegralType = typename BlueprintField::integral_type;
+                using LimbType = typename IntegralType::limb_type;
+
+                static constexpr std::uint32_t version = 1;
+                static constexpr std::uint64_t alignment = 4096;
+
+                static constexpr std::size_t limbs_per_element = IntegralType::internal_limb_count;
+                static constexpr std::size_t element_bytes = limbs_per_element * sizeof(LimbType);
+
+            private:
+                static_assert(std::endian::native == std::endian::little,
+                              "Native assignment tables are little endian limbs copied from memory");
+                static_assert(std::is_same_v<
+                        std::remove_cvref_t<decltype(std::declval<BlueprintFieldValueType&>().data.raw_base())>,
+                        IntegralType>,
+                    "Montgomery form of the field is expected to have the limbs of its integral type");
+
+                static constexpr std::array<char, 8> magic = {'N', 'I', 'L', 'T', 'A', 'B', 'L', 'E'};
+
+                // Values are in Montgomery form.
+                static constexpr std::uint32_t montgomery_flag = 1;
+
+                // Witnesses, public inputs, constants and selectors, in the order they are written.
+                static constexpr std::size_t column_groups = 4;
+
+                struct header_type {
+                    std::array<char, 8> magic;
+                    std::uint32_t version;
+                    std::uint32_t flags;
+                    std::uint32_t limb_bytes;
+                    std::uint32_t limbs_per_element;
+                    std::uint64_t alignment;
+                    std::array<std::uint64_t, column_groups> columns_amount;
+                    std::uint64_t usable_rows_amount;
+                    std::uint64_t rows_amount;
+                };
+                static_assert(std::is_trivially_copyable_v<header_type> && sizeof(header_type) == 80);
+
+                struct directory_entry {
+                    // From the beginning of the file.
+                    std::uint64_t offset;
+                    // Amount of values in the column.
+                    std::uint64_t size;
+                };
+                static_assert(std::is_trivially_copyable_v<directory_entry> && sizeof(directory_entry) == 16);
+
+                static std::uint64_t align_up(std::uint64_t offset) {
+                    return (offset + alignment - 1) / alignment * alignment;
+                }
+
+                static std::uint64_t directory_offset() {
+                    return sizeof(header_type) + element_bytes;
+                }
+
+                // The power of two above the usable rows and at least 8, as assignment_table_writer pads the tables.
+                static std::uint64_t padded_rows_amount(std::uint64_t usable_rows_amount) {
+                    std::uint64_t rows_amount = std::bit_ceil(usable_rows_amount);
+                    if (rows_amount == usable_rows_amount) {
+                        rows_amount *= 2;
+                    }
+                    return std::max<std::uint64_t>(rows_amount, 8);
+                }
+
+                static void store_element(std::uint8_t* dst, const BlueprintFieldValueType& value, bool montgomery) {
+                    if (montgomery) {
+                        std::memcpy(dst, value.data.raw_base().limbs(), element_bytes);
+                    } else {
+                        const IntegralType canonical(value.data);
+                        std::memcpy(dst, canonical.limbs(), element_bytes);
+                    }
+                }
+
+                // False if the stored value is not reduced.
+                static bool load_element(const std::uint8_t* src, BlueprintFieldValueType& value, bool montgomery) {
+                    IntegralType limbs;
+                    std::memcpy(limbs.limbs(), src, element_bytes);
+                    if (limbs >= BlueprintField::modulus) {
+                        return false;
+                    }
+                    if (montgomery) {
+                        value.data.raw_base() = limbs;
+                    } else {
+                        value = BlueprintFieldValueType(limbs);
+                    }
+                    return true;
+                }
+
+                // Apply func(begin, end) to the ranges of [0, size), in parallel when the prover is multi-threaded.
+                template<typename Func>
+                static bool for_each_range(std::size_t size, Func func) {
+#ifdef PROOF_PRODUCER_MULTI_THREADED
+                    std::vector<bool> chunk_success = nil::crypto3::wait_for_all(
+                        nil::crypto3::parallel_run_in_chunks<bool>(size, func));
+                    return std::all_of(chunk_success.begin(), chunk_success.end(), [](bool b) { return b; });
+#else
+                    return func(0, size);
+#endif
+                }
+
+                static std::vector<const Column*> table_columns(const AssignmentTable& table) {
+                    std::vector<const Column*> columns;
+                    for (std::uint32_t i = 0; i < table.witnesses_amount(); i++) {
+                        columns.push_back(&table.witness(i));
+                    }
+                    for (std::uint32_t i = 0; i < table.public_inputs_amount(); i++) {
+                        columns.push_back(&table.public_input(i));
+                    }
+                    for (std::uint32_t i = 0; i < table.constants_amount(); i++) {
+                        columns.push_back(&table.constant(i));
+                    }
+                    for (std::uint32_t i = 0; i < table.selectors_amount(); i++) {
+                        columns.push_back(&table.selector(i));
+                    }
+                    return columns;
+                }
+
+            public:
+                native_assignment_table() = delete;
+
+                /**
+                * @brief Whether the file starts like a native assignment table, the marshalled format never does.
+                */
+                static bool is_native_table(const std::string& path) {
+                    std::ifstream in(path, std::ios::binary | std::ios::in);
+                    std::array<char, magic.size()> file_magic{};
+                    in.read(file_magic.data(), file_magic.size());
+                    return in.good() && file_magic == magic;
+                }
+
+                static bool write_native_assignment(const std::string& path, const AssignmentTable& table,
+                                                    const AssignmentTableDescription& desc, bool montgomery) {
+                    std::ofstream out(path, std::ios::binary | std::ios::out | std::ios::trunc);
+                    if (!out.is_open()) {
+                        BOOST_LOG_TRIVIAL(error) << "Failed to open file " << path;
+                        return false;
+                    }
+
+                    const std::vector<const Column*> columns = table_columns(table);
+
+                    header_type header{};
+                    header.magic = magic;
+                    header.version = version;
+                    header.flags = montgomery ? montgomery_flag : 0;
+                    header.limb_bytes = sizeof(LimbType);
+                    header.limbs_per_element = limbs_per_element;
+                    header.alignment = alignment;
+                    header.columns_amount = {table.witnesses_amount(), table.public_inputs_amount(),
+                                             table.constants_amount(), table.selectors_amount()};
+                    // Tables of the preset stage have no rows in their description yet, all their rows are usable.
+                    header.usable_rows_amount = desc.usable_rows_amount != 0 ? desc.usable_rows_amount
+                                                                             : table.rows_amount();
+                    header.rows_amount = padded_rows_amount(header.usable_rows_amount);
+
+                    std::vector<directory_entry> directory(columns.size());
+                    std::uint64_t offset = align_up(directory_offset() + directory.size() * sizeof(directory_entry));
+                    for (std::size_t i = 0; i < columns.size(); i++) {
+                        directory[i] = {offset, header.rows_amount};
+                        offset = align_up(offset + header.rows_amount * element_bytes);
+                    }
+
+                    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                    out.write(reinterpret_cast<const char*>(BlueprintField::modulus.limbs()), element_bytes);
+                    out.write(reinterpret_cast<const char*>(directory.data()),
+                              directory.size() * sizeof(directory_entry));
+
+                    std::uint64_t position = directory_offset() + directory.size() * sizeof(directory_entry);
+                    std::vector<std::uint8_t> buffer;
+                    for (std::size_t i = 0; i < columns.size(); i++) {
+                        const Column& column = *columns[i];
+                        // Zeroes up to the aligned start of the column and after its values.
+                        buffer.assign(directory[i].offset - position + directory[i].size * element_bytes, 0);
+                        std::uint8_t* values = buffer.data() + (directory[i].offset - position);
+                        for_each_range(std::min<std::size_t>(column.size(), directory[i].size),
+                                       [&](std::size_t begin, std::size_t end) {
+                            for (std::size_t j = begin; j < end; j++) {
+                                store_element(values + j * element_bytes, column[j], montgomery);
+                            }
+                            return true;
+                        });
+                        out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+                        position += buffer.size();
+                    }
+
+                    out.flush();
+                    if (!out.good()) {
+                        BOOST_LOG_TRIVIAL(error) << "Failed to write native assignment table to " << path;
+                        return false;
+                    }
+                    return true;
+                }
+
+                static std::optional<std::pair<AssignmentTableDescription, AssignmentTable>>
+                read_native_assignment(const std::string& path) {
+                    auto file = mapped_file::open(path);
+                    if (!file) {
+                        return std::nullopt;
+                    }
+                    const std::uint8_t* data = file->data();
+                    const std::size_t file_size = file->size();
+
+                    header_type header;
+                    if (file_size < directory_offset()) {
+                        BOOST_LOG_TRIVIAL(error) << path << ": file is too short for a native assignment table header";
+                        return std::nullopt;
+                    }
+                    std::memcpy(&header, data, sizeof(header));
+                    if (header.magic != magic || header.version != version) {
+                        BOOST_LOG_TRIVIAL(error) << path << ": not a native assignment table of version " << version;
+                        return std::nullopt;
+                    }
+                    if (header.limb_bytes != sizeof(LimbType) || header.limbs_per_element != limbs_per_element ||
+                            std::memcmp(data + sizeof(header), BlueprintField::modulus.limbs(), element_bytes) != 0) {
+                        BOOST_LOG_TRIVIAL(error) << path << ": table was written for another field";
+                        return std::nullopt;
+                    }
+                    if (header.usable_rows_amount >= header.rows_amount) {
+                        BOOST_LOG_TRIVIAL(error) << path << ": rows amount " << header.rows_amount
+                                                 << " should be greater than usable rows amount "
+                                                 << header.usable_rows_amount;
+                        return std::nullopt;
+                    }
+                    const bool montgomery = (header.flags & montgomery_flag) != 0;
+
+                    // Column amounts are bounded by the file size before the directory is allocated.
+                    std::uint64_t columns_total = 0;
+                    for (std::uint64_t amount : header.columns_amount) {
+                        if (amount > file_size / sizeof(directory_entry) - columns_total) {
+                            BOOST_LOG_TRIVIAL(error) << path << ": directory does not fit into the file";
+                            return std::nullopt;
+                        }
+                        columns_total += amount;
+                    }
+                    if (file_size - directory_offset() < columns_total * sizeof(directory_entry)) {
+                        BOOST_LOG_TRIVIAL(error) << path << ": directory does not fit into the file";
+                        return std::nullopt;
+                    }
+                    std::vector<directory_entry> directory(columns_total);
+                    std::memcpy(directory.data(), data + directory_offset(), columns_total * sizeof(directory_entry));
+                    for (const directory_entry& entry : directory) {
+                        if (entry.offset > file_size || entry.size > (file_size - entry.offset) / element_bytes) {
+                            BOOST_LOG_TRIVIAL(error) << path << ": column at offset " << entry.offset
+                                                     << " does not fit into the file";
+                            return std::nullopt;
+                        }
+                        // The prover expects every column to hold rows_amount values.
+                        if (entry.size != header.rows_amount) {
+                            BOOST_LOG_TRIVIAL(error) << path << ": column at offset " << entry.offset << " has "
+                                                     << entry.size << " values instead of " << header.rows_amount;
+                            return std::nullopt;
+                        }
+                    }
+
+                    std::array<std::vector<Column>, column_groups> columns;
+                    std::size_t column_index = 0;
+                    for (std::size_t group = 0; group < column_groups; group++) {
+                        columns[group].resize(header.columns_amount[group]);
+                        for (Column& column : columns[group]) {
+                            const directory_entry& entry = directory[column_index++];
+                            column.resize(entry.size);
+                            const std::uint8_t* values = data + entry.offset;
+                            bool success = for_each_range(column.size(), [&](std::size_t begin, std::size_t end) {
+                                for (std::size_t j = begin; j < end; j++) {
+                                    if (!load_element(values + j * element_bytes, column[j], montgomery)) {
+                                        return false;
+                                    }
+                                }
+                                return true;
+                            });
+                            if (!success) {
+                                BOOST_LOG_TRIVIAL(error) << path << ": column " << column_index - 1
+                                                         << " has values out of the field";
+                                return std::nullopt;
+                            }
+                        }
+                    }
+
+                    AssignmentTableDescription desc(
+                        header.columns_amount[0], header.columns_amount[1], header.columns_amount[2],
+                        header.columns_amount[3], header.usable_rows_amount, header.rows_amount);
+
+                    using private_table = typename AssignmentTable::private_table_type;
+                    using public_table = typename AssignmentTable::public_table_type;
+
+                    return std::make_pair(desc, AssignmentTable(
+                        std::make_shared<private_table>(std::move(columns[0])),
+                        std::make_shared<public_table>(
+                            std::move(columns[1]),
+                            std::move(columns[2]),
+                            std::move(columns[3])
+                        )
+                    ));
+                }
+        };
+
+    } // namespace proof_generator
+
+} // namespace nil
+
+#endif // PROOF_GENERATOR_NATIVE_ASSIGNMENT_TABLE_HPP
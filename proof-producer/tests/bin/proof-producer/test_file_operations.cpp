@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <nil/proof-generator/file_operations.hpp>
+
+
+namespace {
+
+    std::vector<std::uint8_t> bytes(const std::string& text) {
+        return std::vector<std::uint8_t>(text.begin(), text.end());
+    }
+
+} // namespace
+
+
+class FileOperationsTests: public ::testing::Test {
+    protected:
+        void TearDown() override {
+            std::remove(file_path_.c_str());
+        }
+
+        const std::string file_path_ = "file_operations_test.dat";
+};
+
+
+TEST(DecodeHexTests, DecodesLinesStartingWith0x) {
+    using nil::proof_generator::detail::decode_hex;
+
+    EXPECT_EQ(decode_hex(bytes("0x0a1B")), (std::vector<std::uint8_t>{0x0a, 0x1b}));
+    EXPECT_EQ(decode_hex(bytes("0x01\n0xff\n")), (std::vector<std::uint8_t>{0x01, 0xff}));
+    EXPECT_EQ(decode_hex(bytes("")), std::vector<std::uint8_t>{});
+}
+
+TEST(DecodeHexTests, RejectsHexWithout0x) {
+    using nil::proof_generator::detail::decode_hex;
+
+    EXPECT_FALSE(decode_hex(bytes("0a1b")).has_value());
+    EXPECT_FALSE(decode_hex(bytes("0x01\n02\n")).has_value());
+}
+
+TEST(DecodeHexTests, RejectsOddLength) {
+    using nil::proof_generator::detail::decode_hex;
+
+    EXPECT_FALSE(decode_hex(bytes("0x123")).has_value());
+    EXPECT_FALSE(decode_hex(bytes("0x123\n0x45")).has_value());
+    EXPECT_FALSE(decode_hex(bytes("0")).has_value());
+}
+
+TEST(DecodeHexTests, RejectsInvalidCharacters) {
+    using nil::proof_generator::detail::decode_hex;
+
+    EXPECT_FALSE(decode_hex(bytes("0x0g")).has_value());
+    EXPECT_FALSE(decode_hex(bytes("0x01 02")).has_value());
+    EXPECT_FALSE(decode_hex(bytes("0X0102")).has_value());
+}
+
+TEST_F(FileOperationsTests, ReadsBinaryFile) {
+    const std::vector<std::uint8_t> data = {0x00, 0x01, 0x30, 0x78, 0xfe, 0xff};
+    ASSERT_TRUE(nil::proof_generator::write_vector_to_file(data, file_path_));
+
+    EXPECT_EQ(nil::proof_generator::read_binary_or_hex_file_to_vector(file_path_), data);
+}
+
+TEST_F(FileOperationsTests, ReadsHexFile) {
+    const std::vector<std::uint8_t> data = {0x00, 0x01, 0x30, 0x78, 0xfe, 0xff};
+    ASSERT_TRUE(nil::proof_generator::write_vector_to_hex_file(data, file_path_));
+
+    EXPECT_EQ(nil::proof_generator::read_binary_or_hex_file_to_vector(file_path_), data);
+    EXPECT_EQ(nil::proof_generator::read_hex_file_to_vector(file_path_), data);
+}
+
+TEST_F(FileOperationsTests, ReadsHexWithout0xAsBinary) {
+    const std::vector<std::uint8_t> data = bytes("0a1b2c");
+    ASSERT_TRUE(nil::proof_generator::write_vector_to_file(data, file_path_));
+
+    EXPECT_EQ(nil::proof_generator::read_binary_or_hex_file_to_vector(file_path_), data);
+    EXPECT_FALSE(nil::proof_generator::read_hex_file_to_vector(file_path_).has_value());
+}
+
+TEST_F(FileOperationsTests, ReadsInvalidHexAsBinary) {
+    // Binary data starting like a hex file is kept as soon as anything else than hex lines follows.
+    for (const auto& data : {bytes("0x123"), bytes("0x0g"), bytes("0x01\n02")}) {
+        ASSERT_TRUE(nil::proof_generator::write_vector_to_file(data, file_path_));
+
+        EXPECT_EQ(nil::proof_generator::read_binary_or_hex_file_to_vector(file_path_), data);
+        EXPECT_FALSE(nil::proof_generator::read_hex_file_to_vector(file_path_).has_value());
+    }
+
+    std::vector<std::uint8_t> data = bytes("0x");
+    data.insert(data.end(), {0x00, 0xff, 0x10, 0x0a});
+    ASSERT_TRUE(nil::proof_generator::write_vector_to_file(data, file_path_));
+    EXPECT_EQ(nil::proof_generator::read_binary_or_hex_file_to_vector(file_path_), data);
+}
+
+TEST_F(FileOperationsTests, ReadsBinaryThatIsValidHexAsHex) {
+    // The formats are told apart by the content only, binary data made of hex lines is decoded.
+    ASSERT_TRUE(nil::proof_generator::write_vector_to_file(bytes("0x3078"), file_path_));
+
+    EXPECT_EQ(nil::proof_generator::read_binary_or_hex_file_to_vector(file_path_),
+              (std::vector<std::uint8_t>{0x30, 0x78}));
+}
+
+TEST_F(FileOperationsTests, ReadsEmptyFile) {
+    ASSERT_TRUE(nil::proof_generator::write_vector_to_file({}, file_path_));
+
+    EXPECT_EQ(nil::proof_generator::read_binary_or_hex_file_to_vector(file_path_), std::vector<std::uint8_t>{});
+}
+
+TEST_F(FileOperationsTests, FailsOnMissingFile) {
+    EXPECT_FALSE(nil::proof_generator::read_binary_or_hex_file_to_vector("no_such_file.dat").has_value());
+}
@@ -0,0 +1,294 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <nil/proof-generator/prover_server.hpp>
+
+
+namespace {
+
+    // Sends a request to the server at socket_path and returns the response, or nothing if it can't connect.
+    std::optional<std::string> send_request(const std::string& socket_path, const std::string& request) {
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return std::nullopt;
+        }
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+        if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            ::close(fd);
+            return std::nullopt;
+        }
+        ::send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+        ::shutdown(fd, SHUT_WR);
+
+        std::string response;
+        char buffer[256];
+        ssize_t received;
+        while ((received = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+            response.append(buffer, received);
+        }
+        ::close(fd);
+        return response;
+    }
+
+    void write_file(const std::string& path, const std::string& content) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << content;
+    }
+
+} // namespace
+
+
+TEST(LruCacheTests, DropsLeastRecentlyUsed) {
+    nil::proof_generator::detail::lru_cache<std::string, int> cache(2);
+
+    cache.insert("a", 1);
+    cache.insert("b", 2);
+    ASSERT_NE(cache.find("a"), nullptr);
+    EXPECT_EQ(*cache.find("a"), 1);
+
+    cache.insert("c", 3);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_TRUE(cache.contains("a"));
+    EXPECT_FALSE(cache.contains("b"));
+    EXPECT_TRUE(cache.contains("c"));
+    EXPECT_EQ(cache.find("b"), nullptr);
+
+    cache.insert("d", 4);
+    EXPECT_FALSE(cache.contains("a"));
+    EXPECT_TRUE(cache.contains("c"));
+    EXPECT_TRUE(cache.contains("d"));
+}
+
+TEST(LruCacheTests, ReplacesExistingKey) {
+    nil::proof_generator::detail::lru_cache<std::string, int> cache(2);
+
+    cache.insert("a", 1);
+    cache.insert("b", 2);
+    cache.insert("a", 3);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(*cache.find("a"), 3);
+    EXPECT_EQ(*cache.find("b"), 2);
+
+    cache.erase("a");
+    EXPECT_FALSE(cache.contains("a"));
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(LruCacheTests, KeepsAtLeastOneValue) {
+    nil::proof_generator::detail::lru_cache<std::string, int> cache(0);
+
+    cache.insert("a", 1);
+    EXPECT_TRUE(cache.contains("a"));
+    cache.insert("b", 2);
+    EXPECT_FALSE(cache.contains("a"));
+    EXPECT_TRUE(cache.contains("b"));
+}
+
+TEST(FileIdentityTests, ChangesWithContent) {
+    using nil::proof_generator::detail::file_identity;
+    const std::string path = "file_identity_test.dat";
+
+    write_file(path, "circuit");
+    auto before = file_identity::of(path);
+    ASSERT_TRUE(before.has_value());
+    EXPECT_EQ(file_identity::of(path), before);
+
+    write_file(path, "another circuit");
+    auto after = file_identity::of(path);
+    ASSERT_TRUE(after.has_value());
+    EXPECT_NE(after, before);
+
+    std::remove(path.c_str());
+    EXPECT_FALSE(file_identity::of(path).has_value());
+    EXPECT_FALSE(file_identity::of(".").has_value());
+}
+
+
+class ProverServerTests: public ::testing::Test {
+    protected:
+        using CurveType = nil::crypto3::algebra::curves::pallas;
+        using HashType = nil::crypto3::hashes::keccak_1600<256>;
+
+        static constexpr std::size_t lambda = 9;
+        static constexpr std::size_t grind = 0;
+        static constexpr std::size_t expand_factor = 2;
+        static constexpr std::size_t max_quotient_chunks = 0;
+
+        void SetUp() override {
+            server_thread_ = std::thread([this] {
+                nil::proof_generator::ProverServer<CurveType, HashType> server(
+                    lambda, expand_factor, max_quotient_chunks, grind, "", 1);
+                served_ = server.run(socket_path_);
+            });
+            // The server is ready once it accepts connections.
+            for (int attempt = 0; attempt < 100; ++attempt) {
+                if (send_request(socket_path_, "\n\n")) {
+                    return;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            }
+            FAIL() << "Server did not start";
+        }
+
+        void TearDown() override {
+            if (server_thread_.joinable()) {
+                send_request(socket_path_, "shutdown\n\n");
+                server_thread_.join();
+            }
+        }
+
+        std::string request(const std::string& text) {
+            return send_request(socket_path_, text).value_or("no response");
+        }
+
+        using ProverType = nil::proof_generator::Prover<CurveType, HashType>;
+
+        // Proof of the "all" stage for the table loaded by 'load', checked by the verifier.
+        std::optional<std::vector<std::uint8_t>> reference_proof(const std::function<bool(ProverType&)>& load,
+                                                                 const std::string& circuit_name = "") {
+            const std::string proof_file = "reference_proof.bin";
+            const std::string json_file = "reference_proof.json";
+            ProverType prover(lambda, expand_factor, max_quotient_chunks, grind, circuit_name);
+            const bool generated = load(prover) &&
+                                   prover.preprocess_public_data() &&
+                                   prover.preprocess_private_data() &&
+                                   prover.generate_to_file(proof_file, json_file, false/*skip_verification*/, false);
+            auto proof = generated ? nil::proof_generator::read_file_to_vector(proof_file) : std::nullopt;
+            std::remove(proof_file.c_str());
+            std::remove(json_file.c_str());
+            return proof;
+        }
+
+        const std::string socket_path_ = "prover_server_test.sock";
+        std::thread server_thread_;
+        bool served_ = false;
+};
+
+
+TEST_F(ProverServerTests, SocketIsAccessibleToOwnerOnly) {
+    struct stat socket_stat;
+    ASSERT_EQ(::stat(socket_path_.c_str(), &socket_stat), 0);
+    EXPECT_TRUE(S_ISSOCK(socket_stat.st_mode));
+    EXPECT_EQ(socket_stat.st_mode & (S_IRWXG | S_IRWXO), 0);
+}
+
+TEST_F(ProverServerTests, RejectsRelativePaths) {
+    const std::string proof = boost::filesystem::absolute("proof.bin").string();
+
+    EXPECT_EQ(request("proof proof.bin\n\n"), "error invalid proof path proof.bin\n");
+    EXPECT_EQ(request("circuit circuit.crct\nproof " + proof + "\n\n"),
+              "error invalid circuit path circuit.crct\n");
+    EXPECT_EQ(request("trace traces/trace\nproof " + proof + "\n\n"), "error invalid trace path traces/trace\n");
+}
+
+TEST_F(ProverServerTests, RejectsIncompleteRequests) {
+    const std::string proof = boost::filesystem::absolute("proof.bin").string();
+
+    EXPECT_EQ(request("circuit /circuit.crct\n\n"), "error no proof file\n");
+    EXPECT_EQ(request("proof /no/such/directory/proof.bin\n\n"),
+              "error can't write proof to /no/such/directory/proof.bin\n");
+    EXPECT_EQ(request("proof " + proof + "\n\n"),
+              "error circuit, preprocessed-data, commitment-state-file and assignment-table or trace are required\n");
+
+    const std::string missing = boost::filesystem::absolute("missing_circuit.crct").string();
+    EXPECT_EQ(request("circuit " + missing + "\npreprocessed-data " + missing + "\ncommitment-state-file " + missing +
+                      "\nassignment-table " + missing + "\nproof " + proof + "\n\n"),
+              "error can't read " + missing + "\n");
+}
+
+TEST_F(ProverServerTests, KeepsServingAfterMalformedRequest) {
+    EXPECT_EQ(request("\n\n"), "error malformed request\n");
+    EXPECT_EQ(request(""), "error malformed request\n");
+    EXPECT_EQ(request("circuit /circuit.crct\n\n"), "error no proof file\n");
+}
+
+// The second table reuses the circuit data loaded for the first one.
+TEST_F(ProverServerTests, ProvesTablesOfOneCircuit) {
+    const std::string circuit = std::string(TEST_TABLE_DATA_DIR) + "circuit.crct";
+    const std::string table = std::string(TEST_TABLE_DATA_DIR) + "assignment.tbl";
+    const std::string native_table = boost::filesystem::absolute("server_assignment_native.tbl").string();
+    const std::string preprocessed_data = boost::filesystem::absolute("server_preprocessed_data.dat").string();
+    const std::string commitment_state = boost::filesystem::absolute("server_commitment_state.dat").string();
+    {
+        // The "preprocess" stage, and the same table in the native format.
+        ProverType prover(lambda, expand_factor, max_quotient_chunks, grind, "");
+        ASSERT_TRUE(prover.read_circuit(circuit));
+        ASSERT_TRUE(prover.read_assignment_table(table));
+        ASSERT_TRUE(prover.save_binary_assignment_table_to_file(
+            native_table, nil::proof_generator::detail::TableFormat::NATIVE));
+        ASSERT_TRUE(prover.preprocess_public_data());
+        ASSERT_TRUE(prover.save_public_preprocessed_data_to_file(preprocessed_data));
+        ASSERT_TRUE(prover.save_commitment_state_to_file(commitment_state));
+    }
+
+    auto expected = reference_proof([&](ProverType& prover) {
+        return prover.read_circuit(circuit) && prover.read_assignment_table(table);
+    });
+    ASSERT_TRUE(expected.has_value());
+
+    for (const std::string& assignment_table : {table, native_table}) {
+        const std::string proof_file = boost::filesystem::absolute("server_proof.bin").string();
+        const std::string json_file = boost::filesystem::absolute("server_proof.json").string();
+
+        ASSERT_EQ(request("circuit " + circuit + "\npreprocessed-data " + preprocessed_data +
+                          "\ncommitment-state-file " + commitment_state + "\nassignment-table " + assignment_table +
+                          "\nproof " + proof_file + "\n\n"), "ok\n");
+        auto proof = nil::proof_generator::read_file_to_vector(proof_file);
+        std::remove(proof_file.c_str());
+        std::remove(json_file.c_str());
+        ASSERT_TRUE(proof.has_value());
+        EXPECT_TRUE(*proof == *expected) << assignment_table;
+    }
+
+    std::remove(native_table.c_str());
+    std::remove(preprocessed_data.c_str());
+    std::remove(commitment_state.c_str());
+}
+
+// The second trace reuses the circuit prepared for the first one, and still gets a proof of its own public data.
+TEST_F(ProverServerTests, ProvesTracesOfOneCircuit) {
+    using namespace nil::proof_generator::circuits;
+
+    for (const std::string trace_name : {"increment_simple.pb", "increment_multi_tx.pb"}) {
+        const std::string trace = std::string(TEST_DATA_DIR) + trace_name;
+        const std::string proof_file = boost::filesystem::absolute("server_proof.bin").string();
+        const std::string json_file = boost::filesystem::absolute("server_proof.json").string();
+
+        ASSERT_EQ(request("trace " + trace + "\ncircuit-name " + RW + "\nproof " + proof_file + "\n\n"), "ok\n");
+        auto proof = nil::proof_generator::read_file_to_vector(proof_file);
+        std::remove(proof_file.c_str());
+        std::remove(json_file.c_str());
+        ASSERT_TRUE(proof.has_value());
+
+        auto expected = reference_proof([&trace](ProverType& prover) {
+            return prover.setup_prover() && prover.fill_assignment_table(trace);
+        }, RW);
+        ASSERT_TRUE(expected.has_value()) << trace_name;
+        EXPECT_TRUE(*proof == *expected) << trace_name;
+    }
+}
+
+TEST_F(ProverServerTests, StopsOnShutdown) {
+    EXPECT_EQ(request("shutdown\n\n"), "ok\n");
+    server_thread_.join();
+    EXPECT_TRUE(served_);
+    EXPECT_FALSE(boost::filesystem::exists(socket_path_));
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdio>
 #include <string>
 
 #include <nil/blueprint/utils/satisfiability_check.hpp>
@@ -59,6 +61,51 @@ TEST_P(ProverTests, FillAssignmentAndCheck) {
 }
 
 
+// The table of the preset stage written in the native format is read back with all its rows.
+TEST_F(ProverTests, PresetTableNativeRoundTrip) {
+    using Prover = nil::proof_generator::Prover<CurveType, HashType>;
+    using Column = typename Prover::Column;
+    const std::string table_file_path = "preset_native_assignment.tbl";
+
+    Prover prover(lambda, expand_factor, max_quotient_chunks, grind, nil::proof_generator::circuits::RW);
+    ASSERT_TRUE(prover.setup_prover());
+    const typename Prover::AssignmentTable preset_table = prover.get_assignment_table();
+
+    ASSERT_TRUE(prover.save_binary_assignment_table_to_file(
+        table_file_path, nil::proof_generator::detail::TableFormat::NATIVE));
+    ASSERT_TRUE(prover.read_assignment_table(table_file_path));
+    std::remove(table_file_path.c_str());
+
+    const auto& desc = prover.get_table_description();
+    EXPECT_EQ(desc.usable_rows_amount, preset_table.rows_amount());
+    EXPECT_GT(desc.rows_amount, desc.usable_rows_amount);
+
+    const auto& table = prover.get_assignment_table();
+    auto check_column = [&desc](const Column& read, const Column& written) {
+        ASSERT_EQ(read.size(), desc.rows_amount);
+        EXPECT_TRUE(std::equal(written.begin(), written.end(), read.begin()));
+        EXPECT_TRUE(std::all_of(read.begin() + written.size(), read.end(),
+                                [](const auto& value) { return value.is_zero(); }));
+    };
+    ASSERT_EQ(table.witnesses_amount(), preset_table.witnesses_amount());
+    for (std::size_t i = 0; i < table.witnesses_amount(); i++) {
+        check_column(table.witness(i), preset_table.witness(i));
+    }
+    ASSERT_EQ(table.public_inputs_amount(), preset_table.public_inputs_amount());
+    for (std::size_t i = 0; i < table.public_inputs_amount(); i++) {
+        check_column(table.public_input(i), preset_table.public_input(i));
+    }
+    ASSERT_EQ(table.constants_amount(), preset_table.constants_amount());
+    for (std::size_t i = 0; i < table.constants_amount(); i++) {
+        check_column(table.constant(i), preset_table.constant(i));
+    }
+    ASSERT_EQ(table.selectors_amount(), preset_table.selectors_amount());
+    for (std::size_t i = 0; i < table.selectors_amount(); i++) {
+        check_column(table.selector(i), preset_table.selector(i));
+    }
+}
+
+
 using namespace nil::proof_generator::circuits;
 
 // Single call of Counter contract increment function
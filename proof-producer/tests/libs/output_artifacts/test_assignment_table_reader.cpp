@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <nil/marshalling/endianness.hpp>
+#include <nil/marshalling/field_type.hpp>
+#include <nil/marshalling/status_type.hpp>
+
+#include <nil/crypto3/algebra/curves/pallas.hpp>
+#include <nil/crypto3/marshalling/zk/types/plonk/assignment_table.hpp>
+
+#include <nil/proof-generator/output_artifacts/assignment_table_reader.hpp>
+
+using Endianness = nil::crypto3::marshalling::option::big_endian;
+using TTypeBase = nil::crypto3::marshalling::field_type<Endianness>;
+
+using BlueprintField = typename nil::crypto3::algebra::curves::pallas::base_field_type;
+
+using Reader = nil::proof_generator::assignment_table_reader<Endianness, BlueprintField>;
+using AssignmentTable = Reader::AssignmentTable;
+
+using MarshalledTable = nil::crypto3::marshalling::types::plonk_assignment_table<TTypeBase, AssignmentTable>;
+
+
+class AssignmentTableReaderTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            std::ifstream in(table_file_path_, std::ios::binary | std::ios::in | std::ios::ate);
+            ASSERT_TRUE(in.is_open());
+            const auto fsize = in.tellg();
+            ASSERT_FALSE(fsize == 0);
+
+            in.seekg(0, std::ios::beg);
+            table_bytes_.resize(fsize);
+            in.read(reinterpret_cast<char*>(table_bytes_.data()), fsize);
+            ASSERT_FALSE(in.fail());
+        }
+
+        void TearDown() override {
+            std::remove(broken_file_path_.c_str());
+        }
+
+        void write_broken_table(const std::vector<std::uint8_t>& bytes) {
+            std::ofstream out(broken_file_path_, std::ios::binary | std::ios::out | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        }
+
+    protected:
+        const std::string table_file_path_ = std::string(TEST_DATA_DIR) + "assignment.tbl";
+        const std::string broken_file_path_ = "broken_assignment.tbl";
+        std::vector<std::uint8_t> table_bytes_;
+};
+
+TEST_F(AssignmentTableReaderTest, ReadMatchesMarshalling)
+{
+    MarshalledTable marshalled_table;
+    auto read_iter = table_bytes_.begin();
+    auto const status = marshalled_table.read(read_iter, table_bytes_.size());
+    ASSERT_TRUE(status == nil::crypto3::marshalling::status_type::success);
+    auto [expected_desc, expected_table] =
+        nil::crypto3::marshalling::types::make_assignment_table<Endianness, AssignmentTable>(marshalled_table);
+
+    auto table = Reader::read_binary_assignment(table_file_path_);
+    ASSERT_TRUE(table.has_value());
+    auto& [desc, assignment_table] = *table;
+
+    EXPECT_EQ(desc.witness_columns, expected_desc.witness_columns);
+    EXPECT_EQ(desc.public_input_columns, expected_desc.public_input_columns);
+    EXPECT_EQ(desc.constant_columns, expected_desc.constant_columns);
+    EXPECT_EQ(desc.selector_columns, expected_desc.selector_columns);
+    EXPECT_EQ(desc.usable_rows_amount, expected_desc.usable_rows_amount);
+    EXPECT_EQ(desc.rows_amount, expected_desc.rows_amount);
+    EXPECT_TRUE(assignment_table == expected_table);
+}
+
+TEST_F(AssignmentTableReaderTest, RejectTruncatedTable)
+{
+    write_broken_table(std::vector<std::uint8_t>(table_bytes_.begin(), table_bytes_.end() - 1));
+    EXPECT_FALSE(Reader::read_binary_assignment(broken_file_path_).has_value());
+
+    write_broken_table(std::vector<std::uint8_t>(table_bytes_.begin(), table_bytes_.begin() + 10));
+    EXPECT_FALSE(Reader::read_binary_assignment(broken_file_path_).has_value());
+}
+
+TEST_F(AssignmentTableReaderTest, RejectWrongHeader)
+{
+    // The lowest byte of the big endian witness columns amount.
+    std::vector<std::uint8_t> bytes = table_bytes_;
+    bytes[7] += 1;
+    write_broken_table(bytes);
+    EXPECT_FALSE(Reader::read_binary_assignment(broken_file_path_).has_value());
+
+    bytes = table_bytes_;
+    bytes.push_back(0);
+    write_broken_table(bytes);
+    EXPECT_FALSE(Reader::read_binary_assignment(broken_file_path_).has_value());
+}
+
+TEST_F(AssignmentTableReaderTest, RejectMissingFile)
+{
+    EXPECT_FALSE(Reader::read_binary_assignment("no_such_assignment.tbl").has_value());
+}
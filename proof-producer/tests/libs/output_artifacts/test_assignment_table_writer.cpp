@@ -134,6 +134,48 @@ TEST_F(AssignmentTableWriterTest, WriteBinaryAssignment)
     ASSERT_TRUE(std::memcmp(written->view().data(), table_bytes_.data(), table_bytes_.size()) == 0);
 }
 
+TEST_F(AssignmentTableWriterTest, WriteBinaryAssignmentPadsShortColumns)
+{
+    // 5 usable rows are padded to 8, columns shorter than that are completed with zeroes.
+    constexpr std::size_t usable_rows = 5;
+    constexpr std::size_t padded_rows = 8;
+
+    std::size_t next_value = 1;
+    auto make_column = [&next_value](std::size_t size) {
+        Writer::Column column(size);
+        for (auto& value : column) {
+            // Values close to the modulus use all the limbs.
+            value = -BlueprintField::value_type(next_value++);
+        }
+        return column;
+    };
+
+    std::vector<Writer::Column> witnesses = {make_column(padded_rows), make_column(usable_rows), make_column(0)};
+    std::vector<Writer::Column> public_inputs = {make_column(2)};
+    std::vector<Writer::Column> constants = {make_column(usable_rows), make_column(padded_rows)};
+    std::vector<Writer::Column> selectors = {make_column(1)};
+
+    using private_table = typename AssignmentTable::private_table_type;
+    using public_table = typename AssignmentTable::public_table_type;
+    AssignmentTable table(
+        std::make_shared<private_table>(std::move(witnesses)),
+        std::make_shared<public_table>(std::move(public_inputs), std::move(constants), std::move(selectors)));
+    AssignmentTableDescription desc(3, 1, 2, 1, usable_rows, padded_rows);
+
+    std::stringstream out;
+    Writer::write_binary_assignment(out, table, desc);
+    out.flush();
+
+    auto marshalled_table =
+        nil::crypto3::marshalling::types::fill_assignment_table<Endianness, AssignmentTable>(usable_rows, table);
+    std::vector<std::uint8_t> expected(marshalled_table.length());
+    auto write_iter = expected.begin();
+    ASSERT_TRUE(marshalled_table.write(write_iter, expected.size()) == nil::crypto3::marshalling::status_type::success);
+
+    ASSERT_EQ(out.tellp(), expected.size());
+    ASSERT_TRUE(std::memcmp(out.rdbuf()->view().data(), expected.data(), expected.size()) == 0);
+}
+
 TEST_F(AssignmentTableWriterTest, WriteFullTextAssignment) 
 {
     OutputArtifacts artifacts;
@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <nil/marshalling/endianness.hpp>
+
+#include <nil/crypto3/algebra/curves/pallas.hpp>
+#include <nil/crypto3/algebra/curves/vesta.hpp>
+
+#include <nil/proof-generator/output_artifacts/assignment_table_reader.hpp>
+#include <nil/proof-generator/output_artifacts/native_assignment_table.hpp>
+
+using Endianness = nil::crypto3::marshalling::option::big_endian;
+
+using BlueprintField = typename nil::crypto3::algebra::curves::pallas::base_field_type;
+using OtherField = typename nil::crypto3::algebra::curves::vesta::base_field_type;
+
+using Reader = nil::proof_generator::assignment_table_reader<Endianness, BlueprintField>;
+using NativeTable = nil::proof_generator::native_assignment_table<BlueprintField>;
+
+
+class NativeAssignmentTableTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            auto table = Reader::read_binary_assignment(std::string(TEST_DATA_DIR) + "assignment.tbl");
+            ASSERT_TRUE(table.has_value());
+            desc_ = table->first;
+            table_ = std::move(table->second);
+        }
+
+        void TearDown() override {
+            std::remove(native_file_path_.c_str());
+        }
+
+        std::vector<std::uint8_t> read_native_file() {
+            std::ifstream in(native_file_path_, std::ios::binary | std::ios::in | std::ios::ate);
+            std::vector<std::uint8_t> bytes(in.tellg());
+            in.seekg(0, std::ios::beg);
+            in.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+            return bytes;
+        }
+
+        void write_native_file(const std::vector<std::uint8_t>& bytes) {
+            std::ofstream out(native_file_path_, std::ios::binary | std::ios::out | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        }
+
+        void check_round_trip(bool montgomery) {
+            ASSERT_TRUE(NativeTable::write_native_assignment(native_file_path_, table_, desc_, montgomery));
+            EXPECT_TRUE(NativeTable::is_native_table(native_file_path_));
+
+            auto table = NativeTable::read_native_assignment(native_file_path_);
+            ASSERT_TRUE(table.has_value());
+            auto& [desc, assignment_table] = *table;
+
+            EXPECT_EQ(desc.witness_columns, desc_.witness_columns);
+            EXPECT_EQ(desc.public_input_columns, desc_.public_input_columns);
+            EXPECT_EQ(desc.constant_columns, desc_.constant_columns);
+            EXPECT_EQ(desc.selector_columns, desc_.selector_columns);
+            EXPECT_EQ(desc.usable_rows_amount, desc_.usable_rows_amount);
+            EXPECT_EQ(desc.rows_amount, desc_.rows_amount);
+            EXPECT_TRUE(assignment_table == table_);
+        }
+
+    protected:
+        const std::string native_file_path_ = "native_assignment.tbl";
+        NativeTable::AssignmentTable table_;
+        NativeTable::AssignmentTableDescription desc_{0, 0, 0, 0};
+};
+
+TEST_F(NativeAssignmentTableTest, RoundTripCanonical)
+{
+    check_round_trip(false);
+}
+
+TEST_F(NativeAssignmentTableTest, RoundTripMontgomery)
+{
+    check_round_trip(true);
+}
+
+// Tables of the preset stage have columns of different sizes and a description without rows.
+TEST_F(NativeAssignmentTableTest, RoundTripPresetTable)
+{
+    using Column = NativeTable::Column;
+    auto make_column = [](std::size_t size) {
+        Column column(size);
+        for (std::size_t i = 0; i < size; i++) {
+            column[i] = 3 * i + 1;
+        }
+        return column;
+    };
+    NativeTable::AssignmentTable preset_table(
+        std::make_shared<NativeTable::AssignmentTable::private_table_type>(
+            std::vector<Column>{make_column(5), make_column(3)}),
+        std::make_shared<NativeTable::AssignmentTable::public_table_type>(
+            std::vector<Column>{make_column(0)},
+            std::vector<Column>{make_column(8)},
+            std::vector<Column>{make_column(2)}));
+    NativeTable::AssignmentTableDescription preset_desc(2, 1, 1, 1);
+
+    ASSERT_TRUE(NativeTable::write_native_assignment(native_file_path_, preset_table, preset_desc, false));
+    auto table = NativeTable::read_native_assignment(native_file_path_);
+    ASSERT_TRUE(table.has_value());
+    auto& [desc, assignment_table] = *table;
+
+    // All the rows are usable, padded as in the marshalled format.
+    EXPECT_EQ(desc.usable_rows_amount, 8);
+    EXPECT_EQ(desc.rows_amount, 16);
+    ASSERT_EQ(assignment_table.witnesses_amount(), 2);
+    ASSERT_EQ(assignment_table.public_inputs_amount(), 1);
+    ASSERT_EQ(assignment_table.constants_amount(), 1);
+    ASSERT_EQ(assignment_table.selectors_amount(), 1);
+
+    auto check_column = [&desc](const Column& read, const Column& written) {
+        ASSERT_EQ(read.size(), desc.rows_amount);
+        for (std::size_t i = 0; i < read.size(); i++) {
+            EXPECT_EQ(read[i], i < written.size() ? written[i] : Column::value_type::zero());
+        }
+    };
+    check_column(assignment_table.witness(0), preset_table.witness(0));
+    check_column(assignment_table.witness(1), preset_table.witness(1));
+    check_column(assignment_table.public_input(0), preset_table.public_input(0));
+    check_column(assignment_table.constant(0), preset_table.constant(0));
+    check_column(assignment_table.selector(0), preset_table.selector(0));
+}
+
+TEST_F(NativeAssignmentTableTest, ColumnsAreAligned)
+{
+    ASSERT_TRUE(NativeTable::write_native_assignment(native_file_path_, table_, desc_, true));
+    std::vector<std::uint8_t> bytes = read_native_file();
+    ASSERT_GT(bytes.size(), NativeTable::alignment + NativeTable::element_bytes);
+
+    // The first column follows the directory at the next aligned offset, its first value is the first witness.
+    std::vector<std::uint8_t> expected(NativeTable::element_bytes);
+    std::memcpy(expected.data(), table_.witness(0)[0].data.raw_base().limbs(), expected.size());
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), bytes.begin() + NativeTable::alignment));
+}
+
+TEST_F(NativeAssignmentTableTest, MarshalledTableIsNotNative)
+{
+    EXPECT_FALSE(NativeTable::is_native_table(std::string(TEST_DATA_DIR) + "assignment.tbl"));
+    EXPECT_FALSE(NativeTable::read_native_assignment(std::string(TEST_DATA_DIR) + "assignment.tbl").has_value());
+}
+
+TEST_F(NativeAssignmentTableTest, RejectTruncatedTable)
+{
+    ASSERT_TRUE(NativeTable::write_native_assignment(native_file_path_, table_, desc_, false));
+    std::vector<std::uint8_t> bytes = read_native_file();
+
+    write_native_file(std::vector<std::uint8_t>(bytes.begin(), bytes.end() - 1));
+    EXPECT_FALSE(NativeTable::read_native_assignment(native_file_path_).has_value());
+
+    write_native_file(std::vector<std::uint8_t>(bytes.begin(), bytes.begin() + 100));
+    EXPECT_FALSE(NativeTable::read_native_assignment(native_file_path_).has_value());
+}
+
+TEST_F(NativeAssignmentTableTest, RejectInconsistentColumnSize)
+{
+    ASSERT_TRUE(NativeTable::write_native_assignment(native_file_path_, table_, desc_, false));
+    std::vector<std::uint8_t> bytes = read_native_file();
+
+    // The directory entry of the first column, which starts at the first aligned offset. The directory follows
+    // the 80 bytes of the header and the modulus.
+    const std::uint64_t entry[2] = {NativeTable::alignment, desc_.rows_amount};
+    auto position = std::search(bytes.begin() + 80 + NativeTable::element_bytes, bytes.end(), reinterpret_cast<const std::uint8_t*>(entry),
+                                reinterpret_cast<const std::uint8_t*>(entry) + sizeof(entry));
+    ASSERT_NE(position, bytes.end());
+
+    const std::uint64_t shorter = desc_.rows_amount - 1;
+    std::memcpy(&*position + sizeof(std::uint64_t), &shorter, sizeof(shorter));
+    write_native_file(bytes);
+    EXPECT_FALSE(NativeTable::read_native_assignment(native_file_path_).has_value());
+}
+
+TEST_F(NativeAssignmentTableTest, RejectUnreducedValue)
+{
+    ASSERT_TRUE(NativeTable::write_native_assignment(native_file_path_, table_, desc_, true));
+    std::vector<std::uint8_t> bytes = read_native_file();
+
+    // The most significant byte of the first value of the first column.
+    bytes[NativeTable::alignment + NativeTable::element_bytes - 1] = 0xFF;
+    write_native_file(bytes);
+    EXPECT_FALSE(NativeTable::read_native_assignment(native_file_path_).has_value());
+}
+
+TEST_F(NativeAssignmentTableTest, RejectOtherField)
+{
+    ASSERT_TRUE(NativeTable::write_native_assignment(native_file_path_, table_, desc_, true));
+    EXPECT_FALSE(nil::proof_generator::native_assignment_table<OtherField>::read_native_assignment(
+        native_file_path_).has_value());
+}